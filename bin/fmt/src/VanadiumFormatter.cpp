@@ -1,5 +1,175 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-int main() {
-  std::cout << "Test" << std::endl;
+#include <argparse/argparse.hpp>
+#include <fmt/color.h>
+#include <fmt/core.h>
+#include <oneapi/tbb/parallel_for_each.h>
+#include <oneapi/tbb/task_arena.h>
+
+#include <vanadium/ast/Parser.h>
+#include <vanadium/bin/Bootstrap.h>
+#include <vanadium/format/Formatter.h>
+#include <vanadium/lib/Arena.h>
+#include <vanadium/tooling/Filesystem.h>
+#include <vanadium/tooling/Solution.h>
+#include <vanadium/tooling/impl/SystemFS.h>
+
+namespace {
+enum class FileStatus : std::uint8_t {
+  kFormatted,
+  kChanged,
+  kSyntaxErrors,
+  kReadFailed,
+  kWriteFailed,
+};
+
+struct FileResult {
+  std::string path;  // relative to the solution directory
+  FileStatus status{FileStatus::kFormatted};
+  std::string error;
+};
+
+// Only the syntax matters, so the file is parsed on its own: nothing is bound or kept once it is formatted
+void FormatFile(FileResult& result, const vanadium::tooling::fs::Path& dir, const vanadium::format::Options& options,
+                bool check) {
+  std::string src;
+  if (const auto read = dir.ReadFile(result.path,
+                                     [&](std::size_t size) {
+                                       src.resize(size);
+                                       return src.data();
+                                     });
+      !read) {
+    result.status = FileStatus::kReadFailed;
+    result.error = read.error().String();
+    return;
+  }
+
+  vanadium::lib::Arena arena;
+  const auto ast = vanadium::ast::Parse(arena, src);
+  if (!ast.errors.empty()) {
+    result.status = FileStatus::kSyntaxErrors;
+    return;
+  }
+  const auto formatted = vanadium::format::FormatSource(ast, options);
+  if (!formatted) {
+    return;
+  }
+  result.status = FileStatus::kChanged;
+  if (check) {
+    return;
+  }
+  if (const auto& err = dir.WriteFile(result.path, *formatted); err) {
+    result.status = FileStatus::kWriteFailed;
+    result.error = err->String();
+  }
+}
+
+int main(int argc, char* argv[]) {
+  std::uint32_t jobs{std::clamp(std::thread::hardware_concurrency(), 1U, 4U)};
+  bool check{false};
+  std::uint32_t indent_width{2};
+  bool use_tabs{false};
+  std::string solution_path{"."};
+
+  argparse::ArgumentParser ap("vanadium-fmt");
+  ap.add_description("TTCN-3 source code formatter");
+  //
+  ap.add_argument("--check").store_into(check).help("do not write the files, fail if any of them is not formatted");
+  ap.add_argument("-j", "--parallel", "").store_into(jobs).help("maximum number of worker threads");
+  ap.add_argument("--indent-width").store_into(indent_width).help("number of spaces per indentation level");
+  ap.add_argument("--use-tabs").store_into(use_tabs).help("indent with tabs instead of spaces");
+  //
+  ap.add_argument("path").default_value(solution_path).store_into(solution_path).help("solution directory path");
+
+  //
+  PARSE_CLI_ARGS_OR_EXIT(ap, argc, argv, 1);
+  //
+
+  tbb::task_arena task_arena(jobs);
+
+  const auto dir = vanadium::tooling::fs::Root<vanadium::tooling::fs::SystemFS>(solution_path);
+
+  const auto t_load_begin = std::chrono::steady_clock::now();
+  auto files = vanadium::tooling::Solution::ListSourceFiles(dir);
+  if (!files) {
+    fmt::println("{} {}", fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "error:"),
+                 files.error().String());
+    return 2;
+  }
+  const auto t_load_end = std::chrono::steady_clock::now();
+
+  std::vector<FileResult> results;
+  for (auto& path : *files) {
+    if (!path.ends_with(".asn")) {
+      results.push_back(FileResult{.path = std::move(path)});
+    }
+  }
+
+  const vanadium::format::Options options{.indent_width = indent_width, .use_tabs = use_tabs};
+  task_arena.execute([&] {
+    tbb::parallel_for_each(results, [&](FileResult& result) {
+      FormatFile(result, dir, options, check);
+    });
+  });
+  const auto t_format_end = std::chrono::steady_clock::now();
+
+  std::size_t changed{0};
+  std::size_t failed{0};
+  for (const auto& result : results) {
+    const auto path = dir.Join(result.path);
+    switch (result.status) {
+      case FileStatus::kFormatted:
+        break;
+      case FileStatus::kChanged:
+        ++changed;
+        fmt::println("{} {}",
+                     fmt::format(fmt::fg(check ? fmt::color::tomato : fmt::color::cornflower_blue),
+                                 check ? "not formatted:" : "formatted:"),
+                     path);
+        break;
+      case FileStatus::kSyntaxErrors:
+        ++failed;
+        fmt::println("{} {} has syntax errors, it is left as it is",
+                     fmt::format(fmt::fg(fmt::color::yellow) | fmt::emphasis::bold, "warning:"), path);
+        break;
+      case FileStatus::kReadFailed:
+        ++failed;
+        fmt::println("{} {}",
+                     fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "failed to read file {}:", path),
+                     result.error);
+        break;
+      case FileStatus::kWriteFailed:
+        ++failed;
+        fmt::println("{} {}",
+                     fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "failed to write to file {}:", path),
+                     result.error);
+        break;
+    }
+  }
+
+  if (changed == 0) {
+    fmt::print(fmt::emphasis::bold | fmt::fg(fmt::color::green), "\n ✔  All {} files are formatted\n",
+               results.size() - failed);
+  } else {
+    fmt::print(fmt::emphasis::bold | fmt::fg(check ? fmt::color::tomato : fmt::color::cornflower_blue),
+               "\n ● {} of {} files {}\n", changed, results.size(), check ? "need formatting" : "formatted");
+  }
+  fmt::print(fmt::fg(fmt::color::cyan), "\n * Project listed in {} ms, formatted in {} ms with {} jobs\n\n",
+             std::chrono::duration_cast<std::chrono::milliseconds>(t_load_end - t_load_begin).count(),
+             std::chrono::duration_cast<std::chrono::milliseconds>(t_format_end - t_load_end).count(), jobs);
+
+  if (failed > 0) {
+    return 2;
+  }
+  return (check && changed > 0) ? 1 : 0;
 }
+}  // namespace
+
+DEFINE_VANADIUM_ENTRYPOINT(main);
@@ -1,57 +1,53 @@
 #include <chrono>
 #include <csignal>
-#include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <print>
+#include <string>
 #include <string_view>
 #include <thread>
 
 #include <argparse/argparse.hpp>
 
+#include <vanadium/asn1/ast/Asn1ModuleBasket.h>
+#include <vanadium/asn1/ast/Asn1TransformationCache.h>
 #include <vanadium/bin/Bootstrap.h>
+#include <vanadium/lib/lserver/SessionTrace.h>
 #include <vanadium/lib/lserver/Transport.h>
 #include <vanadium/ls/LanguageServer.h>
 #include <vanadium/ls/LanguageServerTestFlags.h>
 #include <vanadium/version.h>
 
-class OutputCapturingTransport : public vanadium::lserver::Transport {
- public:
-  OutputCapturingTransport(const char* filename, vanadium::lserver::Transport& base) : base_(base) {
-    flog_ = std::ofstream(filename, std::ios::trunc);
-  }
-
-  void Read(std::span<char> chunk) final {
-    base_.Read(chunk);
-  }
-  void ReadLine(std::span<char> chunk) final {
-    base_.ReadLine(chunk);
-  }
-  void Flush() final {
-    base_.Flush();
+namespace {
+std::string DefaultAsn1CacheDirectory() {
+  if (const char* xdg_cache_home = std::getenv("XDG_CACHE_HOME"); xdg_cache_home && *xdg_cache_home) {
+    return (std::filesystem::path(xdg_cache_home) / "vanadium" / "asn1").string();
   }
-
-  void Write(std::string_view buf) final {
-    flog_ << buf;
-    flog_ << "\n---\n";
-    flog_.flush();
-    //
-    base_.Write(buf);
+  if (const char* home = std::getenv("HOME"); home && *home) {
+    return (std::filesystem::path(home) / ".cache" / "vanadium" / "asn1").string();
   }
+  return {};
+}
 
- private:
-  std::ofstream flog_;
-  vanadium::lserver::Transport& base_;
-};
-
-namespace {
 int main(int argc, char* argv[]) {
   argparse::ArgumentParser ap("vanadiumd");
   ap.add_description("TTCN-3 language server");
   //
   std::uint32_t jobs{std::clamp(std::thread::hardware_concurrency(), 1U, 4U)};
   ap.add_argument("-j", "--jobs", "").store_into(jobs).help("maximum number of worker threads");
-  std::uint32_t concurrency{1};  // >1 is not supported at the moment
+  std::uint32_t concurrency{std::clamp(std::thread::hardware_concurrency(), 1U, 4U)};
   ap.add_argument("--concurrency").store_into(concurrency).help("number of concurrently served LS requests");
+  std::string asn1_cache_dir{DefaultAsn1CacheDirectory()};
+  ap.add_argument("--asn1-cache-dir")
+      .store_into(asn1_cache_dir)
+      .help("directory to keep the transformed ASN.1 modules in across the runs, empty to disable");
+  std::uint32_t asn1_cache_size{256};
+  ap.add_argument("--asn1-cache-size")
+      .store_into(asn1_cache_size)
+      .help("size in MiB the ASN.1 cache directory is trimmed to upon startup");
   //
   {
     auto& transport_group = ap.add_mutually_exclusive_group();
@@ -59,7 +55,10 @@ int main(int argc, char* argv[]) {
   }
   //
   ap.add_argument("--wait-dbg").flag();
-  ap.add_argument("--capture-output").flag();
+  std::string record_path;
+  ap.add_argument("--record")
+      .store_into(record_path)
+      .help("record the session into the file to be replayed by vanadium_lsp_replay");
   ap.add_argument("--full-analysis").flag();
 
   //
@@ -79,14 +78,20 @@ int main(int argc, char* argv[]) {
     vanadium::ls::testflags::do_not_skip_full_analysis = true;
   }
 
+  std::optional<vanadium::asn1::ast::Asn1TransformationCache> asn1_cache;
+  if (!asn1_cache_dir.empty()) {
+    asn1_cache.emplace(asn1_cache_dir).Trim(std::uintmax_t{asn1_cache_size} << 20);
+    vanadium::asn1::ast::Asn1ModuleBasket::SetTransformationCache(&*asn1_cache);
+  }
+
   vanadium::lserver::StdioTransport::Setup();
   vanadium::lserver::StdioTransport stdio_transport;
 
   vanadium::lserver::Transport* transport{&stdio_transport};
 
-  std::optional<OutputCapturingTransport> capturing_transport;
-  if (ap.get<bool>("--capture-output")) {
-    transport = &capturing_transport.emplace("vanadiumd.stdout.log", *transport);
+  std::optional<vanadium::lserver::RecordingTransport> recording_transport;
+  if (!record_path.empty()) {
+    transport = &recording_transport.emplace(record_path.c_str(), *transport);
   }
 
   vanadium::ls::Serve(*transport, concurrency, jobs);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <oneapi/tbb/task_arena.h>
+
+#include "vanadium/bin/tidy/Report.h"
+
+namespace vanadium::bin::tidy {
+
+constexpr std::string_view kLintMethod = "tidy/lint";
+
+struct LintParams {
+  std::string root;  // absolute path of the solution directory
+};
+
+struct LintResult {
+  std::vector<FileReport> files;
+  std::optional<std::string> error;  // the solution has failed to load
+};
+
+[[nodiscard]] std::string DefaultSocketPath();
+
+// Serves the clients one after another, keeping the solutions they have asked for loaded by their root paths.
+// Each of them is brought in sync with its files before it is linted, see LiveSolution
+int ServeDaemon(const std::string& socket_path, tbb::task_arena& task_arena);
+
+// Returns nullopt if the daemon is not available, then the solution is to be linted in-process
+[[nodiscard]] std::optional<LintResult> LintWithDaemon(const std::string& socket_path, const std::string& root);
+
+}  // namespace vanadium::bin::tidy
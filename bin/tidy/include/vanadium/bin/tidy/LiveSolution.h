@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <oneapi/tbb/task_arena.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/lib/Error.h>
+#include <vanadium/lint/Linter.h>
+#include <vanadium/tooling/Filesystem.h>
+#include <vanadium/tooling/Solution.h>
+
+#include "vanadium/bin/tidy/Report.h"
+
+namespace vanadium::bin::tidy {
+
+// The solution kept loaded and in sync with the files under its directory, along with the lint results
+// of the files of its managed projects, so that only what has changed is analyzed and linted again
+class LiveSolution {
+ public:
+  [[nodiscard]] static std::expected<std::unique_ptr<LiveSolution>, Error> Load(const std::string& path,
+                                                                                tbb::task_arena& task_arena,
+                                                                                const lint::Linter& linter);
+
+  LiveSolution(const LiveSolution&) = delete;
+  LiveSolution& operator=(const LiveSolution&) = delete;
+
+  struct SyncResult {
+    std::size_t changed_files{0};
+    std::vector<const FileReport*> changed_reports;
+    std::chrono::milliseconds elapsed{0};  // since the changes have been received
+  };
+
+  // Waits for the files to change for up to the timeout and applies the changes: the changed files are updated,
+  // whatever has become dirty is analyzed, then the changed files are linted along with their dependents
+  SyncResult Sync(std::optional<std::chrono::milliseconds> timeout);
+
+  [[nodiscard]] const std::map<std::string, FileReport>& Reports() const noexcept {
+    return reports_;
+  }
+  [[nodiscard]] std::size_t TotalProblems() const;
+
+ private:
+  LiveSolution(tooling::Solution&& solution, std::unique_ptr<tooling::fs::Watcher>&& watcher,
+               tbb::task_arena& task_arena, const lint::Linter& linter);
+
+  // Returns whether the report has changed
+  bool Relint(const core::SourceFile&);
+
+  tooling::Solution solution_;
+  std::unique_ptr<tooling::fs::Watcher> watcher_;
+  tbb::task_arena* task_arena_;
+  const lint::Linter* linter_;
+
+  std::unordered_map<const core::Program*, const tooling::SolutionProject*> projects_;
+  std::map<std::string, FileReport> reports_;  // by the path of the file
+};
+
+}  // namespace vanadium::bin::tidy
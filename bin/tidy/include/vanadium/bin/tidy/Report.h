@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/lint/Context.h>
+#include <vanadium/lint/Linter.h>
+#include <vanadium/tooling/Solution.h>
+
+namespace vanadium::bin::tidy {
+
+struct ReportedProblem {
+  std::uint32_t line;  // 1-based, as printed
+  std::uint32_t column;
+  std::string description;
+  std::string reporter;
+
+  bool operator==(const ReportedProblem&) const = default;
+};
+
+// The lint results of a file as they are printed, which is also how the daemon hands them over to the clients
+struct FileReport {
+  std::string path;
+  bool has_syntax_errors{false};
+  std::vector<ReportedProblem> problems;
+
+  [[nodiscard]] std::size_t Count() const noexcept {
+    return problems.size() + (has_syntax_errors ? 1 : 0);
+  }
+
+  bool operator==(const FileReport&) const = default;
+};
+
+[[nodiscard]] lint::Linter CreateLinter();
+
+[[nodiscard]] FileReport ReportProblems(const tooling::SolutionProject&, const core::SourceFile&,
+                                        const lint::ProblemSet&);
+[[nodiscard]] FileReport LintFile(const lint::Linter&, const tooling::SolutionProject&, const core::SourceFile&);
+
+void PrintFileReport(const FileReport&);
+void PrintSummary(std::size_t total_problems);
+
+}  // namespace vanadium::bin::tidy
@@ -0,0 +1,136 @@
+#include "vanadium/bin/tidy/Daemon.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <unistd.h>
+
+#include <fmt/color.h>
+#include <fmt/core.h>
+#include <glaze/json.hpp>
+#include <oneapi/tbb/task_arena.h>
+
+#include <vanadium/lib/jsonrpc/Common.h>
+#include <vanadium/lib/jsonrpc/Server.h>
+#include <vanadium/lib/lserver/Channel.h>
+#include <vanadium/lib/lserver/MessageToken.h>
+#include <vanadium/lib/lserver/SocketTransport.h>
+#include <vanadium/lint/Linter.h>
+
+#include "vanadium/bin/tidy/LiveSolution.h"
+#include "vanadium/bin/tidy/Report.h"
+
+namespace vanadium::bin::tidy {
+
+namespace {
+constexpr std::size_t kTokens = 2;  // a request and its response at a time
+
+struct DaemonContext {
+  tbb::task_arena* task_arena;
+  lint::Linter linter;
+  std::unordered_map<std::string, std::unique_ptr<LiveSolution>> solutions;  // by the root path
+};
+
+LintResult Lint(DaemonContext& ctx, const LintParams& params) {
+  auto it = ctx.solutions.find(params.root);
+  if (it == ctx.solutions.end()) {
+    const auto t_load_begin = std::chrono::steady_clock::now();
+    auto solution = LiveSolution::Load(params.root, *ctx.task_arena, ctx.linter);
+    if (!solution) {
+      return LintResult{.error = solution.error().String()};
+    }
+    it = ctx.solutions.emplace(params.root, std::move(*solution)).first;
+    fmt::print(fmt::fg(fmt::color::cyan), " * {} loaded in {} ms\n", params.root,
+               std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t_load_begin)
+                   .count());
+  } else if (const auto sync = it->second->Sync(std::chrono::milliseconds{0}); sync.changed_files > 0) {
+    fmt::print(fmt::fg(fmt::color::cyan), " * {}: {} files changed\n", params.root, sync.changed_files);
+  }
+
+  LintResult result;
+  result.files.reserve(it->second->Reports().size());
+  for (const auto& report : it->second->Reports() | std::views::values) {
+    result.files.push_back(report);
+  }
+  return result;
+}
+}  // namespace
+
+std::string DefaultSocketPath() {
+  if (const char* runtime_dir = std::getenv("XDG_RUNTIME_DIR"); runtime_dir && *runtime_dir) {
+    return (std::filesystem::path(runtime_dir) / "vanadium-tidy.sock").string();
+  }
+  return (std::filesystem::temp_directory_path() / fmt::format("vanadium-tidy-{}.sock", getuid())).string();
+}
+
+int ServeDaemon(const std::string& socket_path, tbb::task_arena& task_arena) {
+  auto listener = lserver::SocketListener::Listen(socket_path);
+  if (!listener) {
+    fmt::println("{} failed to listen on {}: {}", fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "error:"),
+                 socket_path, listener.error().message());
+    return 2;
+  }
+
+  DaemonContext ctx{.task_arena = &task_arena, .linter = CreateLinter(), .solutions = {}};
+  lib::jsonrpc::Server<DaemonContext> rpc_server;
+  rpc_server.Bind<&Lint>(kLintMethod);
+
+  fmt::print(fmt::fg(fmt::color::cyan), " * Listening on {}\n", socket_path);
+
+  lserver::TokenPool pool(kTokens);
+  while (auto transport = (*listener)->Accept()) {
+    lserver::Channel channel(*transport, kTokens);
+    while (channel.Read()) {
+      auto request = channel.Poll();
+      auto response = pool.Acquire();
+      response->body_offset = lserver::MessageToken::kHeaderReserve;
+      if (rpc_server.Call(ctx, response->buf, request->buf, response->body_offset)) {
+        channel.Enqueue(std::move(response));
+        channel.Write();
+      }
+    }
+  }
+  return 0;
+}
+
+std::optional<LintResult> LintWithDaemon(const std::string& socket_path, const std::string& root) {
+  auto transport = lserver::SocketTransport::Connect(socket_path);
+  if (!transport) {
+    return std::nullopt;
+  }
+
+  lserver::TokenPool pool(kTokens);
+  lserver::Channel channel(**transport, kTokens);
+
+  auto request = pool.Acquire();
+  request->body_offset = lserver::MessageToken::kHeaderReserve;
+  const lib::jsonrpc::Request<LintParams> req{
+      .id = std::int64_t{1},
+      .method = kLintMethod,
+      .params = {.root = root},
+  };
+  if (lib::jsonrpc::WriteJson(req, request->buf, request->body_offset)) {
+    return std::nullopt;
+  }
+  channel.Enqueue(std::move(request));
+  if (!channel.Write() || !channel.Read()) {
+    return std::nullopt;
+  }
+
+  auto response = channel.Poll();
+  lib::jsonrpc::Response<LintResult> res;
+  if (glz::read_json(res, response->buf) || !res.result) {
+    return std::nullopt;
+  }
+  return std::move(*res.result);
+}
+
+}  // namespace vanadium::bin::tidy
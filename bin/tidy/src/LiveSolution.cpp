@@ -0,0 +1,188 @@
+#include "vanadium/bin/tidy/LiveSolution.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fmt/color.h>
+#include <fmt/core.h>
+#include <oneapi/tbb/task_arena.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/lib/Error.h>
+#include <vanadium/lint/Linter.h>
+#include <vanadium/tooling/Filesystem.h>
+#include <vanadium/tooling/Solution.h>
+#include <vanadium/tooling/impl/SystemFS.h>
+
+#include "vanadium/bin/tidy/Report.h"
+
+namespace vanadium::bin::tidy {
+
+std::expected<std::unique_ptr<LiveSolution>, Error> LiveSolution::Load(const std::string& path,
+                                                                       tbb::task_arena& task_arena,
+                                                                       const lint::Linter& linter) {
+  const auto root = tooling::fs::Root<tooling::fs::SystemFS>(path);
+
+  // the watch starts first, so that nothing changed while loading is missed
+  auto watcher = root.Watch();
+  auto solution = task_arena.execute([&] {
+    return tooling::Solution::Load(root);
+  });
+  if (!solution) {
+    return std::unexpected{std::move(solution.error())};
+  }
+  return std::unique_ptr<LiveSolution>(
+      new LiveSolution(std::move(*solution), std::move(watcher), task_arena, linter));
+}
+
+LiveSolution::LiveSolution(tooling::Solution&& solution, std::unique_ptr<tooling::fs::Watcher>&& watcher,
+                           tbb::task_arena& task_arena, const lint::Linter& linter)
+    : solution_(std::move(solution)), watcher_(std::move(watcher)), task_arena_(&task_arena), linter_(&linter) {
+  for (const auto& project : solution_.Projects()) {
+    projects_.emplace(&project.program, &project);
+    for (const auto& sf : project.program.Files() | std::views::values) {
+      Relint(sf);
+    }
+  }
+}
+
+std::size_t LiveSolution::TotalProblems() const {
+  std::size_t total{0};
+  for (const auto& report : reports_ | std::views::values) {
+    total += report.Count();
+  }
+  return total;
+}
+
+bool LiveSolution::Relint(const core::SourceFile& sf) {
+  const auto& project = *projects_.at(sf.program);
+  if (!project.managed || sf.path.ends_with(".asn")) {
+    return false;
+  }
+  auto report = LintFile(*linter_, project, sf);
+  const auto [it, inserted] = reports_.try_emplace(sf.path);
+  if (!inserted && it->second == report) {
+    return false;
+  }
+  it->second = std::move(report);
+  return true;
+}
+
+LiveSolution::SyncResult LiveSolution::Sync(std::optional<std::chrono::milliseconds> timeout) {
+  using core::Program;
+
+  const auto changes = watcher_->Wait(timeout);
+  if (changes.empty()) {
+    return {};
+  }
+  const auto t_begin = std::chrono::steady_clock::now();
+
+  struct ProgramChanges {
+    std::vector<std::string> updated;
+    std::vector<std::string> dropped;
+  };
+  std::unordered_map<Program*, ProgramChanges> program_changes;
+  std::vector<std::pair<const Program*, std::string>> affected;
+
+  const auto collect_dependents = [&](const Program& program, const std::string& path) {
+    const auto* sf = program.GetFile(path);
+    if (sf == nullptr || !sf->module) {
+      return;
+    }
+    for (const auto* dependent : sf->module->dependents) {
+      affected.emplace_back(dependent->sf->program, dependent->sf->path);
+    }
+  };
+
+  const auto& dir = solution_.Directory();
+  for (const auto& change : changes) {
+    if (!tooling::Solution::IsSourceFile(change.path)) {
+      continue;
+    }
+    Program* program{nullptr};
+    for (auto& project : solution_.Projects()) {
+      if (project.program.GetFile(change.path)) {
+        program = &project.program;
+        break;
+      }
+    }
+    if (change.kind == tooling::fs::FileChangeKind::kDeleted) {
+      if (program) {
+        collect_dependents(*program, change.path);
+        program_changes[program].dropped.push_back(change.path);
+      }
+      continue;
+    }
+    if (program) {
+      collect_dependents(*program, change.path);
+    } else if (auto* project = solution_.ProjectOf(dir.Join(change.path)); project) {
+      program = &project->program;
+    } else {
+      continue;
+    }
+    program_changes[program].updated.push_back(change.path);
+  }
+
+  SyncResult result;
+  if (program_changes.empty()) {
+    return result;
+  }
+
+  const auto read_file = [&](const std::string& path, std::string& srcbuf) -> void {
+    const auto res = dir.ReadFile(path, [&](std::size_t size) {
+      srcbuf.resize(size);
+      return srcbuf.data();
+    });
+    if (!res) [[unlikely]] {
+      fmt::println("{} {}: {}", fmt::format(fmt::fg(fmt::color::yellow) | fmt::emphasis::bold, "warning:"), path,
+                   res.error().String());
+    }
+  };
+  task_arena_->execute([&] {
+    for (auto& [program, changed] : program_changes) {
+      program->Update([&](const Program::ProgramModifier& modify) {
+        for (const auto& path : changed.updated) {
+          modify.update(path, read_file);
+        }
+        for (const auto& path : changed.dropped) {
+          modify.drop(path);
+        }
+      });
+    }
+    solution_.Analyze();
+  });
+
+  for (const auto& [program, changed] : program_changes) {
+    result.changed_files += changed.updated.size() + changed.dropped.size();
+    for (const auto& path : changed.dropped) {
+      reports_.erase(path);
+    }
+    for (const auto& path : changed.updated) {
+      affected.emplace_back(program, path);
+      collect_dependents(*program, path);
+    }
+  }
+  std::ranges::sort(affected);
+  const auto [first, last] = std::ranges::unique(affected);
+  affected.erase(first, last);
+
+  for (const auto& [program, path] : affected) {
+    if (const auto* sf = program->GetFile(path); sf && Relint(*sf)) {
+      result.changed_reports.push_back(&reports_.at(path));
+    }
+  }
+  result.elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t_begin);
+  return result;
+}
+
+}  // namespace vanadium::bin::tidy
@@ -0,0 +1,72 @@
+#include "vanadium/bin/tidy/Report.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <fmt/color.h>
+#include <fmt/core.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/lint/Context.h>
+#include <vanadium/lint/Linter.h>
+#include <vanadium/lint/rules/NoEmpty.h>
+#include <vanadium/lint/rules/NoUnnecessaryValueof.h>
+#include <vanadium/lint/rules/NoUnusedImports.h>
+#include <vanadium/lint/rules/NoUnusedVars.h>
+#include <vanadium/tooling/Solution.h>
+
+namespace vanadium::bin::tidy {
+
+lint::Linter CreateLinter() {
+  lint::Linter linter;
+  linter.RegisterRule<lint::rules::NoEmpty>();
+  linter.RegisterRule<lint::rules::NoUnusedVars>();
+  linter.RegisterRule<lint::rules::NoUnusedImports>();
+  linter.RegisterRule<lint::rules::NoUnnecessaryValueof>();
+  return linter;
+}
+
+FileReport ReportProblems(const tooling::SolutionProject& project, const core::SourceFile& sf,
+                          const lint::ProblemSet& problems) {
+  FileReport report{.path = project.Directory().Join(sf.path)};
+  report.problems.reserve(problems.size());
+  for (const auto& problem : problems) {
+    const auto&& loc = sf.ast.lines.Translate(problem.range.begin);
+    report.problems.push_back(ReportedProblem{
+        .line = static_cast<std::uint32_t>(loc.line + 1),
+        .column = static_cast<std::uint32_t>(loc.column + 1),
+        .description = problem.description,
+        .reporter = std::string(problem.reporter),
+    });
+  }
+  return report;
+}
+
+FileReport LintFile(const lint::Linter& linter, const tooling::SolutionProject& project, const core::SourceFile& sf) {
+  if (!sf.ast.errors.empty()) {
+    return FileReport{.path = project.Directory().Join(sf.path), .has_syntax_errors = true};
+  }
+  return ReportProblems(project, sf, linter.Lint(sf));
+}
+
+void PrintFileReport(const FileReport& report) {
+  fmt::print(fmt::emphasis::underline | fmt::emphasis::bold, "{}\n", report.path);
+  if (report.has_syntax_errors) {
+    fmt::print("\tFile has syntax errors\n");
+    return;
+  }
+  for (const auto& problem : report.problems) {
+    fmt::print(" {}   {}   {}  {}\n", fmt::format(fmt::fg(fmt::color::black), "{:5}:{:<3}", problem.line, problem.column),
+               fmt::format(fmt::fg(fmt::color::tomato), "error"), fmt::format("{:<60}", problem.description),
+               fmt::format(fmt::fg(fmt::color::black), problem.reporter));
+  }
+}
+
+void PrintSummary(std::size_t total_problems) {
+  const bool has_problems = total_problems > 0;
+  fmt::print(fmt::emphasis::bold | fmt::fg(has_problems ? fmt::color::tomato : fmt::color::green), "\n {}  {}\n",
+             has_problems ? "✘" : "✔",
+             has_problems ? fmt::format("{} errors detected", total_problems) : "no problems found");
+}
+
+}  // namespace vanadium::bin::tidy
@@ -1,9 +1,15 @@
+#include <algorithm>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <ranges>
 #include <string>
 #include <thread>
+#include <utility>
 
 #include <argparse/argparse.hpp>
 #include <fmt/color.h>
@@ -11,39 +17,189 @@
 #include <oneapi/tbb/task_arena.h>
 
 #include <vanadium/bin/Bootstrap.h>
+#include <vanadium/core/MemoryStats.h>
 #include <vanadium/core/Program.h>
-#include <vanadium/lint/Context.h>
 #include <vanadium/lint/Linter.h>
-#include <vanadium/lint/rules/NoEmpty.h>
-#include <vanadium/lint/rules/NoUnnecessaryValueof.h>
-#include <vanadium/lint/rules/NoUnusedImports.h>
-#include <vanadium/lint/rules/NoUnusedVars.h>
 #include <vanadium/tooling/Filesystem.h>
+#include <vanadium/tooling/ModuleInterface.h>
 #include <vanadium/tooling/Solution.h>
 #include <vanadium/tooling/impl/SystemFS.h>
 
+#include "vanadium/bin/tidy/Daemon.h"
+#include "vanadium/bin/tidy/LiveSolution.h"
+#include "vanadium/bin/tidy/Report.h"
+
 namespace {
-vanadium::lint::Linter CreateLinter() {
-  vanadium::lint::Linter linter;
-  linter.RegisterRule<vanadium::lint::rules::NoEmpty>();
-  linter.RegisterRule<vanadium::lint::rules::NoUnusedVars>();
-  linter.RegisterRule<vanadium::lint::rules::NoUnusedImports>();
-  linter.RegisterRule<vanadium::lint::rules::NoUnnecessaryValueof>();
-  return linter;
+std::string FormatBytes(std::size_t bytes) {
+  return fmt::format("{:.1f} KiB", static_cast<double>(bytes) / 1024);
+}
+
+void PrintMemoryStats(const vanadium::tooling::Solution& solution) {
+  constexpr std::size_t kLargestFiles = 10;
+
+  std::size_t solution_total{0};
+  for (const auto& project : solution.Projects()) {
+    auto stats = project.program.CollectMemoryStats();
+    std::ranges::sort(stats.files, std::greater{}, &vanadium::core::FileMemoryStats::Total);
+
+    std::size_t arena_allocated{0};
+    std::size_t arena_used{0};
+    std::size_t heap{0};
+    for (const auto& fs : stats.files) {
+      arena_allocated += fs.arena_allocated;
+      arena_used += fs.arena_used;
+      heap += fs.HeapUsage();
+    }
+
+    fmt::print(fmt::emphasis::bold, "\n {} ", project.Name());
+    fmt::println("({} files): {}", stats.files.size(), FormatBytes(stats.Total()));
+    fmt::println("   arenas {} ({} used), heap {}, index {}, ASN.1 modules {} + {}", FormatBytes(arena_allocated),
+                 FormatBytes(arena_used), FormatBytes(heap), FormatBytes(stats.index),
+                 FormatBytes(stats.asn_modules_arena), FormatBytes(stats.asn_modules_heap));
+    for (const auto& fs : stats.files | std::views::take(kLargestFiles)) {
+      fmt::println("   {:>12}  {:<60} arena {} / {}, symbols {}, module {}, diagnostics {}", FormatBytes(fs.Total()),
+                   fs.path, FormatBytes(fs.arena_used), FormatBytes(fs.arena_allocated),
+                   FormatBytes(fs.symbol_tables), FormatBytes(fs.module), FormatBytes(fs.diagnostics));
+    }
+
+    solution_total += stats.Total();
+  }
+  fmt::print(fmt::emphasis::bold | fmt::fg(fmt::color::cyan), "\n * Memory held by the analysis: {}\n",
+             FormatBytes(solution_total));
+}
+
+// Writes the interfaces of the modules of the external projects into a directory per project,
+// keeping the layout of the sources. ASN.1 modules consist of the declarations only and are copied as they are
+int EmitInterfaces(const vanadium::tooling::Solution& solution, const std::filesystem::path& out_dir) {
+  std::size_t files{0};
+  std::size_t source_bytes{0};
+  std::size_t interface_bytes{0};
+  for (const auto& project : solution.Projects()) {
+    if (project.managed) {
+      continue;
+    }
+    const std::filesystem::path project_dir{project.Directory().base_path};
+    for (const auto& sf : project.program.Files() | std::views::values) {
+      const bool is_asn = sf.path.ends_with(".asn");
+      if (!is_asn && !sf.ast.errors.empty()) {
+        fmt::println("{} {} has syntax errors, its interface may be incomplete",
+                     fmt::format(fmt::fg(fmt::color::yellow) | fmt::emphasis::bold, "warning:"), sf.path);
+      }
+      const auto interface = is_asn ? sf.src : vanadium::tooling::EmitModuleInterface(sf.ast);
+
+      const auto out_path =
+          out_dir / project.Name() /
+          std::filesystem::path(solution.Directory().Join(sf.path)).lexically_relative(project_dir);
+      std::error_code ec;
+      std::filesystem::create_directories(out_path.parent_path(), ec);
+      std::ofstream out(out_path, std::ios::binary | std::ios::trunc);
+      if (!out.write(interface.data(), static_cast<std::streamsize>(interface.size()))) {
+        fmt::println("{} {}", fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "failed to write to file:"),
+                     out_path.string());
+        return 2;
+      }
+
+      ++files;
+      source_bytes += sf.src.size();
+      interface_bytes += interface.size();
+    }
+  }
+  fmt::print(fmt::emphasis::bold | fmt::fg(fmt::color::green), "\n ✔  {} interfaces written to {}\n", files,
+             out_dir.string());
+  fmt::println("    {} of the sources, {} of the interfaces", FormatBytes(source_bytes), FormatBytes(interface_bytes));
+  return 0;
+}
+
+// Keeps the solution loaded and reprints the files whose problems have changed as the files change
+int Watch(tbb::task_arena& task_arena, const std::string& solution_path) {
+  namespace tidy = vanadium::bin::tidy;
+
+  const auto t_load_begin = std::chrono::steady_clock::now();
+  const auto linter = tidy::CreateLinter();
+  auto solution = tidy::LiveSolution::Load(solution_path, task_arena, linter);
+  if (!solution) {
+    fmt::println("{} {}", fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "error:"),
+                 solution.error().String());
+    return 2;
+  }
+  auto& live = **solution;
+
+  for (const auto& report : live.Reports() | std::views::values) {
+    tidy::PrintFileReport(report);
+  }
+  tidy::PrintSummary(live.TotalProblems());
+  fmt::print(fmt::fg(fmt::color::cyan), "\n * Project loaded in {} ms, watching for changes\n\n",
+             std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - t_load_begin)
+                 .count());
+
+  while (true) {
+    const auto sync = live.Sync(std::nullopt);
+    if (sync.changed_files == 0) {
+      continue;
+    }
+    fmt::print(fmt::fg(fmt::color::cyan), " * {} files changed\n\n", sync.changed_files);
+    for (const auto* report : sync.changed_reports) {
+      tidy::PrintFileReport(*report);
+      if (report->Count() == 0) {
+        fmt::print("\tNo problems anymore\n");
+      }
+    }
+    tidy::PrintSummary(live.TotalProblems());
+    fmt::print(fmt::fg(fmt::color::cyan), "\n * Watching for changes ({} ms)\n\n", sync.elapsed.count());
+  }
+}
+
+// The output is the same as of the in-process run, with the paths relative to the given solution path
+int PrintDaemonResult(vanadium::bin::tidy::LintResult&& result, const std::string& solution_path,
+                      const std::string& root, std::chrono::milliseconds elapsed) {
+  namespace tidy = vanadium::bin::tidy;
+  if (result.error) {
+    fmt::println("{} {}", fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "error:"), *result.error);
+    return 2;
+  }
+  const vanadium::tooling::fs::SystemFS fs;
+  std::size_t total_problems{0};
+  for (auto& report : result.files) {
+    report.path = fs.Join(solution_path, fs.Relative(report.path, root));
+    tidy::PrintFileReport(report);
+    if (report.has_syntax_errors) {
+      return 2;
+    }
+    total_problems += report.Count();
+  }
+  tidy::PrintSummary(total_problems);
+  fmt::print(fmt::fg(fmt::color::cyan), "\n * Checked by the daemon in {} ms\n\n", elapsed.count());
+  return total_problems > 0 ? 1 : 0;
 }
 
 int main(int argc, char* argv[]) {
   std::uint32_t jobs{std::clamp(std::thread::hardware_concurrency(), 1U, 4U)};
   bool use_autofix{false};
-  std::string solution_path;
+  bool print_stats{false};
+  bool watch{false};
+  bool serve_daemon{false};
+  bool no_daemon{false};
+  std::string socket_path{vanadium::bin::tidy::DefaultSocketPath()};
+  std::string interface_dir;
+  std::string solution_path{"."};
 
   argparse::ArgumentParser ap("vanadium-tidy");
   ap.add_description("TTCN-3 source code static analyzer");
   //
   ap.add_argument("--fix").store_into(use_autofix).help("apply autofixes where possible");
   ap.add_argument("-j", "--parallel", "").store_into(jobs).help("maximum number of worker threads");
+  ap.add_argument("--stats").store_into(print_stats).help("print the memory held by the analysis");
+  ap.add_argument("--watch").store_into(watch).help("keep analyzing the changed files until interrupted");
+  ap.add_argument("--daemon")
+      .store_into(serve_daemon)
+      .help("keep the solutions loaded and lint them for the other runs, which connect to it if it is running");
+  ap.add_argument("--no-daemon").store_into(no_daemon).help("do not connect to the daemon even if it is running");
+  ap.add_argument("--socket").store_into(socket_path).help("socket of the daemon");
+  ap.add_argument("--emit-interface")
+      .store_into(interface_dir)
+      .help("write the module interfaces of the external projects into the directory instead of linting");
   //
-  ap.add_argument("path").store_into(solution_path).help("solution directory path");
+  ap.add_argument("path").default_value(solution_path).store_into(solution_path).help("solution directory path");
 
   //
   PARSE_CLI_ARGS_OR_EXIT(ap, argc, argv, 1);
@@ -51,6 +207,28 @@ int main(int argc, char* argv[]) {
 
   tbb::task_arena task_arena(jobs);
 
+  if (serve_daemon) {
+    return vanadium::bin::tidy::ServeDaemon(socket_path, task_arena);
+  }
+  if (watch) {
+    if (use_autofix) {
+      fmt::println("{} --fix cannot be combined with --watch",
+                   fmt::format(fmt::fg(fmt::color::red) | fmt::emphasis::bold, "error:"));
+      return 2;
+    }
+    return Watch(task_arena, solution_path);
+  }
+  // the rest needs the solution in-process
+  if (!no_daemon && !use_autofix && !print_stats && interface_dir.empty()) {
+    const auto t_begin = std::chrono::steady_clock::now();
+    const auto root = std::filesystem::weakly_canonical(std::filesystem::absolute(solution_path)).string();
+    if (auto result = vanadium::bin::tidy::LintWithDaemon(socket_path, root)) {
+      return PrintDaemonResult(std::move(*result), solution_path, root,
+                               std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - t_begin));
+    }
+  }
+
   const auto t_load_begin = std::chrono::steady_clock::now();
   auto solution_opt = task_arena.execute([&] {
     return vanadium::tooling::Solution::Load(
@@ -65,13 +243,17 @@ int main(int argc, char* argv[]) {
   const auto& dir = solution.Directory();
   const auto t_load_end = std::chrono::steady_clock::now();
 
+  if (!interface_dir.empty()) {
+    return EmitInterfaces(solution, interface_dir);
+  }
+
   //
 
   const auto t_lint_begin = std::chrono::steady_clock::now();
 
   std::size_t total_problems = 0;
   std::size_t fixed_problems = 0;
-  auto linter = CreateLinter();
+  const auto linter = vanadium::bin::tidy::CreateLinter();
   for (const auto& project : solution.Projects()) {
     if (!project.managed) {
       continue;
@@ -83,9 +265,8 @@ int main(int argc, char* argv[]) {
         continue;
       }
 
-      fmt::print(fmt::emphasis::underline | fmt::emphasis::bold, "{}\n", project.Directory().Join(sf.path));
       if (!sf.ast.errors.empty()) {
-        fmt::println("\tFile has syntax errors");
+        vanadium::bin::tidy::PrintFileReport(vanadium::bin::tidy::LintFile(linter, project, sf));
         return 2;
       }
 
@@ -107,13 +288,7 @@ int main(int argc, char* argv[]) {
         }
         problems = std::move(refined_problems);
       }
-      for (const auto& problem : problems) {
-        const auto&& loc = sf.ast.lines.Translate(problem.range.begin);
-        fmt::print(" {}   {}   {}  {}\n",
-                   fmt::format(fmt::fg(fmt::color::black), "{:5}:{:<3}", loc.line + 1, loc.column + 1),
-                   fmt::format(fmt::fg(fmt::color::tomato), "error"), fmt::format("{:<60}", problem.description),
-                   fmt::format(fmt::fg(fmt::color::black), problem.reporter));
-      }
+      vanadium::bin::tidy::PrintFileReport(vanadium::bin::tidy::ReportProblems(project, sf, problems));
       total_problems += problems.size();
     }
   }
@@ -123,9 +298,7 @@ int main(int argc, char* argv[]) {
   }
 
   const bool has_problems = total_problems > 0;
-  fmt::print(fmt::emphasis::bold | fmt::fg(has_problems ? fmt::color::tomato : fmt::color::green), "\n {}  {}\n",
-             has_problems ? "✘" : "✔",
-             has_problems ? fmt::format("{} errors detected", total_problems) : "no problems found");
+  vanadium::bin::tidy::PrintSummary(total_problems);
 
   fmt::print(fmt::fg(fmt::color::cyan), "\n * Project loaded in {} ms with {} jobs\n\n",
              std::chrono::duration_cast<std::chrono::milliseconds>(t_load_end - t_load_begin).count(), jobs);
@@ -133,6 +306,10 @@ int main(int argc, char* argv[]) {
   fmt::print(fmt::fg(fmt::color::cyan), "\n                         ({} ms)\n",
              std::chrono::duration_cast<std::chrono::milliseconds>(t_lint_end - t_lint_begin).count());
 
+  if (print_stats) {
+    PrintMemoryStats(solution);
+  }
+
   return has_problems ? 1 : 0;
 }
 }  // namespace
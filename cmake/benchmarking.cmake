@@ -0,0 +1,49 @@
+set(VANADIUM_BENCHMARK_TARGETS "" CACHE INTERNAL "All benchmark targets")
+
+function(add_benchmark_executable target_name)
+  set(BENCH_TARGET_NAME "${target_name}_bench")
+  set(BENCH_SRC_DIR "${CMAKE_CURRENT_LIST_DIR}/bench")
+  file(GLOB_RECURSE BENCH_SOURCES "${BENCH_SRC_DIR}/*.cpp")
+
+  if(NOT BENCH_SOURCES)
+    return()
+  endif()
+
+  add_executable(${BENCH_TARGET_NAME} ${BENCH_SOURCES})
+
+  target_link_libraries(${BENCH_TARGET_NAME} PRIVATE
+    ${target_name}
+    benchmark::benchmark_main
+  )
+
+  # include private headers too (include/ when interface/ exists)
+  target_include_directories(${BENCH_TARGET_NAME} PRIVATE
+    $<TARGET_PROPERTY:${target_name},INCLUDE_DIRECTORIES>
+  )
+
+  list(APPEND VANADIUM_BENCHMARK_TARGETS ${BENCH_TARGET_NAME})
+  set(VANADIUM_BENCHMARK_TARGETS "${VANADIUM_BENCHMARK_TARGETS}" CACHE INTERNAL "All benchmark targets")
+endfunction()
+
+function(add_benchmarks_build_target)
+  add_custom_target(build_benchmarks)
+  if (VANADIUM_BENCHMARK_TARGETS)
+    add_dependencies(build_benchmarks ${VANADIUM_BENCHMARK_TARGETS})
+  endif()
+
+  # The results are kept as JSON to be compared between the builds, e.g. with compare.py of Google Benchmark
+  set(BENCH_COMMANDS "")
+  foreach(BENCH_TARGET_NAME ${VANADIUM_BENCHMARK_TARGETS})
+    list(APPEND BENCH_COMMANDS
+      COMMAND ${BENCH_TARGET_NAME}
+              --benchmark_out=${CMAKE_BINARY_DIR}/${BENCH_TARGET_NAME}.json
+              --benchmark_out_format=json
+    )
+  endforeach()
+  add_custom_target(run_benchmarks
+    ${BENCH_COMMANDS}
+    DEPENDS build_benchmarks
+    USES_TERMINAL
+    COMMENT "Running the benchmarks"
+  )
+endfunction()
@@ -0,0 +1,12 @@
+FetchContent_Declare(
+  benchmark      # 1.9.1
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG        v1.9.1
+  GIT_SHALLOW 1
+)
+
+set(BENCHMARK_ENABLE_TESTING OFF)
+set(BENCHMARK_ENABLE_INSTALL OFF)
+set(BENCHMARK_INSTALL_DOCS OFF)
+
+FetchContent_MakeAvailable(benchmark)
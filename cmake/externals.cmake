@@ -5,6 +5,7 @@ function(_vanadium_external external_name)
 endfunction()
 
 _vanadium_external(gtest)
+_vanadium_external(benchmark)
 _vanadium_external(magic_enum)
 _vanadium_external(glaze)
 _vanadium_external(tbb)
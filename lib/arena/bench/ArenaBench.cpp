@@ -0,0 +1,83 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <benchmark/benchmark.h>
+
+#include <vanadium/lib/Arena.h>
+
+namespace {
+
+using namespace vanadium;
+
+// Mostly the small nodes and a few larger vectors, as a parse takes.
+// The arena sizes range from an LSP request to a reparse of a large module.
+constexpr std::size_t kNodeSize = 48;
+constexpr std::size_t kLargeAllocationEvery = 256;
+constexpr std::size_t kLargeAllocationSize = 4096;
+
+template <typename Allocate>
+void FillArena(std::size_t bytes, Allocate&& allocate) {
+  std::size_t allocated{0};
+  for (std::size_t i = 0; allocated < bytes; ++i) {
+    const std::size_t size = (i % kLargeAllocationEvery == 0) ? kLargeAllocationSize : kNodeSize;
+    benchmark::DoNotOptimize(allocate(size));
+    allocated += size;
+  }
+}
+
+// A fresh arena for each file, as the files are updated by the parallel tasks
+void BM_ArenaChurn(benchmark::State& state) {
+  const auto bytes = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    lib::Arena arena;
+    FillArena(bytes, [&](std::size_t size) {
+      return arena.AllocBuffer(size);
+    });
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_ArenaChurn)->RangeMultiplier(16)->Range(4 << 10, 4 << 20)->ThreadRange(1, 16)->UseRealTime();
+
+// The same arena reset and filled again, as on a reparse of the same file
+void BM_ArenaReset(benchmark::State& state) {
+  lib::Arena arena;
+  const auto bytes = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    arena.Reset();
+    FillArena(bytes, [&](std::size_t size) {
+      return arena.AllocBuffer(size);
+    });
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_ArenaReset)->RangeMultiplier(16)->Range(4 << 10, 4 << 20)->ThreadRange(1, 16)->UseRealTime();
+
+// The same arena sized upfront from a hint
+void BM_ArenaReserved(benchmark::State& state) {
+  const auto bytes = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    lib::Arena arena;
+    arena.Reserve(bytes);
+    FillArena(bytes, [&](std::size_t size) {
+      return arena.AllocBuffer(size);
+    });
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_ArenaReserved)->RangeMultiplier(16)->Range(4 << 10, 4 << 20)->ThreadRange(1, 16)->UseRealTime();
+
+// For comparison: the same growth straight from the global allocator, which is how the arena used to behave
+void BM_MonotonicBufferChurn(benchmark::State& state) {
+  const auto bytes = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    std::pmr::monotonic_buffer_resource resource(256, std::pmr::new_delete_resource());
+    FillArena(bytes, [&](std::size_t size) {
+      return resource.allocate(size, alignof(std::max_align_t));
+    });
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+}
+BENCHMARK(BM_MonotonicBufferChurn)->RangeMultiplier(16)->Range(4 << 10, 4 << 20)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
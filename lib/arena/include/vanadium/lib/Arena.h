@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstddef>
+#include <format>
 #include <memory>
 #include <span>
+#include <string_view>
 #include <type_traits>
 
 namespace vanadium::lib {
@@ -37,9 +39,34 @@ class Arena {
     return {buf, length};
   }
 
+  // Formats straight into the arena, sparing the intermediate std::string
+  template <typename... Args>
+  std::string_view Format(std::format_string<Args...> fmt, Args&&... args) {
+    const auto length = std::formatted_size(fmt, args...);
+    const auto buf = AllocStringBuffer(length);
+    std::format_to_n(buf.data(), length, fmt, args...);
+    return {buf.data(), length};
+  }
+
+  // Makes sure that the next `size` bytes are allocated from a single block,
+  // e.g. when the amount of memory to be needed can be estimated from the source length
+  void Reserve(std::size_t size);
+
+  // A sequence of unknown length is written in place into the free space of the active block: Extend gives room for
+  // `size` more bytes past the `used` ones of the buffer it has returned before (moving them into a new block once
+  // the free space runs out), and Commit claims the used ones. Nothing else is to be allocated in between
+  std::span<std::byte> Extend(std::span<std::byte> buf, std::size_t used, std::size_t size, std::size_t alignment);
+  void Commit(std::span<std::byte> buf, std::size_t used);
+
   void Reset();
   void Release();
 
+  // The blocks of the released arenas are kept by each thread for reuse (see Arena.cpp),
+  // this gives back the ones kept by the calling thread
+  static void ReleaseCachedBlocks();
+  // Reserved for the blocks kept by all the threads together, at most a few chunks over what they keep
+  [[nodiscard]] static std::size_t CachedBytes() noexcept;
+
   [[nodiscard]] std::size_t SpaceAllocated() const noexcept {
     return bytes_allocated_;
   }
@@ -50,7 +77,7 @@ class Arena {
  private:
   // Block's and CleanupNode's next is prev actually
 
-  struct Block {
+  struct alignas(std::max_align_t) Block {
     std::byte* pos;
     std::byte* end;
     //
@@ -81,6 +108,7 @@ class Arena {
 
  private:
   Block* AllocateNewBlock(std::size_t size);
+  static void FreeBlock(Block* block);
 
   Block* active_{nullptr};
 
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "vanadium/lib/Arena.h"
+
+namespace vanadium::lib {
+
+// Exposes the arena to the allocator-aware code. Deallocation is a no-op,
+// the memory is given back only when the arena itself is reset or released,
+// so it suits the short-lived containers which do not grow much. Every buffer
+// a container outgrows stays in the arena, so the ones of a known size are to be reserved upfront.
+class ArenaResource final : public std::pmr::memory_resource {
+ public:
+  explicit ArenaResource(Arena& arena) noexcept : arena_(&arena) {}
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) final {
+    return arena_->AllocBuffer(bytes, alignment);
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) final {}
+
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final {
+    return this == &other;
+  }
+
+  Arena* arena_;
+};
+
+}  // namespace vanadium::lib
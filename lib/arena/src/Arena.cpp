@@ -1,16 +1,144 @@
 #include "vanadium/lib/Arena.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <format>
 #include <iostream>
+#include <span>
 #include <utility>
 
+// The blocks are allocated in power-of-two size classes (the block header included) and recycled:
+// once an arena is reset or released, its blocks are kept by the thread for the next arenas,
+// so that the reparses and the short-lived request arenas do not go to the global allocator each time.
+// Every thread has its own cache, no locking is involved. The amount of memory kept by all the threads together
+// is capped, so that the blocks stranded in the caches of the threads that went idle stay bounded:
+// the threads reserve their share of the limit in chunks, and give back what they no longer use.
+// The blocks above the limit and the ones larger than the largest class are freed right away.
+
 namespace {
+constexpr std::size_t kMinBlockSize = std::size_t{1} << 8;
+constexpr std::size_t kMaxPooledBlockSize = std::size_t{1} << 24;
+constexpr std::size_t kSizeClasses = std::countr_zero(kMaxPooledBlockSize) - std::countr_zero(kMinBlockSize) + 1;
+
+constexpr std::size_t kMaxCachedBytes = std::size_t{64} << 20;  // by all the threads
+constexpr std::size_t kQuotaChunk = std::size_t{1} << 20;
+
+// Reserved by the threads for their caches
+std::atomic<std::size_t> total_quota{0};
+
+// The size of the allocation holding the block of the given capacity
+std::size_t BlockAllocationSize(std::size_t capacity) {
+  const std::size_t size = std::max(capacity, kMinBlockSize);
+  return size <= kMaxPooledBlockSize ? std::bit_ceil(size) : size;
+}
+
+class BlockCache {
+ public:
+  BlockCache() = default;
+
+  BlockCache(const BlockCache&) = delete;
+  BlockCache& operator=(const BlockCache&) = delete;
+
+  ~BlockCache();
+
+  std::byte* Take(std::size_t size) {
+    if (!IsPooledSize(size)) {
+      return nullptr;
+    }
+    auto*& head = free_[SizeClass(size)];
+    if (head == nullptr) {
+      return nullptr;
+    }
+    auto* const p = reinterpret_cast<std::byte*>(std::exchange(head, head->next));
+    cached_bytes_ -= size;
+    if (quota_ - cached_bytes_ > 2 * kQuotaChunk) {
+      const auto surplus = quota_ - cached_bytes_ - kQuotaChunk;
+      total_quota.fetch_sub(surplus, std::memory_order_relaxed);
+      quota_ -= surplus;
+    }
+    return p;
+  }
+
+  bool Put(std::byte* p, std::size_t size) {
+    if (!IsPooledSize(size)) {
+      return false;
+    }
+    if (cached_bytes_ + size > quota_ && !AcquireQuota(cached_bytes_ + size - quota_)) {
+      return false;
+    }
+    auto*& head = free_[SizeClass(size)];
+    head = new (p) FreeBlock{.next = head};
+    cached_bytes_ += size;
+    return true;
+  }
+
+  void Clear();
+
+ private:
+  bool AcquireQuota(std::size_t needed) {
+    for (const auto amount : {std::max(needed, kQuotaChunk), needed}) {
+      if (total_quota.fetch_add(amount, std::memory_order_relaxed) + amount <= kMaxCachedBytes) {
+        quota_ += amount;
+        return true;
+      }
+      total_quota.fetch_sub(amount, std::memory_order_relaxed);
+    }
+    return false;
+  }
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  static bool IsPooledSize(std::size_t size) {
+    return size >= kMinBlockSize && size <= kMaxPooledBlockSize && std::has_single_bit(size);
+  }
+  static std::size_t SizeClass(std::size_t size) {
+    return std::countr_zero(size) - std::countr_zero(kMinBlockSize);
+  }
+
+  std::array<FreeBlock*, kSizeClasses> free_{};
+  std::size_t cached_bytes_{0};
+  std::size_t quota_{0};  // reserved from the limit, no less than cached_bytes_
+};
+
+// The arenas may outlive the cache of the thread (e.g. the static ones), they free their blocks directly then
+thread_local bool block_cache_destroyed{false};
+thread_local BlockCache block_cache;
+
+void BlockCache::Clear() {
+  for (auto*& head : free_) {
+    while (head != nullptr) {
+      delete[] reinterpret_cast<std::byte*>(std::exchange(head, head->next));
+    }
+  }
+  total_quota.fetch_sub(quota_, std::memory_order_relaxed);
+  cached_bytes_ = 0;
+  quota_ = 0;
+}
+
+BlockCache::~BlockCache() {
+  Clear();
+  block_cache_destroyed = true;
+}
+
 inline std::byte* arena_allocate(std::size_t size) {
+  if (!block_cache_destroyed) {
+    if (auto* const p = block_cache.Take(size)) {
+      return p;
+    }
+  }
   return new std::byte[size];
 }
-inline void arena_deallocate(void* p) {
-  delete[] reinterpret_cast<std::byte*>(p);
+inline void arena_deallocate(void* p, std::size_t size) {
+  if (block_cache_destroyed || !block_cache.Put(reinterpret_cast<std::byte*>(p), size)) {
+    delete[] reinterpret_cast<std::byte*>(p);
+  }
 }
 }  // namespace
 
@@ -48,7 +176,11 @@ inline std::size_t Arena::Block::Size() const noexcept {
 }
 
 Arena::Block* Arena::AllocateNewBlock(std::size_t size) {
-  auto* const p = arena_allocate(sizeof(Block) + size);
+  // the block takes the whole size class
+  const std::size_t allocation_size = BlockAllocationSize(sizeof(Block) + size);
+  size = allocation_size - sizeof(Block);
+
+  auto* const p = arena_allocate(allocation_size);
   auto* const block = new (p) Block(size);
 
   bytes_allocated_ += size;
@@ -56,29 +188,91 @@ Arena::Block* Arena::AllocateNewBlock(std::size_t size) {
   return block;
 }
 
+void Arena::FreeBlock(Block* block) {
+  arena_deallocate(block, sizeof(Block) + block->Size());
+}
+
 std::byte* Arena::AllocBuffer(std::size_t size, std::size_t alignment) {
-  const auto get_remaining_space = [&] {
-    return active_->end - active_->pos;
+  const auto try_allocate = [&]() -> std::byte* {
+    const auto pos = reinterpret_cast<std::uintptr_t>(active_->pos);
+    const auto aligned_pos = (pos + alignment - 1) & ~(alignment - 1);
+    if (aligned_pos - pos + size > static_cast<std::size_t>(active_->end - active_->pos)) {
+      return nullptr;
+    }
+    auto* const aligned_ptr = active_->pos + (aligned_pos - pos);
+    active_->pos = aligned_ptr + size;
+    bytes_used_ += size;
+    return aligned_ptr;
   };
-  std::size_t space;
 
-  if (active_ == nullptr) [[unlikely]] {
-    active_ = AllocateNewBlock(std::max(size, 256UL));
-    space = get_remaining_space();
-  } else {
-    space = get_remaining_space();
-    if (space < (size + alignment - 1)) {
-      auto* const new_block = AllocateNewBlock(std::max(size, 2 * active_->Size()));
-      new_block->next = std::exchange(active_, new_block);
-      space = get_remaining_space();
+  if (active_ != nullptr) [[likely]] {
+    if (auto* const p = try_allocate()) [[likely]] {
+      return p;
+    }
+  }
+
+  // the blocks are aligned to max_align_t, the stricter alignments need some slack
+  const std::size_t required = size + (alignment > alignof(Block) ? alignment - 1 : 0);
+
+  auto* const new_block = AllocateNewBlock(active_ ? std::max(required, 2 * active_->Size()) : required);
+  new_block->next = std::exchange(active_, new_block);
+  return try_allocate();
+}
+
+void Arena::Reserve(std::size_t size) {
+  if (active_ != nullptr) {
+    if (static_cast<std::size_t>(active_->end - active_->pos) >= size) {
+      return;
+    }
+    if (active_->pos == active_->Begin() && active_->next == nullptr) {
+      // nothing has been allocated yet, the block is replaced rather than kept aside
+      bytes_allocated_ -= active_->Size();
+      FreeBlock(std::exchange(active_, nullptr));
     }
   }
 
-  void* ptr = active_->pos;
-  auto* aligned_ptr = reinterpret_cast<std::byte*>(std::align(alignment, size, ptr, space));
-  active_->pos = aligned_ptr + size;
-  bytes_used_ += size;
-  return aligned_ptr;
+  auto* const new_block = AllocateNewBlock(std::max(size, active_ ? 2 * active_->Size() : 0));
+  new_block->next = std::exchange(active_, new_block);
+}
+
+std::span<std::byte> Arena::Extend(std::span<std::byte> buf, std::size_t used, std::size_t size,
+                                   std::size_t alignment) {
+  const auto align = [&](std::byte* p) {
+    const auto pos = reinterpret_cast<std::uintptr_t>(p);
+    return p + (((pos + alignment - 1) & ~(alignment - 1)) - pos);
+  };
+
+  if (used + size <= buf.size()) {
+    return buf;
+  }
+  if (buf.empty() && active_ != nullptr) {
+    if (auto* const p = align(active_->pos); static_cast<std::size_t>(active_->end - p) >= size) {
+      return {p, active_->end};
+    }
+  }
+
+  // the blocks are aligned to max_align_t, the stricter alignments need some slack
+  const std::size_t required = used + size + (alignment > alignof(Block) ? alignment - 1 : 0);
+
+  auto* const new_block = AllocateNewBlock(active_ ? std::max(required, 2 * active_->Size()) : required);
+  auto* const p = align(new_block->pos);
+  std::memcpy(p, buf.data(), used);
+
+  if (active_ != nullptr && active_->pos == active_->Begin() && active_->next == nullptr) {
+    // nothing but the buffer has been written there, the block is replaced rather than kept aside
+    bytes_allocated_ -= active_->Size();
+    FreeBlock(std::exchange(active_, nullptr));
+  }
+  new_block->next = std::exchange(active_, new_block);
+  return {p, active_->end};
+}
+
+void Arena::Commit(std::span<std::byte> buf, std::size_t used) {
+  if (used == 0) {
+    return;
+  }
+  active_->pos = buf.data() + used;
+  bytes_used_ += used;
 }
 
 void Arena::AddToCleanupList(void* obj, CleanupFunc cleanup) {
@@ -102,7 +296,7 @@ void Arena::Reset() {
   Block* b = active_->next;
   while (b) {
     auto* const next = b->next;
-    arena_deallocate(b);
+    FreeBlock(b);
     b = next;
   }
   active_->pos = active_->Begin();
@@ -114,8 +308,20 @@ void Arena::Reset() {
 
 void Arena::Release() {
   Reset();
-  arena_deallocate(active_);
-  active_ = nullptr;
+  if (active_ != nullptr) {
+    FreeBlock(std::exchange(active_, nullptr));
+  }
+  bytes_allocated_ = 0;
+}
+
+void Arena::ReleaseCachedBlocks() {
+  if (!block_cache_destroyed) {
+    block_cache.Clear();
+  }
+}
+
+std::size_t Arena::CachedBytes() noexcept {
+  return total_quota.load(std::memory_order_relaxed);
 }
 
 };  // namespace vanadium::lib
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <barrier>
 #include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "vanadium/lib/Arena.h"
+#include "vanadium/lib/ArenaResource.h"
 
 using namespace ::testing;
 
@@ -65,3 +71,113 @@ TEST(ArenaTest, CallsNonTrivialDestructors) {
   arena.Reset();
   EXPECT_EQ(destructed_objects, constructed_objects);
 }
+
+TEST(ArenaTest, FormatsIntoArena) {
+  vanadium::lib::Arena arena;
+
+  const auto sv = arena.Format("{} := {}", "field", 42);
+  EXPECT_EQ(sv, "field := 42");
+  EXPECT_EQ(sv.data()[sv.size()], '\0');
+  EXPECT_GE(arena.SpaceUsed(), sv.size() + 1);
+}
+
+TEST(ArenaTest, ServesAsMemoryResource) {
+  vanadium::lib::Arena arena;
+  vanadium::lib::ArenaResource resource(arena);
+
+  std::pmr::vector<std::uint64_t> v(&resource);
+  v.reserve(64);
+  for (std::uint64_t i = 0; i < 64; ++i) {
+    v.push_back(i);
+  }
+  EXPECT_GE(arena.SpaceUsed(), 64 * sizeof(std::uint64_t));
+  EXPECT_EQ(v.back(), 63);
+}
+
+TEST(ArenaTest, RecyclesReleasedBlocks) {
+  vanadium::lib::Arena::ReleaseCachedBlocks();
+
+  std::byte* first_block_data;
+  {
+    vanadium::lib::Arena arena;
+    first_block_data = arena.AllocBuffer(1000);
+    arena.AllocBuffer(1000);  // spills into the next block
+    ASSERT_GT(arena.SpaceAllocated(), 1000);
+  }
+
+  vanadium::lib::Arena arena;
+  EXPECT_EQ(arena.AllocBuffer(1000), first_block_data);
+
+  arena.Release();
+  EXPECT_EQ(arena.SpaceAllocated(), 0);
+}
+
+TEST(ArenaTest, CapsBlocksCachedByAllThreads) {
+  constexpr std::size_t kThreads = 8;
+  constexpr std::size_t kBlockSize = std::size_t{16} << 20;
+
+  vanadium::lib::Arena::ReleaseCachedBlocks();
+
+  // the threads are kept alive until the end, so that their caches are not destroyed
+  std::barrier released(kThreads + 1);
+  std::barrier done(kThreads + 1);
+  std::vector<std::jthread> threads;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&] {
+      {
+        vanadium::lib::Arena arena;
+        arena.Reserve(kBlockSize / 2);
+      }
+      released.arrive_and_wait();
+      done.arrive_and_wait();
+    });
+  }
+  released.arrive_and_wait();
+  EXPECT_GT(vanadium::lib::Arena::CachedBytes(), 0);
+  EXPECT_LE(vanadium::lib::Arena::CachedBytes(), 64 << 20);
+  done.arrive_and_wait();
+}
+
+TEST(ArenaTest, ReservesSingleBlock) {
+  constexpr std::size_t kSize = 100000;
+
+  vanadium::lib::Arena arena;
+  arena.AllocBuffer(16);
+  arena.Reset();
+
+  arena.Reserve(kSize);
+  const auto space_allocated = arena.SpaceAllocated();
+  EXPECT_GE(space_allocated, kSize);
+
+  auto* const begin = arena.AllocBuffer(8, 8);
+  for (std::size_t i = 8; i < kSize; i += 8) {
+    arena.AllocBuffer(8, 8);
+  }
+  EXPECT_EQ(arena.AllocBuffer(0, 1) - begin, kSize);  // contiguous
+  EXPECT_EQ(arena.SpaceAllocated(), space_allocated);
+}
+
+TEST(ArenaTest, ExtendsBufferInPlace) {
+  vanadium::lib::Arena arena;
+  arena.Reserve(1024);
+  auto* const before = arena.AllocBuffer(4, 4);
+
+  auto buf = arena.Extend({}, 0, 64, alignof(std::uint32_t));
+  EXPECT_EQ(buf.data(), before + 4);  // the free space of the active block
+  EXPECT_GE(buf.size(), 64);
+
+  std::size_t n{0};
+  for (; n < 1000; ++n) {
+    if ((n + 1) * sizeof(std::uint32_t) > buf.size()) {
+      buf = arena.Extend(buf, n * sizeof(std::uint32_t), (n + 1) * sizeof(std::uint32_t), alignof(std::uint32_t));
+    }
+    reinterpret_cast<std::uint32_t*>(buf.data())[n] = static_cast<std::uint32_t>(n);
+  }
+  arena.Commit(buf, n * sizeof(std::uint32_t));
+
+  const auto* const values = reinterpret_cast<const std::uint32_t*>(buf.data());
+  for (std::size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(values[i], i);  // moved along with the growth
+  }
+  EXPECT_EQ(arena.AllocBuffer(0, 1), buf.data() + n * sizeof(std::uint32_t));  // claimed
+}
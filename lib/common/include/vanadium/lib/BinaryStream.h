@@ -0,0 +1,117 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace vanadium::lib {
+
+// Little-endian fixed-width integers and LEB128 varints appended to a string
+
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(std::string& buf) : buf_(buf) {}
+
+  template <std::unsigned_integral T>
+  void Fixed(T value) {
+    if constexpr (std::endian::native == std::endian::big) {
+      value = std::byteswap(value);
+    }
+    buf_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void Varint(std::uint64_t value) {
+    while (value >= 0x80) {
+      buf_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    buf_.push_back(static_cast<char>(value));
+  }
+
+  void Bytes(std::string_view bytes) {
+    Varint(bytes.size());
+    buf_.append(bytes);
+  }
+
+ private:
+  std::string& buf_;
+};
+
+// Reads what BinaryWriter has written, every read past the end or of a malformed value
+// puts the reader into the failed state and yields zeroes from then on
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view buf) : buf_(buf) {}
+
+  template <std::unsigned_integral T>
+  T Fixed() {
+    T value{0};
+    if (!Require(sizeof(T))) {
+      return value;
+    }
+    std::memcpy(&value, buf_.data(), sizeof(T));
+    buf_.remove_prefix(sizeof(T));
+    if constexpr (std::endian::native == std::endian::big) {
+      value = std::byteswap(value);
+    }
+    return value;
+  }
+
+  std::uint64_t Varint() {
+    std::uint64_t value{0};
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (!Require(1)) {
+        return 0;
+      }
+      const auto byte = static_cast<std::uint8_t>(buf_.front());
+      buf_.remove_prefix(1);
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    failed_ = true;
+    return 0;
+  }
+
+  std::string_view Bytes() {
+    const auto size = Varint();
+    if (!Require(size)) {
+      return {};
+    }
+    const auto bytes = buf_.substr(0, size);
+    buf_.remove_prefix(size);
+    return bytes;
+  }
+
+  [[nodiscard]] std::string_view Remaining() const noexcept {
+    return buf_;
+  }
+
+  // Lets the consumer reject the contents it has found invalid
+  void Fail() noexcept {
+    failed_ = true;
+  }
+
+  [[nodiscard]] bool Failed() const noexcept {
+    return failed_;
+  }
+
+ private:
+  bool Require(std::size_t n) {
+    if (failed_ || buf_.size() < n) [[unlikely]] {
+      failed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  std::string_view buf_;
+  bool failed_{false};
+};
+
+}  // namespace vanadium::lib
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace vanadium::lib {
+
+// 64-bit FNV-1a, stable across the runs and the platforms unlike std::hash
+constexpr std::uint64_t ContentHash(std::string_view data, std::uint64_t seed = 0xcbf29ce484222325ULL) noexcept {
+  std::uint64_t hash = seed;
+  for (const char c : data) {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+constexpr std::uint64_t CombineHashes(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+  return lhs ^ (rhs + 0x9e3779b97f4a7c15ULL + (lhs << 6) + (lhs >> 2));
+}
+
+}  // namespace vanadium::lib
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Estimates of the heap memory held by the standard containers, the container object itself is not included.
+// They follow the libstdc++ layout: a node per element of the hashed containers (the cached hash included)
+// and the bucket array unless there is a single bucket, which is kept inside the container.
+
+namespace vanadium::lib {
+
+namespace detail {
+template <typename Value>
+constexpr std::size_t kHashNodeSize = sizeof(void*) + sizeof(Value) + sizeof(std::size_t);
+
+constexpr std::size_t BucketsHeapUsage(std::size_t bucket_count) noexcept {
+  return bucket_count > 1 ? bucket_count * sizeof(void*) : 0;
+}
+}  // namespace detail
+
+template <typename T, typename Allocator>
+std::size_t HeapUsage(const std::vector<T, Allocator>& v) noexcept {
+  return v.capacity() * sizeof(T);
+}
+
+template <typename Char, typename Traits, typename Allocator>
+std::size_t HeapUsage(const std::basic_string<Char, Traits, Allocator>& s) noexcept {
+  constexpr std::size_t kInlineCapacity = 15 / sizeof(Char);
+  return s.capacity() > kInlineCapacity ? (s.capacity() + 1) * sizeof(Char) : 0;
+}
+
+template <typename K, typename V, typename... Rest>
+std::size_t HeapUsage(const std::unordered_map<K, V, Rest...>& m) noexcept {
+  return detail::BucketsHeapUsage(m.bucket_count()) + m.size() * detail::kHashNodeSize<std::pair<const K, V>>;
+}
+
+template <typename K, typename V, typename... Rest>
+std::size_t HeapUsage(const std::unordered_multimap<K, V, Rest...>& m) noexcept {
+  return detail::BucketsHeapUsage(m.bucket_count()) + m.size() * detail::kHashNodeSize<std::pair<const K, V>>;
+}
+
+template <typename K, typename... Rest>
+std::size_t HeapUsage(const std::unordered_set<K, Rest...>& s) noexcept {
+  return detail::BucketsHeapUsage(s.bucket_count()) + s.size() * detail::kHashNodeSize<K>;
+}
+
+}  // namespace vanadium::lib
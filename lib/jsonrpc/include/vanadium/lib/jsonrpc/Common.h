@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -158,4 +159,28 @@ using GenericResponse = Response<glz::raw_json_view>;
 
 struct Empty {};
 
+//
+
+// Serializes the value into the buffer past its first `offset` bytes, which are left untouched
+// (so that the transport framing could be put there later without moving the payload).
+// The capacity the buffer already has is reused as is.
+template <typename T>
+[[nodiscard]] glz::error_ctx WriteJson(T&& value, std::string& buffer, std::size_t offset = 0) {
+  constexpr std::size_t kInitialSpace = 256;
+  buffer.resize(offset + kInitialSpace);
+
+  glz::context ctx{};
+  std::size_t ix = offset;
+  glz::to<glz::JSON, std::remove_cvref_t<T>>::template op<glz::opts{}>(std::forward<T>(value), ctx, buffer, ix);
+  if (bool(ctx.error)) [[unlikely]] {
+    buffer.resize(offset);
+    glz::error_ctx err{};
+    err.ec = ctx.error;
+    return err;
+  }
+
+  buffer.resize(ix);
+  return {};
+}
+
 };  // namespace vanadium::lib::jsonrpc
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
@@ -47,12 +48,15 @@ class Server {
     return handlers_.contains(method);
   }
 
-  std::optional<std::string_view> Call(TContext& ctx, std::string& res_buffer, std::string_view json_request) {
+  // The response is written to res_buffer past its first `offset` bytes
+  std::optional<std::string_view> Call(TContext& ctx, std::string& res_buffer, std::string_view json_request,
+                                       std::size_t offset = 0) {
     const auto write_json = [&]<typename TRet>(TRet&& response) -> std::string_view {
-      if (const glz::error_ctx err = glz::write_json(std::forward<TRet>(response), res_buffer); err) {
-        res_buffer = glz::format_error(err);
+      if (const glz::error_ctx err = WriteJson(std::forward<TRet>(response), res_buffer, offset); err) {
+        res_buffer.resize(offset);
+        res_buffer += glz::format_error(err);
       }
-      return res_buffer;
+      return std::string_view{res_buffer}.substr(offset);
     };
 
     if (auto parse_err{glz::validate_json(json_request)}) {
@@ -84,7 +88,7 @@ class Server {
 
     const auto& handler = it->second;
 
-    const auto result = handler(ctx, request->id, json_request, res_buffer);
+    const auto result = handler(ctx, request->id, json_request, res_buffer, offset);
     if (std::holds_alternative<std::string_view>(result)) {
       return std::get<std::string_view>(result);
     }
@@ -101,7 +105,8 @@ class Server {
   template <auto HandlerFn>
   static std::variant<std::monostate, GenericResponse, std::string_view> Invoke(TContext& ctx, id_t req_id,
                                                                                 std::string_view req_json,
-                                                                                std::string& res_buffer) {
+                                                                                std::string& res_buffer,
+                                                                                std::size_t offset) {
     using Params = typename RequestHandlerTraits<HandlerFn>::Params;
     using Result = typename RequestHandlerTraits<HandlerFn>::Result;
 
@@ -119,13 +124,13 @@ class Server {
       invoke_handler();
       return std::monostate{};
     } else {
-      const std::expected<Result, Error> result = invoke_handler();
+      std::expected<Result, Error> result = invoke_handler();
       if (!result.has_value()) {
         return GenericResponse{.id = std::move(req_id), .error = std::move(result.error())};
       }
 
-      const Response<Result> response{.id = std::move(req_id), .result = std::move(*result)};
-      if (const glz::error_ctx& err = glz::write_json(response, res_buffer); err) [[unlikely]] {
+      const Response<Result> response{.id = req_id, .result = std::move(*result)};
+      if (const glz::error_ctx& err = WriteJson(response, res_buffer, offset); err) [[unlikely]] {
         return GenericResponse{.id = std::move(req_id),
                                .error = Error{
                                    .code = ErrorCode::kInternal,
@@ -134,7 +139,7 @@ class Server {
                                }};
       }
 
-      return res_buffer;
+      return std::string_view{res_buffer}.substr(offset);
     }
   }
 
@@ -142,7 +147,8 @@ class Server {
       TContext&,         // ctx
       id_t,              // req_id
       std::string_view,  // req_json
-      std::string&       // res_buffer
+      std::string&,      // res_buffer
+      std::size_t        // offset
   );
   std::unordered_map<std::string_view, InternalHandlerFn> handlers_;
 };
@@ -97,4 +97,22 @@ TEST(ServerTest, NotificationInvocation) {
   EXPECT_EQ(ctx.x, 6);
 }
 
+TEST(ServerTest, ResponseIsWrittenPastOffset) {
+  const auto handler = [](stubs::Context&, const stubs::Params& params) -> stubs::Result {
+    return {.p = params, .x = 3, .y = 2, .z = 1};
+  };
+
+  stubs::Context ctx{.x = 0};
+  std::string buf;
+
+  Server<stubs::Context> srv;
+  srv.Bind<+handler>("example");
+
+  constexpr std::size_t kOffset = 8;
+  const auto res = srv.Call(ctx, buf, R"({"jsonrpc":"2.0","method":"example","params":{"a":1,"b":2,"c":3},"id":1})",
+                            kOffset);
+  EXPECT_EQ(res, R"({"jsonrpc":"2.0","result":{"p":{"a":1,"b":2,"c":3},"x":3,"y":2,"z":1},"id":1})");
+  EXPECT_EQ(buf.size(), kOffset + res->size());
+}
+
 // TODO: add tests for error cases
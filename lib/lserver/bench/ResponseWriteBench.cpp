@@ -0,0 +1,185 @@
+#include <malloc.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <glaze/json.hpp>
+
+#include <LSProtocol.h>
+#include <vanadium/lib/jsonrpc/Common.h>
+
+#include "vanadium/lib/lserver/Channel.h"
+#include "vanadium/lib/lserver/MessageToken.h"
+#include "vanadium/lib/lserver/Transport.h"
+
+// Heap accounting to report the peak memory needed to put a response on the wire
+
+namespace {
+std::atomic<std::size_t> heap_in_use{0};
+std::atomic<std::size_t> heap_peak{0};
+
+void TrackAllocation(void* p) {
+  const auto in_use = heap_in_use.fetch_add(malloc_usable_size(p), std::memory_order_relaxed) + malloc_usable_size(p);
+  auto peak = heap_peak.load(std::memory_order_relaxed);
+  while (in_use > peak && !heap_peak.compare_exchange_weak(peak, in_use, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+  void* p = std::malloc(size);
+  if (p == nullptr) [[unlikely]] {
+    throw std::bad_alloc{};
+  }
+  TrackAllocation(p);
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  if (p != nullptr) {
+    heap_in_use.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+  }
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  operator delete(p);
+}
+
+//
+
+namespace {
+
+using namespace vanadium;
+
+class NullTransport : public lserver::Transport {
+ public:
+  bool Read(std::span<char>) final {
+    return false;
+  }
+  bool ReadLine(std::span<char>) final {
+    return false;
+  }
+  void Write(std::string_view buf) final {
+    benchmark::DoNotOptimize(buf.data());
+    written_ += buf.size();
+  }
+  void Flush() final {}
+
+  std::size_t written_{0};
+};
+
+using DocumentSymbols = lsp::vector<lsp::DocumentSymbol>;
+
+// Resembles the outline of a large module: groups of definitions with a few fields each
+DocumentSymbols MakeDocumentSymbols(std::size_t n, std::vector<std::string>& strings) {
+  constexpr std::size_t kChildren = 8;
+
+  strings.reserve(n * 2);
+  const auto range = [](std::uint32_t line) {
+    return lsp::Range{.start = {.line = line, .character = 2}, .end = {.line = line + 4, .character = 3}};
+  };
+
+  DocumentSymbols symbols;
+  symbols.reserve(n / kChildren);
+  for (std::uint32_t i = 0; i < n / kChildren; ++i) {
+    auto& group = symbols.emplace_back(lsp::DocumentSymbol{
+        .name = strings.emplace_back(std::format("MyRecordType_{}", i)),
+        .detail = "record",
+        .kind = lsp::SymbolKind::kStruct,
+        .range = range(i * kChildren * 4),
+        .selectionRange = range(i * kChildren * 4),
+        .children = DocumentSymbols{},
+    });
+    for (std::uint32_t j = 0; j < kChildren; ++j) {
+      group.children->emplace_back(lsp::DocumentSymbol{
+          .name = strings.emplace_back(std::format("field_{}", j)),
+          .detail = "charstring",
+          .kind = lsp::SymbolKind::kField,
+          .range = range((i * kChildren + j) * 4),
+          .selectionRange = range((i * kChildren + j) * 4),
+      });
+    }
+  }
+  return symbols;
+}
+
+void ReportMemory(benchmark::State& state, std::size_t baseline, std::size_t bytes) {
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+  state.counters["peak_heap"] =
+      benchmark::Counter(static_cast<double>(heap_peak.load() - baseline), benchmark::Counter::kDefaults,
+                         benchmark::Counter::kIs1024);
+}
+
+// The way it was done before: the result copied into the response, serialized into the buffer,
+// and the header formatted separately
+void BM_DocumentSymbols_Buffered(benchmark::State& state) {
+  std::vector<std::string> strings;
+  const auto symbols = MakeDocumentSymbols(state.range(0), strings);
+
+  NullTransport transport;
+  std::string buf;
+
+  heap_peak = heap_in_use.load();
+  const auto baseline = heap_peak.load();
+
+  for (auto _ : state) {
+    const lib::jsonrpc::Response<DocumentSymbols> response{.id = std::int64_t{1}, .result = symbols};
+    if (glz::write_json(response, buf)) {
+      state.SkipWithError("serialization failed");
+      break;
+    }
+    transport.Write("Content-Length: ");
+    transport.Write(std::to_string(buf.size()));
+    transport.Write("\r\n\r\n");
+    transport.Write(buf);
+    transport.Flush();
+  }
+
+  ReportMemory(state, baseline, buf.size());
+}
+BENCHMARK(BM_DocumentSymbols_Buffered)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 17);
+
+// The result is moved into the response and serialized into the pooled token behind the reserved header space
+void BM_DocumentSymbols_Streamed(benchmark::State& state) {
+  std::vector<std::string> strings;
+  auto symbols = MakeDocumentSymbols(state.range(0), strings);
+
+  NullTransport transport;
+  lserver::Channel channel(transport, 1);
+  lserver::TokenPool pool(2);
+  std::size_t size_hint{0};
+  std::size_t written{0};
+
+  heap_peak = heap_in_use.load();
+  const auto baseline = heap_peak.load();
+
+  for (auto _ : state) {
+    auto token = pool.Acquire(size_hint);
+    token->body_offset = lserver::MessageToken::kHeaderReserve;
+
+    lib::jsonrpc::Response<DocumentSymbols> response{.id = std::int64_t{1}, .result = std::move(symbols)};
+    if (lib::jsonrpc::WriteJson(response, token->buf, token->body_offset)) {
+      state.SkipWithError("serialization failed");
+      break;
+    }
+    symbols = std::move(*response.result);
+
+    written = token->Body().size();
+    size_hint = written;
+
+    channel.Enqueue(std::move(token));
+    channel.Write();
+  }
+
+  ReportMemory(state, baseline, written);
+}
+BENCHMARK(BM_DocumentSymbols_Streamed)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 17);
+
+}  // namespace
@@ -12,12 +12,16 @@ class Channel {
   Channel(Transport& transport, std::size_t tokens) : pool_(tokens), transport_(&transport) {}
   ~Channel() {}
 
-  void Read();
-  void Write();
+  // Returns false once the transport is exhausted, after which Poll() yields an empty token
+  bool Read();
+  // Returns false once the channel is closed and everything enqueued before has been written
+  bool Write();
 
   void Enqueue(PooledMessageToken&&);
+  void Close();
 
   PooledMessageToken Poll();
+  void Interrupt();
 
  private:
   TokenPool pool_;
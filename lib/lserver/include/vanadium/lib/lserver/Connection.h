@@ -1,13 +1,14 @@
 #pragma once
 
-#include <condition_variable>
 #include <cstddef>
 #include <expected>
+#include <functional>
+#include <mutex>
+#include <string_view>
 #include <type_traits>
+#include <unordered_map>
 
 #include <glaze/json.hpp>
-#include <oneapi/tbb/concurrent_unordered_map.h>
-#include <oneapi/tbb/spin_rw_mutex.h>
 #include <oneapi/tbb/task_arena.h>
 #include <oneapi/tbb/task_group.h>
 
@@ -15,25 +16,28 @@
 
 #include "vanadium/lib/lserver/Channel.h"
 #include "vanadium/lib/lserver/MessageToken.h"
+#include "vanadium/lib/lserver/OrderingGate.h"
 #include "vanadium/lib/lserver/Transport.h"
 
 namespace vanadium::lserver {
 
-// template <typename T>
-struct NoAwaitResponse {};
-
 class Connection {
  public:
   using HandlerFn = std::function<void(Connection&, PooledMessageToken&&)>;
+  // Decides how the message may be scheduled relative to its neighbours, all messages are exclusive if unset
+  using ClassifierFn = std::function<MessageOrdering(std::string_view)>;
   using rpc_id_t = std::uint32_t;
 
-  Connection(HandlerFn handler, Transport& transport, std::size_t concurrency, std::size_t backlog);
+  Connection(HandlerFn handler, Transport& transport, std::size_t concurrency, std::size_t backlog,
+             ClassifierFn classifier = nullptr);
 
   Connection(const Connection&) = delete;
   Connection(Connection&&) = delete;
   Connection& operator=(const Connection&) = delete;
   Connection& operator=(Connection&&) = delete;
 
+  // Serves the transport until it is exhausted or the connection is stopped,
+  // returns after all the received messages have been handled and the responses have been written
   void Listen();
   void Stop();
 
@@ -44,10 +48,14 @@ class Connection {
     return backlog_;
   }
 
+  // Runs the task on one of the workers as an exclusive message, i.e. after everything received before it
+  // and before anything received after it. May be called from any thread
+  void Post(std::function<void()> task);
+
   //
 
-  PooledMessageToken AcquireToken() {
-    return pool_.Acquire();
+  PooledMessageToken AcquireToken(std::size_t size_hint = 0) {
+    return pool_.Acquire(size_hint);
   }
 
   //
@@ -64,61 +72,72 @@ class Connection {
     };
 
     auto token = AcquireToken();
-    if (auto err = glz::write_json(req, token->buf)) {
+    token->body_offset = MessageToken::kHeaderReserve;
+    if (auto err = lib::jsonrpc::WriteJson(req, token->buf, token->body_offset)) {
       std::abort();  // TODO
     }
     Send(std::move(token));
   }
 
-  template <glz::string_literal Method, typename Result, typename Params>
-  std::expected<Result, lib::jsonrpc::Error> Request(Params&& params) {
-    const auto assign_wait_token = [&](WaitToken* tokenptr) {
-      std::unique_lock l(channel_read_mutex_);
-      pending_outbound_requests_[tbb::this_task_arena::current_thread_index()] = tokenptr;
-    };
-    const auto free_wait_token = [&] {
-      assign_wait_token(nullptr);
-    };
-
-    //
+  template <typename Result>
+  using ResponseHandlerFn = std::function<void(std::expected<Result, lib::jsonrpc::Error>&&)>;
 
+  // Sends the request and returns immediately, the handler is invoked on one of the workers
+  // (as an exclusive message, see MessageOrdering) once the response arrives.
+  // The response is ignored if no handler is given.
+  template <glz::string_literal Method, typename Result, typename Params>
+  void Request(Params&& params, ResponseHandlerFn<Result> on_response = nullptr) {
     const auto id = outbound_id_++;
-    const auto send_req = [&] {
-      return SendRequest<Method>(id, std::forward<Params>(params));
-    };
 
-    if constexpr (std::is_same_v<Result, NoAwaitResponse>) {
-      if (auto err = send_req(); err) [[unlikely]] {
-        return std::unexpected{*err};
-      }
-      return {};
+    if (on_response) {
+      std::lock_guard l(pending_responses_mutex_);
+      pending_responses_.emplace(id, [on_response](PooledMessageToken&& token) mutable {
+        on_response(ReadResponse<Result>(token));
+      });
     }
 
-    WaitToken wait_token{.awaited_id = id};
-    assign_wait_token(&wait_token);
-
-    if (auto err = send_req(); err) [[unlikely]] {
-      free_wait_token();
-      return std::unexpected{*err};
+    if (auto err = SendRequest<Method>(id, std::forward<Params>(params)); err) [[unlikely]] {
+      if (on_response) {
+        {
+          std::lock_guard l(pending_responses_mutex_);
+          pending_responses_.erase(id);
+        }
+        on_response(std::unexpected{*err});
+      }
     }
+  }
 
-    {
-      std::unique_lock lock(pending_outbound_requests_mutex_);
-      pending_outbound_requests_cv_.wait(lock, [&] {
-        return wait_token.satisfied.load(std::memory_order_acquire);
-      });
+ private:
+  template <glz::string_literal Method, typename Params>
+  std::optional<lib::jsonrpc::Error> SendRequest(rpc_id_t id, Params&& params) {
+    const lib::jsonrpc::Request<Params> req{
+        .id = id,
+        .method = Method,
+        .params = std::forward<Params>(params),
+    };
+
+    auto req_token = AcquireToken();
+    req_token->body_offset = MessageToken::kHeaderReserve;
+    if (auto err = lib::jsonrpc::WriteJson(req, req_token->buf, req_token->body_offset)) [[unlikely]] {
+      return lib::jsonrpc::Error{
+          .code = lib::jsonrpc::ErrorCode::kInvalidParams,
+          .data = glz::format_error(err, req_token->buf),
+      };
     }
-    free_wait_token();
+    Send(std::move(req_token));
 
-    auto res_token = std::move(*wait_token.response);
+    return std::nullopt;
+  }
 
+  template <typename Result>
+  static std::expected<Result, lib::jsonrpc::Error> ReadResponse(PooledMessageToken& token) {
     lib::jsonrpc::Response<Result> res;
-    if (glz::error_ctx err = glz::read_json<>(res, res_token->buf)) [[unlikely]] {
+    if (glz::error_ctx err = glz::read_json<>(res, token->buf)) [[unlikely]] {
       // TODO: it does not seem correct to return jsonrpc::Error from the point of the client
       //       as it would think it was sent by the server and not produced internally
       return std::unexpected{lib::jsonrpc::Error{
           .code = lib::jsonrpc::ErrorCode::kParseError,
-          .data = glz::format_error(err, res_token->buf),
+          .data = glz::format_error(err, token->buf),
       }};
     }
 
@@ -135,41 +154,25 @@ class Connection {
             .data = "result is missing from response",
         }};
       }
-      return *res.result;
+      return std::move(*res.result);
     }
   }
 
- private:
-  template <glz::string_literal Method, typename Params>
-  std::optional<lib::jsonrpc::Error> SendRequest(rpc_id_t id, Params&& params) {
-    const lib::jsonrpc::Request<Params> req{
-        .id = id,
-        .method = Method,
-        .params = std::forward<Params>(params),
-    };
-
-    auto req_token = AcquireToken();
-    if (auto err = glz::write_json(req, req_token->buf)) [[unlikely]] {
-      return lib::jsonrpc::Error{
-          .code = lib::jsonrpc::ErrorCode::kInvalidParams,
-          .data = glz::format_error(err, req_token->buf),
-      };
-    }
-    Send(std::move(req_token));
+  using ContinuationFn = std::function<void(PooledMessageToken&&)>;
 
-    return std::nullopt;
-  }
+  struct InboundMessage {
+    PooledMessageToken token;
+    OrderingGate::Ticket ticket;
+    ContinuationFn continuation{nullptr};  // set for responses to our requests
+  };
 
-  [[nodiscard]] bool AwaitsResponse() const noexcept;
-  [[nodiscard]] std::optional<PooledMessageToken> MaybeRouteOutboundRequestResponse(PooledMessageToken&& token);
+  [[nodiscard]] ContinuationFn TakeResponseHandler(PooledMessageToken& token);
 
-  struct WaitToken {
-    rpc_id_t awaited_id;
-    std::optional<PooledMessageToken> response{std::nullopt};
-    std::atomic<bool> satisfied{false};
-  };
+  void Dispatch(PooledMessageToken&& token, ContinuationFn&& continuation);
+  void Serve(InboundMessage&& message);
 
   HandlerFn handler_;
+  ClassifierFn classifier_;
 
   Channel channel_;
 
@@ -180,15 +183,13 @@ class Connection {
 
   std::atomic<bool> is_running_;
 
-  // It suspends incoming message routing during initiating a Server->Client request
-  tbb::speculative_spin_rw_mutex channel_read_mutex_;
-
-  tbb::concurrent_bounded_queue<PooledMessageToken> inbound_requests_queue_;
+  tbb::concurrent_bounded_queue<InboundMessage> inbound_requests_queue_;
+  OrderingGate ordering_gate_;
+  std::mutex dispatch_mutex_;  // the tickets are queued in the order they are issued
 
   std::atomic<rpc_id_t> outbound_id_{1};
-  std::vector<WaitToken*> pending_outbound_requests_;  // <-- should be protected by exclusive channel_read_mutex_
-  std::mutex pending_outbound_requests_mutex_;
-  std::condition_variable pending_outbound_requests_cv_;
+  std::unordered_map<rpc_id_t, ContinuationFn> pending_responses_;
+  std::mutex pending_responses_mutex_;
 
   TokenPool pool_;
 };
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -10,7 +17,63 @@ namespace vanadium::lserver {
 struct MessageToken {
   using buffer_t = std::string;
 
+  // Enough to fit the "Content-Length: <size>\r\n\r\n" header in front of the body
+  static constexpr std::size_t kHeaderReserve = 32;
+
   buffer_t buf;
+  std::size_t body_offset{0};  // buf[0, body_offset) is reserved for the header
+
+  [[nodiscard]] std::string_view Body() const noexcept {
+    return std::string_view{buf}.substr(body_offset);
+  }
+};
+
+// Keeps large message buffers returned to the token pool, grouped by power-of-two size classes,
+// so that a single huge message does not pin its memory in a token forever,
+// while the successive large messages do not have to grow their buffers from scratch.
+class BufferPool {
+ public:
+  static constexpr std::size_t kSmallBufferLimit = 64 * 1024;  // smaller buffers stay with their tokens
+  static constexpr std::size_t kSizeClasses = 12;              // up to 128 MiB
+  static constexpr std::size_t kRetainedPerClass = 2;
+
+  void Put(std::string&& buf) {
+    const auto size_class = SizeClassOf(buf.capacity());
+    if (size_class >= kSizeClasses) {
+      return;
+    }
+    std::lock_guard l(mutex_);
+    auto& retained = classes_[size_class];
+    if (retained.size() < kRetainedPerClass) {
+      retained.emplace_back(std::move(buf));
+    }
+  }
+
+  std::optional<std::string> Take(std::size_t min_capacity) {
+    std::lock_guard l(mutex_);
+    for (auto size_class = SizeClassOf(min_capacity); size_class < kSizeClasses; ++size_class) {
+      auto& retained = classes_[size_class];
+      for (auto it = retained.begin(); it != retained.end(); ++it) {
+        if (it->capacity() >= min_capacity) {
+          auto buf = std::move(*it);
+          retained.erase(it);
+          return buf;
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
+ private:
+  static constexpr std::size_t SizeClassOf(std::size_t capacity) noexcept {
+    if (capacity <= kSmallBufferLimit) {
+      return 0;
+    }
+    return std::bit_width((capacity - 1) / kSmallBufferLimit);
+  }
+
+  std::mutex mutex_;
+  std::array<std::vector<std::string>, kSizeClasses> classes_;
 };
 
 class TokenPool;
@@ -29,6 +92,10 @@ class PooledMessageToken {
     return token_;
   }
 
+  explicit operator bool() const noexcept {
+    return token_ != nullptr;
+  }
+
   PooledMessageToken(const PooledMessageToken&) = delete;
   PooledMessageToken& operator=(const PooledMessageToken&) = delete;
 
@@ -53,16 +120,27 @@ class TokenPool {
     }
   }
 
-  PooledMessageToken Acquire() {
+  // size_hint is the expected size of the message, if known
+  PooledMessageToken Acquire(std::size_t size_hint = 0) {
     PooledMessageToken result;
     pool_.pop(result);
 
     result->buf.clear();
+    result->body_offset = 0;
+
+    if (size_hint > BufferPool::kSmallBufferLimit && size_hint > result->buf.capacity()) {
+      if (auto buf = buffers_.Take(size_hint)) {
+        result->buf = std::move(*buf);
+      }
+    }
 
     return result;
   }
 
   void Release(PooledMessageToken&& token) {
+    if (token->buf.capacity() > BufferPool::kSmallBufferLimit) [[unlikely]] {
+      buffers_.Put(std::exchange(token->buf, {}));
+    }
     pool_.emplace(std::move(token));
   }
 
@@ -72,6 +150,7 @@ class TokenPool {
 
  private:
   std::vector<MessageToken> storage_;
+  BufferPool buffers_;
   tbb::concurrent_bounded_queue<PooledMessageToken> pool_;
 };
 
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+
+namespace vanadium::lserver {
+
+enum class MessageOrdering : std::uint8_t {
+  kConcurrent,  // may be handled alongside other concurrent messages
+  kExclusive,   // waits for every message received before it, and blocks every message received after it
+};
+
+// Admits the handling of messages in the order they were received from the transport.
+//
+// Tickets must be issued in the arrival order, but messages may be picked up by the workers in any order:
+// concurrent messages only wait for the closest preceding exclusive message to finish, while exclusive
+// messages wait for everything received before them to finish.
+class OrderingGate {
+ public:
+  using seq_t = std::uint64_t;
+
+  struct Ticket {
+    seq_t seq;
+    seq_t barrier;  // all tickets with seq below it should be released before entering
+  };
+
+  Ticket Issue(MessageOrdering ordering);
+
+  void Enter(const Ticket& ticket);
+  void Leave(const Ticket& ticket);
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+  seq_t next_seq_{0};
+  seq_t exclusive_barrier_{0};  // seq after the last issued exclusive ticket
+
+  seq_t released_prefix_{0};               // all tickets with seq below it have been released
+  std::set<seq_t> released_out_of_order_;  // released tickets with seq above released_prefix_
+};
+
+}  // namespace vanadium::lserver
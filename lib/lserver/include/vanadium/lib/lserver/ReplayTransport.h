@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "vanadium/lib/lserver/SessionTrace.h"
+#include "vanadium/lib/lserver/Transport.h"
+
+namespace vanadium::lserver {
+
+struct ReplayOptions {
+  double speed{1.0};  // relative to the recorded pace, 0 sends the messages back to back
+  // How long to wait for the outstanding responses once the session is over, some requests may be never answered
+  std::chrono::milliseconds drain_timeout{10'000};
+};
+
+// Plays the client side of a recorded session and measures how long the server takes to answer each request.
+// The recorded responses of the client are not played, the requests of the server are answered with null instead.
+// The session is ended right before "exit", as the server would terminate the process on it,
+// and once the requests have been answered.
+class ReplayTransport : public Transport {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  struct Sample {
+    std::string method;
+    std::chrono::microseconds latency;  // from the delivery of the request to the flush of the response
+    bool failed;                        // answered with an error, e.g. cancelled
+  };
+
+  struct Counters {
+    std::size_t messages_in{0};
+    std::size_t messages_out{0};
+    std::size_t bytes_in{0};
+    std::size_t bytes_out{0};
+  };
+
+  explicit ReplayTransport(std::span<const TraceMessage> trace, ReplayOptions opts = {});
+
+  bool Read(std::span<char> chunk) final;
+  bool ReadLine(std::span<char> chunk) final;
+  void Write(std::string_view buf) final;
+  void Flush() final;
+
+  // The accessors are meant to be used once the connection has stopped listening
+
+  [[nodiscard]] const std::vector<Sample>& Samples() const noexcept {
+    return samples_;
+  }
+  [[nodiscard]] std::size_t Unanswered() const noexcept {
+    return in_flight_.size();
+  }
+  [[nodiscard]] const Counters& GetCounters() const noexcept {
+    return counters_;
+  }
+  // From the delivery of the first message to the last flush
+  [[nodiscard]] std::chrono::microseconds Elapsed() const noexcept {
+    return last_flush_ > begin_ ? std::chrono::duration_cast<std::chrono::microseconds>(last_flush_ - begin_)
+                                : std::chrono::microseconds{0};
+  }
+
+ private:
+  struct InFlightRequest {
+    std::string method;
+    clock::time_point delivered_at;
+  };
+
+  // Picks the next message to deliver, waits for it to become due, returns false once the session is over
+  bool Advance(std::unique_lock<std::mutex>& lock);
+
+  std::span<const TraceMessage> trace_;
+  ReplayOptions opts_;
+
+  std::size_t cursor_{0};
+  std::chrono::microseconds origin_ts_{0};  // of the first inbound message
+
+  std::string current_;     // being delivered
+  std::string current_id_;  // empty unless the current message is a request
+  std::string current_method_;
+  bool separator_expected_{false};
+
+  std::string pending_;  // of the outbound message until it is flushed
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::string> injected_;  // responses to the requests of the server
+  std::unordered_map<std::string, InFlightRequest> in_flight_;
+
+  std::vector<Sample> samples_;
+  Counters counters_;
+  clock::time_point begin_;
+  clock::time_point last_flush_;
+};
+
+}  // namespace vanadium::lserver
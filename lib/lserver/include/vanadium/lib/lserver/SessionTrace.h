@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <fstream>
+#include <iosfwd>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "vanadium/lib/lserver/Transport.h"
+
+namespace vanadium::lserver {
+
+enum class TraceDirection : std::uint8_t {
+  kInbound,   // from the client
+  kOutbound,  // from the server
+};
+
+struct TraceMessage {
+  std::chrono::microseconds ts;  // since the beginning of the session
+  TraceDirection direction;
+  std::string body;
+};
+
+// A record per message: "<ts_us> <in|out> <body size>\n<body>\n",
+// the bodies are kept as they went over the wire, so they may span multiple lines
+void WriteTraceMessage(std::ostream&, const TraceMessage&);
+[[nodiscard]] std::expected<std::vector<TraceMessage>, std::string> ReadSessionTrace(std::istream&);
+
+// Records both directions of the conversation going through the base transport, see ReplayTransport
+class RecordingTransport : public Transport {
+ public:
+  RecordingTransport(const char* filename, Transport& base);
+
+  bool Read(std::span<char> chunk) final;
+  bool ReadLine(std::span<char> chunk) final;
+  void Write(std::string_view buf) final;
+  void Flush() final;
+
+ private:
+  void Record(TraceDirection direction, std::string_view body);
+
+  Transport& base_;
+  std::chrono::steady_clock::time_point begin_;
+
+  std::mutex mutex_;  // the messages are read and written on different threads
+  std::ofstream trace_;
+
+  bool separator_expected_{false};  // the header has been read, the body follows the separator, see Channel::Read
+  std::string pending_;             // of the outbound message until it is flushed
+};
+
+}  // namespace vanadium::lserver
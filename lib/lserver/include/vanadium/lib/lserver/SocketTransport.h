@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "vanadium/lib/lserver/Transport.h"
+
+namespace vanadium::lserver {
+
+// Stream over a connected Unix domain socket, the socket is closed upon destruction
+class SocketTransport final : public Transport {
+ public:
+  explicit SocketTransport(int fd) : fd_(fd) {}
+  ~SocketTransport() final;
+
+  SocketTransport(const SocketTransport&) = delete;
+  SocketTransport& operator=(const SocketTransport&) = delete;
+
+  bool Read(std::span<char> chunk) final;
+  bool ReadLine(std::span<char> chunk) final;
+  void Write(std::string_view) final;
+  void Flush() final;
+
+  // Fails if nobody listens on the path
+  [[nodiscard]] static std::expected<std::unique_ptr<SocketTransport>, std::error_code> Connect(
+      const std::string& path);
+
+ private:
+  bool Fill();
+
+  int fd_;
+
+  std::array<char, 4096> in_;
+  std::size_t in_begin_{0};
+  std::size_t in_end_{0};
+
+  std::string out_;
+};
+
+class SocketListener {
+ public:
+  // A socket file left behind by a process that is gone is replaced,
+  // while the one being listened on by another process makes it fail
+  [[nodiscard]] static std::expected<std::unique_ptr<SocketListener>, std::error_code> Listen(
+      const std::string& path);
+
+  ~SocketListener();  // the socket file is removed as well
+
+  SocketListener(const SocketListener&) = delete;
+  SocketListener& operator=(const SocketListener&) = delete;
+
+  // Blocks until a client connects, returns nullptr if the socket has failed
+  [[nodiscard]] std::unique_ptr<SocketTransport> Accept();
+
+ private:
+  SocketListener(int fd, std::string path) : fd_(fd), path_(std::move(path)) {}
+
+  int fd_;
+  std::string path_;
+};
+
+}  // namespace vanadium::lserver
@@ -1,54 +1,115 @@
 #include "vanadium/lib/lserver/Channel.h"
 
+#include <algorithm>
+#include <array>
 #include <charconv>
+#include <cstring>
+#include <format>
+#include <optional>
 #include <string_view>
+#include <system_error>
 
 #include "vanadium/lib/lserver/MessageToken.h"
 
 namespace vanadium::lserver {
 
-void Channel::Read() {
+namespace {
+constexpr std::size_t kMaxMessageSize = 256 << 20;
+
+// The size given by the "Content-Length: <size>\r\n" line, which is the only header expected
+std::optional<std::size_t> ParseContentLength(std::string_view line) {
+  constexpr std::string_view kName = "Content-Length:";
+  if (!line.starts_with(kName) || !line.ends_with("\r\n")) {
+    return std::nullopt;
+  }
+  line.remove_prefix(kName.size());
+  line.remove_prefix(std::min(line.find_first_not_of(' '), line.size()));
+  line.remove_suffix(2);
+
+  std::size_t size{0};
+  const auto [end, ec] = std::from_chars(line.data(), line.data() + line.size(), size);
+  if (ec != std::errc{} || end != line.data() + line.size() || size == 0 || size > kMaxMessageSize) {
+    return std::nullopt;
+  }
+  return size;
+}
+}  // namespace
+
+bool Channel::Read() {
   auto token = pool_.Acquire();
   auto& buf = token->buf;
 
   buf.resize(128);
-  transport_->ReadLine(buf);
+  if (!transport_->ReadLine(buf)) [[unlikely]] {
+    Interrupt();
+    return false;
+  }
 
-  std::size_t message_size;
-  {
-    std::string_view sbuf{buf.data(), buf.size()};
-    const auto separator_pos = sbuf.find(':');
-    const auto length_fragment = sbuf.substr(separator_pos + 2, sbuf.length() - separator_pos - 2);
-    std::from_chars(length_fragment.begin(), length_fragment.end(), message_size);
+  // the stream cannot be resynchronized after a malformed header, so the connection is given up
+  const auto message_size = ParseContentLength({buf.data(), ::strnlen(buf.data(), buf.size())});
+  if (!message_size) [[unlikely]] {
+    Interrupt();
+    return false;
   }
 
-  transport_->Read({buf.data(), buf.data() + 2});  // \r\n
+  if (!transport_->Read({buf.data(), buf.data() + 2})) [[unlikely]] {  // \r\n
+    Interrupt();
+    return false;
+  }
 
-  buf.resize(message_size);
-  transport_->Read(buf);
+  buf.resize(*message_size);
+  if (!transport_->Read(buf)) [[unlikely]] {
+    Interrupt();
+    return false;
+  }
 
   ready_.emplace(std::move(token));
+  return true;
 }
 
-void Channel::Write() {
+bool Channel::Write() {
   PooledMessageToken token;
   out_queue_.pop(token);
+  if (!token) [[unlikely]] {
+    return false;
+  }
+
+  const auto body = token->Body();
+
+  std::array<char, MessageToken::kHeaderReserve> header_buf;
+  const auto header_size = static_cast<std::size_t>(
+      std::format_to_n(header_buf.data(), header_buf.size(), "Content-Length: {}\r\n\r\n", body.size()).size);
 
-  transport_->Write("Content-Length: ");
-  transport_->Write(std::to_string(token->buf.size()));
-  transport_->Write("\r\n\r\n");
-  transport_->Write(std::string_view{token->buf.data(), token->buf.size()});
+  if (token->body_offset >= header_size) [[likely]] {
+    // the header is put right in front of the body, so the message goes out with a single write
+    char* message_begin = token->buf.data() + token->body_offset - header_size;
+    std::memcpy(message_begin, header_buf.data(), header_size);
+    transport_->Write(std::string_view{message_begin, header_size + body.size()});
+  } else {
+    transport_->Write(std::string_view{header_buf.data(), header_size});
+    transport_->Write(body);
+  }
   transport_->Flush();
+
+  return true;
 }
 
 void Channel::Enqueue(PooledMessageToken&& token) {
   out_queue_.emplace(std::move(token));
 }
 
+void Channel::Close() {
+  out_queue_.emplace();
+}
+
 PooledMessageToken Channel::Poll() {
   PooledMessageToken token;
   ready_.pop(token);
   return token;
 }
 
+void Channel::Interrupt() {
+  ready_.emplace();
+}
+
 }  // namespace vanadium::lserver
@@ -1,8 +1,8 @@
 #include "vanadium/lib/lserver/Connection.h"
 
-#include <algorithm>
-#include <condition_variable>
 #include <cstddef>
+#include <mutex>
+#include <string_view>
 
 #include "vanadium/lib/lserver/Channel.h"
 #include "vanadium/lib/lserver/MessageToken.h"
@@ -10,98 +10,127 @@
 
 namespace vanadium::lserver {
 
-Connection::Connection(HandlerFn handler, Transport& transport, std::size_t concurrency, std::size_t backlog)
+Connection::Connection(HandlerFn handler, Transport& transport, std::size_t concurrency, std::size_t backlog,
+                       ClassifierFn classifier)
     : handler_(std::move(handler)),
+      classifier_(std::move(classifier)),
       channel_(transport, concurrency * backlog * 2),
       backlog_(backlog),
       task_arena_(kServiceWorkerThreads + concurrency),
-      pending_outbound_requests_(concurrency, nullptr),
       pool_(GetConcurrency() * GetBacklog()) {}
 
 void Connection::Listen() {
   is_running_ = true;
 
+  const auto concurrency = GetConcurrency();
+  std::atomic<std::size_t> active_workers{concurrency};
+
   task_arena_.execute([&] {
     wg_.run([&] {
-      while (is_running_.load()) {
-        channel_.Read();
+      while (is_running_.load() && channel_.Read()) {
       }
     });
     wg_.run([&] {
-      while (is_running_.load()) {
-        channel_.Write();
+      while (channel_.Write()) {
       }
     });
 
-    const auto concurrency = GetConcurrency();
     for (std::size_t i = 0; i < concurrency; ++i) {
       wg_.run([&] {
-        while (is_running_.load()) {
-          PooledMessageToken token;
-          inbound_requests_queue_.pop(token);
-          handler_(*this, std::move(token));
+        while (true) {
+          InboundMessage message;
+          inbound_requests_queue_.pop(message);
+          if (!message.token) {
+            break;
+          }
+          Serve(std::move(message));
+        }
+        if (active_workers.fetch_sub(1) == 1) {
+          channel_.Close();  // the last worker is gone, no more responses will be produced
         }
       });
     }
   });
 
-  // TODO: potential deadlock - if all workers are waiting for outbound request response,
-  //       and the backlog is full, connection will deadlock
   while (is_running_.load()) {
     auto token = channel_.Poll();
-    {
-      std::shared_lock l(channel_read_mutex_);
-      if (AwaitsResponse()) [[unlikely]] {
-        auto inbound_request = MaybeRouteOutboundRequestResponse(std::move(token));
-        if (!inbound_request) {
-          continue;
-        }
-        token = std::move(*inbound_request);
-      }
+    if (!token) [[unlikely]] {
+      break;
     }
-    inbound_requests_queue_.emplace(std::move(token));
+    auto continuation = TakeResponseHandler(token);
+    Dispatch(std::move(token), std::move(continuation));
+  }
+
+  for (std::size_t i = 0; i < concurrency; ++i) {
+    inbound_requests_queue_.emplace();
   }
+  task_arena_.execute([&] {
+    wg_.wait();
+  });
+
+  is_running_ = false;
 }
 
 void Connection::Stop() {
   is_running_ = false;
-  wg_.cancel();
+  channel_.Interrupt();
 }
 
-bool Connection::AwaitsResponse() const noexcept {
-  return std::ranges::any_of(pending_outbound_requests_, [&](const auto* p) {
-    return p != nullptr;
+void Connection::Dispatch(PooledMessageToken&& token, ContinuationFn&& continuation) {
+  // continuations are exclusive, as nothing is known about the data they touch
+  const auto ordering = (classifier_ && !continuation)
+                            ? classifier_(std::string_view{token->buf.data(), token->buf.size()})
+                            : MessageOrdering::kExclusive;
+  std::lock_guard l(dispatch_mutex_);
+  inbound_requests_queue_.emplace(InboundMessage{
+      .token = std::move(token),
+      .ticket = ordering_gate_.Issue(ordering),
+      .continuation = std::move(continuation),
   });
 }
 
-std::optional<PooledMessageToken> Connection::MaybeRouteOutboundRequestResponse(PooledMessageToken&& token) {
-  const auto result = glz::get_as_json<glz::raw_json_view, "/result">(token->buf);
-  if (!result.has_value()) {
-    return token;
+void Connection::Post(std::function<void()> task) {
+  if (!is_running_.load()) [[unlikely]] {
+    return;
   }
+  Dispatch(AcquireToken(), [task = std::move(task)](PooledMessageToken&&) {
+    task();
+  });
+}
 
-  const auto id = glz::get_as_json<rpc_id_t, "/id">(token->buf);
-  if (!id.has_value()) {
-    // invalid response, todo: check
-    std::abort();
-    return std::nullopt;
+void Connection::Serve(InboundMessage&& message) {
+  ordering_gate_.Enter(message.ticket);
+  if (message.continuation) [[unlikely]] {
+    message.continuation(std::move(message.token));
+  } else {
+    handler_(*this, std::move(message.token));
   }
+  ordering_gate_.Leave(message.ticket);
+}
 
-  for (auto& pending : pending_outbound_requests_) {
-    if (!pending || pending->awaited_id != *id) {
-      continue;
+Connection::ContinuationFn Connection::TakeResponseHandler(PooledMessageToken& token) {
+  {
+    std::lock_guard l(pending_responses_mutex_);
+    if (pending_responses_.empty()) [[likely]] {
+      return nullptr;
     }
-    pending->response = std::move(token);
-    pending->satisfied.store(true, std::memory_order_release);
-    pending = nullptr;
-    {
-      std::lock_guard lock(pending_outbound_requests_mutex_);
-      pending_outbound_requests_cv_.notify_all();
-    }
-    break;
   }
 
-  return std::nullopt;
+  if (glz::get_as_json<std::string_view, "/method">(token->buf)) {
+    return nullptr;  // it is a request or a notification
+  }
+
+  const auto id = glz::get_as_json<rpc_id_t, "/id">(token->buf);
+  if (!id) [[unlikely]] {
+    return nullptr;
+  }
+
+  std::lock_guard l(pending_responses_mutex_);
+  auto node = pending_responses_.extract(*id);
+  if (node.empty()) {
+    return nullptr;
+  }
+  return std::move(node.mapped());
 }
 
 }  // namespace vanadium::lserver
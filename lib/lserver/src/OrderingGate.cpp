@@ -0,0 +1,42 @@
+#include "vanadium/lib/lserver/OrderingGate.h"
+
+#include <mutex>
+
+namespace vanadium::lserver {
+
+OrderingGate::Ticket OrderingGate::Issue(MessageOrdering ordering) {
+  std::lock_guard l(mutex_);
+
+  const auto seq = next_seq_++;
+  if (ordering == MessageOrdering::kExclusive) {
+    exclusive_barrier_ = seq + 1;
+    return {.seq = seq, .barrier = seq};
+  }
+  return {.seq = seq, .barrier = exclusive_barrier_};
+}
+
+void OrderingGate::Enter(const Ticket& ticket) {
+  std::unique_lock l(mutex_);
+  cv_.wait(l, [&] {
+    return released_prefix_ >= ticket.barrier;
+  });
+}
+
+void OrderingGate::Leave(const Ticket& ticket) {
+  {
+    std::lock_guard l(mutex_);
+    if (ticket.seq != released_prefix_) {
+      released_out_of_order_.emplace(ticket.seq);
+      return;
+    }
+
+    ++released_prefix_;
+    while (!released_out_of_order_.empty() && *released_out_of_order_.begin() == released_prefix_) {
+      released_out_of_order_.erase(released_out_of_order_.begin());
+      ++released_prefix_;
+    }
+  }
+  cv_.notify_all();
+}
+
+}  // namespace vanadium::lserver
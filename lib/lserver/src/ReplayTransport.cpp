@@ -0,0 +1,147 @@
+#include "vanadium/lib/lserver/ReplayTransport.h"
+
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <glaze/json.hpp>
+
+namespace vanadium::lserver {
+
+ReplayTransport::ReplayTransport(std::span<const TraceMessage> trace, ReplayOptions opts)
+    : trace_(trace), opts_(opts) {
+  for (const auto& message : trace_) {
+    if (message.direction == TraceDirection::kInbound) {
+      origin_ts_ = message.ts;
+      break;
+    }
+  }
+}
+
+bool ReplayTransport::Advance(std::unique_lock<std::mutex>& lock) {
+  while (true) {
+    if (!injected_.empty()) {
+      current_ = std::move(injected_.front());
+      injected_.pop_front();
+      current_id_.clear();
+      return true;
+    }
+
+    if (cursor_ == trace_.size()) {
+      // the server may need the answers to its own requests to answer the outstanding ones
+      if (cv_.wait_for(lock, opts_.drain_timeout, [&] {
+            return !injected_.empty() || in_flight_.empty();
+          }) &&
+          !injected_.empty()) {
+        continue;
+      }
+      return false;
+    }
+    const auto& message = trace_[cursor_];
+
+    const auto method = glz::get_as_json<std::string_view, "/method">(message.body);
+    if (message.direction != TraceDirection::kInbound || !method) {
+      ++cursor_;  // the server is replaying its side by itself, and the client responses are synthesized
+      continue;
+    }
+    if (*method == "exit") {
+      cursor_ = trace_.size();
+      continue;
+    }
+
+    if (opts_.speed > 0) {
+      const auto due = begin_ + std::chrono::duration_cast<clock::duration>((message.ts - origin_ts_) / opts_.speed);
+      if (cv_.wait_until(lock, due, [&] {
+            return !injected_.empty();
+          })) {
+        continue;  // the server is waiting for an answer, it is not to be delayed
+      }
+    }
+
+    current_ = message.body;
+    current_method_ = *method;
+    if (const auto id = glz::get_as_json<glz::raw_json_view, "/id">(message.body); id) {
+      current_id_ = id->str;
+    } else {
+      current_id_.clear();
+    }
+    ++cursor_;
+    return true;
+  }
+}
+
+bool ReplayTransport::ReadLine(std::span<char> chunk) {
+  std::unique_lock l(mutex_);
+  if (begin_ == clock::time_point{}) {
+    begin_ = clock::now();
+  }
+  if (!Advance(l)) {
+    return false;
+  }
+
+  const auto header = std::format_to_n(chunk.data(), chunk.size() - 1, "Content-Length: {}\r\n", current_.size());
+  *header.out = '\0';
+  separator_expected_ = true;
+  return true;
+}
+
+bool ReplayTransport::Read(std::span<char> chunk) {
+  if (separator_expected_) {
+    std::memcpy(chunk.data(), "\r\n", 2);
+    separator_expected_ = false;
+    return true;
+  }
+  std::memcpy(chunk.data(), current_.data(), chunk.size());
+
+  std::lock_guard l(mutex_);
+  ++counters_.messages_in;
+  counters_.bytes_in += current_.size();
+  if (!current_id_.empty()) {
+    in_flight_.insert_or_assign(std::move(current_id_),
+                                InFlightRequest{.method = std::move(current_method_), .delivered_at = clock::now()});
+  }
+  return true;
+}
+
+void ReplayTransport::Write(std::string_view buf) {
+  pending_ += buf;
+}
+
+void ReplayTransport::Flush() {
+  const auto now = clock::now();
+
+  const auto body_pos = pending_.find("\r\n\r\n");
+  const auto body = std::string_view{pending_}.substr(body_pos == std::string::npos ? 0 : body_pos + 4);
+  const auto id = glz::get_as_json<glz::raw_json_view, "/id">(body);
+  const auto has_method = glz::get_as_json<std::string_view, "/method">(body).has_value();
+  const auto has_error = glz::get_as_json<glz::raw_json_view, "/error">(body).has_value();
+
+  {
+    std::lock_guard l(mutex_);
+    ++counters_.messages_out;
+    counters_.bytes_out += body.size();
+    last_flush_ = now;
+
+    if (id && has_method) {
+      injected_.push_back(std::format(R"({{"jsonrpc":"2.0","id":{},"result":null}})", id->str));
+      cv_.notify_one();
+    } else if (id) {
+      if (const auto it = in_flight_.find(std::string{id->str}); it != in_flight_.end()) {
+        samples_.push_back({
+            .method = std::move(it->second.method),
+            .latency = std::chrono::duration_cast<std::chrono::microseconds>(now - it->second.delivered_at),
+            .failed = has_error,
+        });
+        in_flight_.erase(it);
+        cv_.notify_one();
+      }
+    }
+  }
+
+  pending_.clear();
+}
+
+}  // namespace vanadium::lserver
@@ -0,0 +1,121 @@
+#include "vanadium/lib/lserver/SessionTrace.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace vanadium::lserver {
+
+namespace {
+constexpr std::string_view kInbound = "in";
+constexpr std::string_view kOutbound = "out";
+
+template <typename T>
+bool ParseNumber(std::string_view s, T& value) {
+  const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  return ec == std::errc{} && ptr == s.data() + s.size();
+}
+
+void WriteRecord(std::ostream& out, std::chrono::microseconds ts, TraceDirection direction, std::string_view body) {
+  out << std::format("{} {} {}\n", ts.count(), direction == TraceDirection::kInbound ? kInbound : kOutbound,
+                     body.size());
+  out << body << '\n';
+}
+}  // namespace
+
+void WriteTraceMessage(std::ostream& out, const TraceMessage& message) {
+  WriteRecord(out, message.ts, message.direction, message.body);
+}
+
+std::expected<std::vector<TraceMessage>, std::string> ReadSessionTrace(std::istream& in) {
+  std::vector<TraceMessage> messages;
+
+  std::string header;
+  while (std::getline(in, header)) {
+    const auto record = messages.size() + 1;
+
+    const std::string_view sheader{header};
+    const auto ts_end = sheader.find(' ');
+    const auto direction_end = sheader.find(' ', ts_end + 1);
+    if (ts_end == std::string_view::npos || direction_end == std::string_view::npos) {
+      return std::unexpected{std::format("record {}: malformed header '{}'", record, header)};
+    }
+
+    auto& message = messages.emplace_back();
+
+    std::chrono::microseconds::rep ts;
+    std::size_t size;
+    if (!ParseNumber(sheader.substr(0, ts_end), ts) || !ParseNumber(sheader.substr(direction_end + 1), size)) {
+      return std::unexpected{std::format("record {}: malformed header '{}'", record, header)};
+    }
+    message.ts = std::chrono::microseconds{ts};
+
+    if (const auto direction = sheader.substr(ts_end + 1, direction_end - ts_end - 1); direction == kInbound) {
+      message.direction = TraceDirection::kInbound;
+    } else if (direction == kOutbound) {
+      message.direction = TraceDirection::kOutbound;
+    } else {
+      return std::unexpected{std::format("record {}: unknown direction '{}'", record, direction)};
+    }
+
+    message.body.resize(size);
+    if (!in.read(message.body.data(), static_cast<std::streamsize>(size)) || in.get() != '\n') {
+      return std::unexpected{std::format("record {}: truncated body", record)};
+    }
+  }
+
+  return messages;
+}
+
+RecordingTransport::RecordingTransport(const char* filename, Transport& base)
+    : base_(base), begin_(std::chrono::steady_clock::now()), trace_(filename, std::ios::binary | std::ios::trunc) {}
+
+bool RecordingTransport::ReadLine(std::span<char> chunk) {
+  if (!base_.ReadLine(chunk)) {
+    return false;
+  }
+  separator_expected_ = true;
+  return true;
+}
+
+bool RecordingTransport::Read(std::span<char> chunk) {
+  if (!base_.Read(chunk)) {
+    return false;
+  }
+  if (separator_expected_) {
+    separator_expected_ = false;
+  } else {
+    Record(TraceDirection::kInbound, {chunk.data(), chunk.size()});
+  }
+  return true;
+}
+
+void RecordingTransport::Write(std::string_view buf) {
+  pending_ += buf;
+  base_.Write(buf);
+}
+
+void RecordingTransport::Flush() {
+  base_.Flush();
+  if (const auto body_pos = pending_.find("\r\n\r\n"); body_pos != std::string::npos) [[likely]] {
+    Record(TraceDirection::kOutbound, std::string_view{pending_}.substr(body_pos + 4));
+  }
+  pending_.clear();
+}
+
+void RecordingTransport::Record(TraceDirection direction, std::string_view body) {
+  std::lock_guard l(mutex_);
+  const auto ts = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin_);
+  WriteRecord(trace_, ts, direction, body);
+  trace_.flush();  // the session is likely to end abruptly, e.g. with the editor being closed
+}
+
+}  // namespace vanadium::lserver
@@ -0,0 +1,179 @@
+#include "vanadium/lib/lserver/SocketTransport.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace vanadium::lserver {
+
+namespace {
+std::error_code LastError() {
+  return {errno, std::system_category()};
+}
+
+std::expected<sockaddr_un, std::error_code> MakeAddress(const std::string& path) {
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path)) {
+    return std::unexpected{std::make_error_code(std::errc::filename_too_long)};
+  }
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  return addr;
+}
+
+std::expected<int, std::error_code> ConnectTo(const sockaddr_un& addr) {
+  const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd == -1) {
+    return std::unexpected{LastError()};
+  }
+  if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == -1) {
+    const auto err = LastError();
+    close(fd);
+    return std::unexpected{err};
+  }
+  return fd;
+}
+}  // namespace
+
+SocketTransport::~SocketTransport() {
+  close(fd_);
+}
+
+bool SocketTransport::Fill() {
+  while (true) {
+    const auto n = recv(fd_, in_.data(), in_.size(), 0);
+    if (n == -1 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    in_begin_ = 0;
+    in_end_ = static_cast<std::size_t>(n);
+    return true;
+  }
+}
+
+bool SocketTransport::Read(std::span<char> chunk) {
+  std::size_t done{0};
+  while (done < chunk.size()) {
+    if (in_begin_ == in_end_ && !Fill()) {
+      return false;
+    }
+    const auto n = std::min(chunk.size() - done, in_end_ - in_begin_);
+    std::memcpy(chunk.data() + done, in_.data() + in_begin_, n);
+    in_begin_ += n;
+    done += n;
+  }
+  return true;
+}
+
+bool SocketTransport::ReadLine(std::span<char> chunk) {
+  // just like fgets(), the line is kept along with '\n' and terminated with '\0'
+  if (chunk.empty()) {
+    return false;
+  }
+  std::size_t done{0};
+  while (done + 1 < chunk.size()) {
+    if (in_begin_ == in_end_ && !Fill()) {
+      if (done == 0) {
+        return false;
+      }
+      break;
+    }
+    const char c = in_[in_begin_++];
+    chunk[done++] = c;
+    if (c == '\n') {
+      break;
+    }
+  }
+  chunk[done] = '\0';
+  return true;
+}
+
+void SocketTransport::Write(std::string_view buf) {
+  out_ += buf;
+}
+
+void SocketTransport::Flush() {
+  std::string_view pending{out_};
+  while (!pending.empty()) {
+    // the peer may be gone already, which must not kill the process with SIGPIPE
+    const auto n = send(fd_, pending.data(), pending.size(), MSG_NOSIGNAL);
+    if (n == -1 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    pending.remove_prefix(static_cast<std::size_t>(n));
+  }
+  out_.clear();
+}
+
+std::expected<std::unique_ptr<SocketTransport>, std::error_code> SocketTransport::Connect(const std::string& path) {
+  const auto addr = MakeAddress(path);
+  if (!addr) {
+    return std::unexpected{addr.error()};
+  }
+  const auto fd = ConnectTo(*addr);
+  if (!fd) {
+    return std::unexpected{fd.error()};
+  }
+  return std::make_unique<SocketTransport>(*fd);
+}
+
+std::expected<std::unique_ptr<SocketListener>, std::error_code> SocketListener::Listen(const std::string& path) {
+  const auto addr = MakeAddress(path);
+  if (!addr) {
+    return std::unexpected{addr.error()};
+  }
+
+  if (const auto fd = ConnectTo(*addr); fd) {
+    close(*fd);
+    return std::unexpected{std::make_error_code(std::errc::address_in_use)};
+  } else if (fd.error() == std::errc::connection_refused) {
+    unlink(path.c_str());  // stale
+  }
+
+  const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd == -1) {
+    return std::unexpected{LastError()};
+  }
+  if (bind(fd, reinterpret_cast<const sockaddr*>(&*addr), sizeof(*addr)) == -1 || listen(fd, SOMAXCONN) == -1) {
+    const auto err = LastError();
+    close(fd);
+    return std::unexpected{err};
+  }
+  return std::unique_ptr<SocketListener>(new SocketListener(fd, path));
+}
+
+SocketListener::~SocketListener() {
+  close(fd_);
+  unlink(path_.c_str());
+}
+
+std::unique_ptr<SocketTransport> SocketListener::Accept() {
+  while (true) {
+    const int fd = accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd != -1) {
+      return std::make_unique<SocketTransport>(fd);
+    }
+    if (errno != EINTR && errno != ECONNABORTED) {
+      return nullptr;
+    }
+  }
+}
+
+}  // namespace vanadium::lserver
@@ -1,6 +1,5 @@
 #include <cstdio>
 #include <iostream>
-#include <print>
 #include <span>
 #include <string_view>
 
@@ -8,16 +7,16 @@
 
 namespace vanadium::lserver {
 
-void StdioTransport::Read(std::span<char> chunk) {
-  std::fread(chunk.data(), chunk.size(), 1, stdin);
+bool StdioTransport::Read(std::span<char> chunk) {
+  return chunk.empty() || std::fread(chunk.data(), chunk.size(), 1, stdin) == 1;
 }
 
-void StdioTransport::ReadLine(std::span<char> chunk) {
-  std::fgets(chunk.data(), chunk.size(), stdin);
+bool StdioTransport::ReadLine(std::span<char> chunk) {
+  return std::fgets(chunk.data(), static_cast<int>(chunk.size()), stdin) != nullptr;
 }
 
 void StdioTransport::Write(std::string_view buf) {
-  std::print(stdout, "{}", buf);
+  std::fwrite(buf.data(), 1, buf.size(), stdout);
 }
 
 void StdioTransport::Flush() {
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glaze/json.hpp>
+
+#include "vanadium/lib/lserver/Connection.h"
+#include "vanadium/lib/lserver/MessageToken.h"
+#include "vanadium/lib/lserver/OrderingGate.h"
+#include "vanadium/lib/lserver/ReplayTransport.h"
+#include "vanadium/lib/lserver/SessionTrace.h"
+
+using namespace vanadium::lserver;
+using namespace std::chrono_literals;
+
+namespace {
+
+// A fragment of a recorded editing session: every keystroke is followed by the burst of requests
+// the editor sends to refresh its views. "$ID" is replaced with a unique request id upon replay.
+constexpr std::array<std::string_view, 6> kRecordedSession = {
+    R"({"jsonrpc":"2.0","method":"textDocument/didChange","params":{"textDocument":{"uri":"file:///ws/src/Module.ttcn","version":1},"contentChanges":[{"text":"module Module {}"}]}})",
+    R"({"jsonrpc":"2.0","id":$ID,"method":"textDocument/semanticTokens/range","params":{"textDocument":{"uri":"file:///ws/src/Module.ttcn"},"range":{"start":{"line":0,"character":0},"end":{"line":120,"character":0}}}})",
+    R"({"jsonrpc":"2.0","id":$ID,"method":"textDocument/inlayHint","params":{"textDocument":{"uri":"file:///ws/src/Module.ttcn"},"range":{"start":{"line":0,"character":0},"end":{"line":120,"character":0}}}})",
+    R"({"jsonrpc":"2.0","id":$ID,"method":"textDocument/documentSymbol","params":{"textDocument":{"uri":"file:///ws/src/Module.ttcn"}}})",
+    R"({"jsonrpc":"2.0","id":$ID,"method":"textDocument/completion","params":{"textDocument":{"uri":"file:///ws/src/Module.ttcn"},"position":{"line":14,"character":9},"context":{"triggerKind":1}}})",
+    R"({"jsonrpc":"2.0","id":$ID,"method":"textDocument/hover","params":{"textDocument":{"uri":"file:///ws/src/Module.ttcn"},"position":{"line":14,"character":5}}})",
+};
+constexpr std::size_t kSessionRepetitions = 500;
+
+constexpr std::size_t kConcurrency = 4;
+constexpr std::size_t kBacklog = 6;
+
+}  // namespace
+
+TEST(ConnectionLoad, ReplayRecordedSession) {
+  std::vector<TraceMessage> trace;
+  std::unordered_map<std::uint32_t, int> expected_versions;
+  {
+    std::uint32_t next_id{1};
+    int version{0};
+    for (std::size_t i = 0; i < kSessionRepetitions; ++i) {
+      for (std::string message : kRecordedSession) {
+        if (const auto pos = message.find("$ID"); pos != std::string::npos) {
+          message.replace(pos, 3, std::to_string(next_id));
+          expected_versions[next_id++] = version;
+        } else {
+          ++version;
+        }
+        trace.push_back({.ts = 0us, .direction = TraceDirection::kInbound, .body = std::move(message)});
+      }
+    }
+  }
+
+  ReplayTransport transport(trace, {.speed = 0});
+
+  std::atomic<int> document_version{0};
+  std::atomic<std::size_t> interleavings{0};
+  std::atomic<std::size_t> stale_reads{0};
+
+  const auto handler = [&](Connection& conn, PooledMessageToken&& token) {
+    const auto method = glz::get_as_json<std::string_view, "/method">(token->buf);
+    ASSERT_TRUE(method.has_value());
+
+    if (*method == "textDocument/didChange") {
+      document_version.fetch_add(1, std::memory_order_relaxed);
+      std::this_thread::yield();
+      return;
+    }
+
+    const auto id = glz::get_as_json<std::uint32_t, "/id">(token->buf);
+    ASSERT_TRUE(id.has_value());
+
+    // an edit admitted meanwhile would show up as a changed revision
+    const auto version = document_version.load(std::memory_order_relaxed);
+    std::this_thread::yield();
+    if (version != document_version.load(std::memory_order_relaxed)) {
+      interleavings.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (version != expected_versions.at(*id)) {  // the request has observed a wrong document revision
+      stale_reads.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto res_token = conn.AcquireToken();
+    res_token->buf = std::format(R"({{"jsonrpc":"2.0","id":{},"result":{}}})", *id, version);
+    conn.Send(std::move(res_token));
+  };
+
+  const auto classify = [](std::string_view message) {
+    const auto method = glz::get_as_json<std::string_view, "/method">(message);
+    return method && *method == "textDocument/didChange" ? MessageOrdering::kExclusive : MessageOrdering::kConcurrent;
+  };
+
+  {
+    Connection connection(handler, transport, kConcurrency, kBacklog, classify);
+    connection.Listen();
+  }
+
+  EXPECT_EQ(interleavings.load(), 0);
+  EXPECT_EQ(stale_reads.load(), 0);
+  EXPECT_EQ(transport.Unanswered(), 0);
+  EXPECT_EQ(transport.Samples().size(), expected_versions.size());
+}
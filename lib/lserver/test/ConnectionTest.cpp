@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstring>
+#include <expected>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glaze/json.hpp>
+#include <glaze/json/generic.hpp>
+
+#include "vanadium/lib/lserver/Connection.h"
+#include "vanadium/lib/lserver/MessageToken.h"
+#include "vanadium/lib/lserver/Transport.h"
+
+using namespace vanadium::lserver;
+
+namespace {
+
+struct ScriptedMessage {
+  std::string content;
+  std::function<void()> await{nullptr};  // blocks the delivery of the message until the precondition is met
+};
+
+class ScriptedTransport : public Transport {
+ public:
+  explicit ScriptedTransport(std::vector<ScriptedMessage>&& script) : script_(std::move(script)) {}
+
+  bool ReadLine(std::span<char> chunk) final {
+    if (cursor_ == script_.size()) {
+      return false;
+    }
+    if (script_[cursor_].await) {
+      script_[cursor_].await();
+    }
+    const auto header = std::format("Content-Length: {}\r\n", script_[cursor_].content.size());
+    std::memcpy(chunk.data(), header.c_str(), header.size() + 1);
+    separator_expected_ = true;
+    return true;
+  }
+
+  bool Read(std::span<char> chunk) final {
+    if (separator_expected_) {
+      std::memcpy(chunk.data(), "\r\n", 2);
+      separator_expected_ = false;
+      return true;
+    }
+    std::memcpy(chunk.data(), script_[cursor_++].content.data(), chunk.size());
+    return true;
+  }
+
+  void Write(std::string_view buf) final {
+    pending_ += buf;
+  }
+
+  void Flush() final {
+    std::lock_guard l(mutex_);
+    written_.emplace_back(std::string_view{pending_}.substr(pending_.find("\r\n\r\n") + 4));
+    pending_.clear();
+    cv_.notify_all();
+  }
+
+  void AwaitWritten(std::size_t n) {
+    std::unique_lock l(mutex_);
+    cv_.wait(l, [&] {
+      return written_.size() >= n;
+    });
+  }
+
+  std::vector<std::string> written_;
+
+ private:
+  std::vector<ScriptedMessage> script_;
+  std::size_t cursor_{0};
+  bool separator_expected_{false};
+
+  std::string pending_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+}  // namespace
+
+TEST(Connection, OutboundRequestDoesNotBlockWorker) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool other_handled{false};
+
+  ScriptedTransport* transport_ptr{nullptr};
+  ScriptedTransport transport({
+      {.content = R"({"jsonrpc":"2.0","id":10,"method":"start"})"},
+      {.content = R"({"jsonrpc":"2.0","method":"other"})"},
+      {
+          .content = R"({"jsonrpc":"2.0","id":1,"result":42})",
+          .await =
+              [&] {
+                transport_ptr->AwaitWritten(1);  // the outbound request
+                std::unique_lock l(mutex);
+                cv.wait(l, [&] {
+                  return other_handled;
+                });
+              },
+      },
+  });
+  transport_ptr = &transport;
+
+  std::optional<int> response;
+  const auto handler = [&](Connection& conn, PooledMessageToken&& token) {
+    const auto method = glz::get_as_json<std::string_view, "/method">(token->buf);
+    ASSERT_TRUE(method.has_value());
+
+    if (*method == "start") {
+      conn.Request<"client/compute", int>(glz::generic{}, [&](std::expected<int, vanadium::lib::jsonrpc::Error>&& res) {
+        ASSERT_TRUE(res.has_value());
+        response = *res;
+      });
+    } else if (*method == "other") {
+      std::lock_guard l(mutex);
+      other_handled = true;
+      cv.notify_all();
+    }
+  };
+
+  // the only worker would be stuck waiting for the response if requests were blocking
+  Connection connection(handler, transport, 1, 2);
+  connection.Listen();
+
+  ASSERT_TRUE(other_handled);
+  ASSERT_TRUE(response.has_value());
+  EXPECT_EQ(*response, 42);
+
+  ASSERT_EQ(transport.written_.size(), 1);
+  EXPECT_EQ(glz::get_as_json<std::string_view, "/method">(transport.written_[0]).value_or(""), "client/compute");
+}
+
+TEST(Connection, PostedTaskIsOrderedWithMessages) {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool posted{false};
+  std::vector<std::string> handled;
+
+  ScriptedTransport transport({
+      {.content = R"({"jsonrpc":"2.0","method":"first"})"},
+      {
+          .content = R"({"jsonrpc":"2.0","method":"second"})",
+          .await =
+              [&] {
+                std::unique_lock l(mutex);
+                cv.wait(l, [&] {
+                  return posted;
+                });
+              },
+      },
+  });
+
+  const auto handler = [&](Connection& conn, PooledMessageToken&& token) {
+    const auto method = glz::get_as_json<std::string_view, "/method">(token->buf);
+    ASSERT_TRUE(method.has_value());
+
+    std::lock_guard l(mutex);
+    handled.emplace_back(*method);
+    if (*method == "first") {
+      conn.Post([&] {
+        std::lock_guard l(mutex);
+        handled.emplace_back("task");
+      });
+      posted = true;
+      cv.notify_all();
+    }
+  };
+
+  Connection connection(handler, transport, 2, 2);
+  connection.Listen();
+
+  EXPECT_EQ(handled, (std::vector<std::string>{"first", "task", "second"}));
+}
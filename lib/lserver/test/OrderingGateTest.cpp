@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "vanadium/lib/lserver/OrderingGate.h"
+
+using namespace vanadium::lserver;
+
+TEST(OrderingGate, ConcurrentTicketsDoNotWaitForEachOther) {
+  OrderingGate gate;
+
+  const auto t1 = gate.Issue(MessageOrdering::kConcurrent);
+  const auto t2 = gate.Issue(MessageOrdering::kConcurrent);
+
+  // entered in reverse order, would block forever otherwise
+  gate.Enter(t2);
+  gate.Enter(t1);
+  gate.Leave(t1);
+  gate.Leave(t2);
+}
+
+TEST(OrderingGate, ExclusiveTicketSeparatesNeighbours) {
+  OrderingGate gate;
+
+  const auto before = gate.Issue(MessageOrdering::kConcurrent);
+  const auto exclusive = gate.Issue(MessageOrdering::kExclusive);
+  const auto after = gate.Issue(MessageOrdering::kConcurrent);
+
+  std::vector<int> trace;
+  std::mutex trace_mutex;
+  const auto record = [&](int v) {
+    std::lock_guard l(trace_mutex);
+    trace.push_back(v);
+  };
+
+  std::jthread t_after([&] {
+    gate.Enter(after);
+    record(3);
+    gate.Leave(after);
+  });
+  std::jthread t_exclusive([&] {
+    gate.Enter(exclusive);
+    record(2);
+    gate.Leave(exclusive);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  {
+    std::lock_guard l(trace_mutex);
+    ASSERT_TRUE(trace.empty());
+  }
+
+  gate.Enter(before);
+  record(1);
+  gate.Leave(before);
+
+  t_exclusive.join();
+  t_after.join();
+
+  EXPECT_EQ(trace, (std::vector<int>{1, 2, 3}));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glaze/json.hpp>
+
+#include "vanadium/lib/lserver/Connection.h"
+#include "vanadium/lib/lserver/MessageToken.h"
+#include "vanadium/lib/lserver/ReplayTransport.h"
+#include "vanadium/lib/lserver/SessionTrace.h"
+
+using namespace vanadium::lserver;
+using namespace std::chrono_literals;
+
+namespace {
+TraceMessage Inbound(std::string body) {
+  return {.ts = 0us, .direction = TraceDirection::kInbound, .body = std::move(body)};
+}
+
+void Respond(Connection& conn, std::uint32_t id) {
+  auto token = conn.AcquireToken();
+  token->buf = std::format(R"({{"jsonrpc":"2.0","id":{},"result":true}})", id);
+  conn.Send(std::move(token));
+}
+}  // namespace
+
+TEST(SessionTrace, RoundTrip) {
+  const std::vector<TraceMessage> messages{
+      {.ts = 0us, .direction = TraceDirection::kInbound, .body = R"({"jsonrpc":"2.0","id":1,"method":"a"})"},
+      {.ts = 1500us, .direction = TraceDirection::kOutbound, .body = "{\n  \"jsonrpc\": \"2.0\",\n  \"id\": 1\n}"},
+      {.ts = 2000us, .direction = TraceDirection::kInbound, .body = ""},
+  };
+
+  std::stringstream ss;
+  for (const auto& message : messages) {
+    WriteTraceMessage(ss, message);
+  }
+
+  const auto read = ReadSessionTrace(ss);
+  ASSERT_TRUE(read.has_value()) << read.error();
+  ASSERT_EQ(read->size(), messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ((*read)[i].ts, messages[i].ts);
+    EXPECT_EQ((*read)[i].direction, messages[i].direction);
+    EXPECT_EQ((*read)[i].body, messages[i].body);
+  }
+}
+
+TEST(SessionTrace, RejectsTruncatedTrace) {
+  std::stringstream ss("0 in 10\n{}\n");
+  EXPECT_FALSE(ReadSessionTrace(ss).has_value());
+
+  std::stringstream unknown_direction("0 sideways 2\n{}\n");
+  EXPECT_FALSE(ReadSessionTrace(unknown_direction).has_value());
+}
+
+TEST(SessionTrace, ReplayIsRecordedAndMeasured) {
+  const std::vector<TraceMessage> trace{
+      Inbound(R"({"jsonrpc":"2.0","id":1,"method":"ask"})"),
+      Inbound(R"({"jsonrpc":"2.0","method":"notify"})"),
+      Inbound(R"({"jsonrpc":"2.0","id":40,"result":null})"),  // recorded answer of the client, not played
+      Inbound(R"({"jsonrpc":"2.0","id":2,"method":"echo"})"),
+      Inbound(R"({"jsonrpc":"2.0","method":"exit"})"),
+      Inbound(R"({"jsonrpc":"2.0","id":3,"method":"echo"})"),
+  };
+
+  // "ask" can only be answered once the client has answered the request of the server
+  const auto handler = [](Connection& conn, PooledMessageToken&& token) {
+    const auto method = glz::get_as_json<std::string_view, "/method">(token->buf);
+    if (!method) {
+      return;
+    }
+    if (*method == "ask") {
+      conn.Request<"client/ask", std::nullptr_t>(glz::generic{}, [&conn](auto&& res) {
+        EXPECT_TRUE(res.has_value());
+        Respond(conn, 1);
+      });
+    } else if (*method == "echo") {
+      Respond(conn, glz::get_as_json<std::uint32_t, "/id">(token->buf).value_or(0));
+    }
+  };
+
+  const auto trace_path = std::filesystem::temp_directory_path() / "vanadium_session_trace_test.trace";
+
+  ReplayTransport replay(trace, {.speed = 0});
+  {
+    RecordingTransport recording(trace_path.c_str(), replay);
+    Connection connection(handler, recording, 2, 2);
+    connection.Listen();
+  }
+
+  std::vector<std::string> methods;
+  for (const auto& sample : replay.Samples()) {
+    methods.push_back(sample.method);
+    EXPECT_FALSE(sample.failed);
+  }
+  std::ranges::sort(methods);
+  EXPECT_EQ(methods, (std::vector<std::string>{"ask", "echo"}));
+  EXPECT_EQ(replay.Unanswered(), 0);
+  EXPECT_EQ(replay.GetCounters().messages_in, 4);  // "ask", "notify", "echo" and the answer to "client/ask"
+  EXPECT_EQ(replay.GetCounters().messages_out, 3);
+
+  std::ifstream in(trace_path, std::ios::binary);
+  const auto recorded = ReadSessionTrace(in);
+  ASSERT_TRUE(recorded.has_value()) << recorded.error();
+  EXPECT_EQ(std::ranges::count(*recorded, TraceDirection::kInbound, &TraceMessage::direction), 4);
+  EXPECT_EQ(std::ranges::count(*recorded, TraceDirection::kOutbound, &TraceMessage::direction), 3);
+  for (std::size_t i = 1; i < recorded->size(); ++i) {
+    EXPECT_LE((*recorded)[i - 1].ts, (*recorded)[i].ts);
+  }
+
+  std::filesystem::remove(trace_path);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "vanadium/lib/lserver/Channel.h"
+#include "vanadium/lib/lserver/MessageToken.h"
+#include "vanadium/lib/lserver/SocketTransport.h"
+
+using namespace vanadium::lserver;
+
+namespace {
+std::string SocketPath() {
+  return (std::filesystem::temp_directory_path() /
+          ("vanadium-socket-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "-" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name()))
+      .string();
+}
+
+void Send(Channel& channel, TokenPool& pool, std::string_view body) {
+  auto token = pool.Acquire();
+  token->body_offset = MessageToken::kHeaderReserve;
+  token->buf.resize(token->body_offset);
+  token->buf += body;
+  channel.Enqueue(std::move(token));
+  ASSERT_TRUE(channel.Write());
+}
+
+std::string Receive(Channel& channel) {
+  if (!channel.Read()) {
+    return {};
+  }
+  auto token = channel.Poll();
+  return token->buf;
+}
+}  // namespace
+
+TEST(SocketTransport, ExchangesFramedMessages) {
+  const auto path = SocketPath();
+  auto listener = SocketListener::Listen(path);
+  ASSERT_TRUE(listener.has_value()) << listener.error().message();
+
+  std::thread server([&] {
+    auto transport = (*listener)->Accept();
+    ASSERT_NE(transport, nullptr);
+    TokenPool pool(2);
+    Channel channel(*transport, 2);
+    for (auto message = Receive(channel); !message.empty(); message = Receive(channel)) {
+      Send(channel, pool, "echo: " + message);
+    }
+  });
+
+  {
+    auto transport = SocketTransport::Connect(path);
+    ASSERT_TRUE(transport.has_value()) << transport.error().message();
+    TokenPool pool(2);
+    Channel channel(**transport, 2);
+
+    Send(channel, pool, R"({"id":1})");
+    EXPECT_EQ(Receive(channel), R"(echo: {"id":1})");
+
+    // larger than the buffer of the transport
+    const std::string large(10000, 'x');
+    Send(channel, pool, large);
+    EXPECT_EQ(Receive(channel), "echo: " + large);
+  }
+  server.join();
+}
+
+TEST(SocketTransport, ListenerReplacesStaleSocket) {
+  const auto path = SocketPath();
+  {
+    auto listener = SocketListener::Listen(path);
+    ASSERT_TRUE(listener.has_value());
+
+    // the path is taken while it is being listened on
+    EXPECT_FALSE(SocketListener::Listen(path).has_value());
+  }
+  EXPECT_FALSE(std::filesystem::exists(path));
+  EXPECT_FALSE(SocketTransport::Connect(path).has_value());
+
+  // as if the process listening on it has crashed
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un addr{.sun_family = AF_UNIX, .sun_path = {}};
+  path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+  ASSERT_EQ(bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+  close(fd);
+  ASSERT_TRUE(std::filesystem::exists(path));
+
+  EXPECT_TRUE(SocketListener::Listen(path).has_value());
+}
+
+TEST(SocketTransport, ClosesConnectionUponMalformedHeader) {
+  const auto path = SocketPath();
+  auto listener = SocketListener::Listen(path);
+  ASSERT_TRUE(listener.has_value()) << listener.error().message();
+
+  for (const std::string_view header : {"Content-Type: application/json\r\n", "Content-Length: x\r\n",
+                                        "Content-Length: \r\n", "Content-Length: 18446744073709551615\r\n"}) {
+    std::thread server([&] {
+      auto transport = (*listener)->Accept();
+      ASSERT_NE(transport, nullptr);
+      Channel channel(*transport, 2);
+      EXPECT_FALSE(channel.Read()) << header;
+      EXPECT_FALSE(channel.Poll());
+    });
+
+    auto transport = SocketTransport::Connect(path);
+    ASSERT_TRUE(transport.has_value()) << transport.error().message();
+    (*transport)->Write(header);
+    (*transport)->Write("\r\n{\"id\":1}");
+    (*transport)->Flush();
+    server.join();
+
+    Channel channel(**transport, 2);
+    EXPECT_FALSE(channel.Read());  // closed by the server
+  }
+}
@@ -52,11 +52,11 @@ def get_type_name(type_def: model.LSP_TYPE_SPEC, optional: bool | None = None) -
     case "reference":
       name = type_def.name  # type: ignore
     case "array":
-      name = f"std::vector<{get_type_name(type_def.element)}>"  # type: ignore
+      name = f"vector<{get_type_name(type_def.element)}>"  # type: ignore
     case "map":
       key_type = get_type_name(type_def.key)  # type: ignore
       value_type = get_type_name(type_def.value)  # type: ignore
-      name = f"std::unordered_map<{key_type}, {value_type}>"
+      name = f"unordered_map<{key_type}, {value_type}>"
     case "base":
       name = lsp_to_base_types(type_def)  # type: ignore
     case "or":
@@ -72,7 +72,7 @@ def generate_enum(enum: model.Enum) -> TypeEntry:
       sbuf.newline()
     valuelist = ", ".join([f'"{item.value}"' for item in enum.values])
     sbuf.write(
-      f"namespace lsp {{ inline const std::vector<std::string_view> kBuiltin{enum.name}{{{valuelist}}}; }}"
+      f"namespace lsp {{ inline const vector<std::string_view> kBuiltin{enum.name}{{{valuelist}}}; }}"
     )
 
   return TypeEntry(buf, appendix=sbuf)
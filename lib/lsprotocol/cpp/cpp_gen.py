@@ -42,6 +42,8 @@ def _build_header(spec: model.LSPModel, reg: TypesRegistry):
   buf.write("#include <variant>")
   buf.write("#include <vector>")
   buf.newline()
+  buf.write('#include "LSProtocolMemory.h"')
+  buf.newline()
   buf.write("// NOLINTBEGIN(readability-identifier-naming)\n")
   buf.newline()
   buf.write("namespace lsp {")
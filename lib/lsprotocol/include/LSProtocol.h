@@ -14,6 +14,8 @@
 
 #include <glaze/json.hpp>
 
+#include "LSProtocolMemory.h"
+
 // NOLINTBEGIN(readability-identifier-naming)
 
 namespace lsp {
@@ -917,14 +919,14 @@ struct SemanticTokens {
   std::optional<std::string_view> resultId;
 
   // The actual tokens.
-  std::vector<std::uint32_t> data;
+  vector<std::uint32_t> data;
 };
 
 /**
  * @since 3.16.0
  */
 struct SemanticTokensPartialResult {
-  std::vector<std::uint32_t> data;
+  vector<std::uint32_t> data;
 };
 
 /**
@@ -938,7 +940,7 @@ struct SemanticTokensEdit {
   std::uint32_t deleteCount;
 
   // The elements to insert.
-  std::optional<std::vector<std::uint32_t>> data;
+  std::optional<vector<std::uint32_t>> data;
 };
 
 /**
@@ -1120,7 +1122,7 @@ struct TextDocumentContentResult {
  */
 struct TextDocumentContentOptions {
   // The schemes for which the server provides content.
-  std::vector<std::string_view> schemes;
+  vector<std::string_view> schemes;
 };
 
 /**
@@ -1175,7 +1177,7 @@ struct InitializeError {
 struct InitializedParams {};
 
 struct DidChangeConfigurationRegistrationOptions {
-  std::optional<std::variant<std::string_view, std::vector<std::string_view>>> section;
+  std::optional<std::variant<std::string_view, vector<std::string_view>>> section;
 };
 
 struct MessageActionItem {
@@ -1270,7 +1272,7 @@ struct DocumentOnTypeFormattingOptions {
   std::string_view firstTriggerCharacter;
 
   // More trigger characters.
-  std::optional<std::vector<std::string_view>> moreTriggerCharacter;
+  std::optional<vector<std::string_view>> moreTriggerCharacter;
 };
 
 /**
@@ -1382,10 +1384,10 @@ struct CancelParams {
  */
 struct SemanticTokensLegend {
   // The token types a server uses.
-  std::vector<std::string_view> tokenTypes;
+  vector<std::string_view> tokenTypes;
 
   // The token modifiers a server uses.
-  std::vector<std::string_view> tokenModifiers;
+  vector<std::string_view> tokenModifiers;
 };
 
 /**
@@ -1927,7 +1929,7 @@ struct StaleRequestSupportOptions {
   // The list of requests for which the client
   // will retry the request if it receives a
   // response with error code `ContentModified`
-  std::vector<std::string_view> retryOnContentModified;
+  vector<std::string_view> retryOnContentModified;
 };
 
 /**
@@ -1946,7 +1948,7 @@ struct MarkdownClientCapabilities {
   // Markdown.
   //
   // @since 3.17.0
-  std::optional<std::vector<std::string_view>> allowedTags;
+  std::optional<vector<std::string_view>> allowedTags;
 };
 
 /**
@@ -1965,7 +1967,7 @@ struct ChangeAnnotationsSupportOptions {
 struct ClientSymbolResolveOptions {
   // The properties that a client can resolve lazily. Usually
   // `location.range`
-  std::vector<std::string_view> properties;
+  vector<std::string_view> properties;
 };
 
 /**
@@ -1983,7 +1985,7 @@ struct CompletionListCapabilities {
   // no properties are supported.
   //
   // @since 3.17.0
-  std::optional<std::vector<std::string_view>> itemDefaults;
+  std::optional<vector<std::string_view>> itemDefaults;
 
   // Specifies whether the client supports `CompletionList.applyKind` to
   // indicate how supported values from `completionList.itemDefaults`
@@ -2004,7 +2006,7 @@ struct CompletionListCapabilities {
  */
 struct ClientCodeActionResolveOptions {
   // The properties that a client can resolve lazily.
-  std::vector<std::string_view> properties;
+  vector<std::string_view> properties;
 };
 
 /**
@@ -2012,7 +2014,7 @@ struct ClientCodeActionResolveOptions {
  */
 struct ClientCodeLensResolveOptions {
   // The properties that a client can resolve lazily.
-  std::vector<std::string_view> properties;
+  vector<std::string_view> properties;
 };
 
 /**
@@ -2031,7 +2033,7 @@ struct ClientFoldingRangeOptions {
  */
 struct ClientInlayHintResolveOptions {
   // The properties that a client can resolve lazily.
-  std::vector<std::string_view> properties;
+  vector<std::string_view> properties;
 };
 
 /**
@@ -2049,7 +2051,7 @@ struct ClientShowMessageActionItemOptions {
  */
 struct ClientCompletionItemResolveOptions {
   // The properties that a client can resolve lazily.
-  std::vector<std::string_view> properties;
+  vector<std::string_view> properties;
 };
 
 /**
@@ -2114,7 +2116,7 @@ struct ClientFoldingRangeKindOptions {
   // property exists the client also guarantees that it will
   // handle values outside its set gracefully and falls back
   // to a default value when unknown.
-  std::optional<std::vector<FoldingRangeKind>> valueSet;
+  std::optional<vector<FoldingRangeKind>> valueSet;
 };
 
 /**
@@ -2129,7 +2131,7 @@ struct ClientSymbolKindOptions {
   // If this property is not present the client only supports
   // the symbol kinds from `File` to `Array` as defined in
   // the initial version of the protocol.
-  std::optional<std::vector<SymbolKind>> valueSet;
+  std::optional<vector<SymbolKind>> valueSet;
 };
 
 /**
@@ -2145,7 +2147,7 @@ struct BaseSymbolInformation {
   // Tags for this symbol.
   //
   // @since 3.16.0
-  std::optional<std::vector<SymbolTag>> tags;
+  std::optional<vector<SymbolTag>> tags;
 
   // The name of the symbol containing this symbol. This information is for
   // user interface purposes (e.g. to render a qualifier in the user interface
@@ -2159,7 +2161,7 @@ struct BaseSymbolInformation {
  */
 struct ClientSymbolTagOptions {
   // The tags supported by the client.
-  std::vector<SymbolTag> valueSet;
+  vector<SymbolTag> valueSet;
 };
 
 /**
@@ -2216,7 +2218,7 @@ struct ClientCompletionItemOptionsKind {
   // If this property is not present the client only supports
   // the completion items kinds from `Text` to `Reference` as defined in
   // the initial version of the protocol.
-  std::optional<std::vector<CompletionItemKind>> valueSet;
+  std::optional<vector<CompletionItemKind>> valueSet;
 };
 
 /**
@@ -2224,14 +2226,14 @@ struct ClientCompletionItemOptionsKind {
  */
 struct CompletionItemTagOptions {
   // The tags supported by the client.
-  std::vector<CompletionItemTag> valueSet;
+  vector<CompletionItemTag> valueSet;
 };
 
 /**
  * @since 3.18.0
  */
 struct ClientCompletionItemInsertTextModeOptions {
-  std::vector<InsertTextMode> valueSet;
+  vector<InsertTextMode> valueSet;
 };
 
 /**
@@ -2242,7 +2244,7 @@ struct ClientCodeActionKindOptions {
   // property exists the client also guarantees that it will
   // handle values outside its set gracefully and falls back
   // to a default value when unknown.
-  std::vector<CodeActionKind> valueSet;
+  vector<CodeActionKind> valueSet;
 };
 
 /**
@@ -2250,7 +2252,7 @@ struct ClientCodeActionKindOptions {
  */
 struct CodeActionTagOptions {
   // The tags supported by the client.
-  std::vector<CodeActionTag> valueSet;
+  vector<CodeActionTag> valueSet;
 };
 
 struct SetTraceParams {
@@ -2295,7 +2297,7 @@ struct HoverClientCapabilities {
 
   // Client supports the following content formats for the content
   // property. The order describes the preferred format of the client.
-  std::optional<std::vector<MarkupKind>> contentFormat;
+  std::optional<vector<MarkupKind>> contentFormat;
 };
 
 /**
@@ -2333,7 +2335,7 @@ struct FileEvent {
  */
 struct ClientDiagnosticsTagOptions {
   // The tags supported by the client.
-  std::vector<DiagnosticTag> valueSet;
+  vector<DiagnosticTag> valueSet;
 };
 
 /**
@@ -2517,7 +2519,7 @@ struct Command {
 
   // Arguments that the command handler should be
   // invoked with.
-  std::optional<std::vector<LSPAny>> arguments;
+  std::optional<vector<LSPAny>> arguments;
 };
 
 struct ProgressParams {
@@ -2561,10 +2563,10 @@ struct RegularExpressionsClientCapabilities {
  */
 struct WorkspaceFoldersChangeEvent {
   // The array of added workspace folders
-  std::vector<WorkspaceFolder> added;
+  vector<WorkspaceFolder> added;
 
   // The array of the removed workspace folders
-  std::vector<WorkspaceFolder> removed;
+  vector<WorkspaceFolder> removed;
 };
 
 struct WorkspaceFoldersInitializeParams {
@@ -2575,7 +2577,7 @@ struct WorkspaceFoldersInitializeParams {
   // configured.
   //
   // @since 3.6.0
-  std::optional<std::vector<WorkspaceFolder>> workspaceFolders;
+  std::optional<vector<WorkspaceFolder>> workspaceFolders;
 };
 
 /**
@@ -2598,7 +2600,7 @@ struct RelativePattern {
  * The parameters of a configuration request.
  */
 struct ConfigurationParams {
-  std::vector<ConfigurationItem> items;
+  vector<ConfigurationItem> items;
 };
 
 /**
@@ -2772,7 +2774,7 @@ struct HoverOptions {
  */
 struct SignatureHelpOptions {
   // List of characters that trigger signature help automatically.
-  std::optional<std::vector<std::string_view>> triggerCharacters;
+  std::optional<vector<std::string_view>> triggerCharacters;
 
   // List of characters that re-trigger signature help.
   //
@@ -2780,7 +2782,7 @@ struct SignatureHelpOptions {
   // are also counted as re-trigger characters.
   //
   // @since 3.15.0
-  std::optional<std::vector<std::string_view>> retriggerCharacters;
+  std::optional<vector<std::string_view>> retriggerCharacters;
   std::optional<bool> workDoneProgress;
 };
 
@@ -2882,7 +2884,7 @@ struct RenameOptions {
  */
 struct ExecuteCommandOptions {
   // The commands to be executed on the server
-  std::vector<std::string_view> commands;
+  vector<std::string_view> commands;
   std::optional<bool> workDoneProgress;
 };
 
@@ -2926,14 +2928,14 @@ struct SemanticTokensDelta {
   std::optional<std::string_view> resultId;
 
   // The semantic token edits to transform a previous result into a new result.
-  std::vector<SemanticTokensEdit> edits;
+  vector<SemanticTokensEdit> edits;
 };
 
 /**
  * @since 3.16.0
  */
 struct SemanticTokensDeltaPartialResult {
-  std::vector<SemanticTokensEdit> edits;
+  vector<SemanticTokensEdit> edits;
 };
 
 /**
@@ -2944,7 +2946,7 @@ struct SemanticTokensDeltaPartialResult {
  */
 struct CreateFilesParams {
   // An array of all files/folders created in this operation.
-  std::vector<FileCreate> files;
+  vector<FileCreate> files;
 };
 
 /**
@@ -2956,7 +2958,7 @@ struct CreateFilesParams {
 struct RenameFilesParams {
   // An array of all files/folders renamed in this operation. When a folder is renamed, only
   // the folder will be included, and not its children.
-  std::vector<FileRename> files;
+  vector<FileRename> files;
 };
 
 /**
@@ -2967,7 +2969,7 @@ struct RenameFilesParams {
  */
 struct DeleteFilesParams {
   // An array of all files/folders deleted in this operation.
-  std::vector<FileDelete> files;
+  vector<FileDelete> files;
 };
 
 /**
@@ -3015,7 +3017,7 @@ struct DidCloseNotebookDocumentParams {
 
   // The text documents that represent the content
   // of a notebook cell that got closed.
-  std::vector<TextDocumentIdentifier> cellTextDocuments;
+  vector<TextDocumentIdentifier> cellTextDocuments;
 };
 
 /**
@@ -3026,7 +3028,7 @@ struct DidCloseNotebookDocumentParams {
  */
 struct TextDocumentContentRegistrationOptions {
   // The schemes for which the server provides content.
-  std::vector<std::string_view> schemes;
+  vector<std::string_view> schemes;
 
   // The id used to register the request. The id can be used to deregister
   // the request again. See also Registration#id.
@@ -3034,7 +3036,7 @@ struct TextDocumentContentRegistrationOptions {
 };
 
 struct UnregistrationParams {
-  std::vector<Unregistration> unregisterations;
+  vector<Unregistration> unregisterations;
 };
 
 struct ShowMessageRequestParams {
@@ -3045,7 +3047,7 @@ struct ShowMessageRequestParams {
   std::string_view message;
 
   // The message action items to present.
-  std::optional<std::vector<MessageActionItem>> actions;
+  std::optional<vector<MessageActionItem>> actions;
 };
 
 struct TextDocumentSyncOptions {
@@ -3120,7 +3122,7 @@ struct CompletionOptions {
   //
   // If code complete should automatically be trigger on characters not being valid inside
   // an identifier (for example `.` in JavaScript) list them in `triggerCharacters`.
-  std::optional<std::vector<std::string_view>> triggerCharacters;
+  std::optional<vector<std::string_view>> triggerCharacters;
 
   // The list of all possible characters that commit a completion. This field can be used
   // if clients don't support individual commit characters per completion item. See
@@ -3130,7 +3132,7 @@ struct CompletionOptions {
   // completion item the ones on the completion item win.
   //
   // @since 3.2.0
-  std::optional<std::vector<std::string_view>> allCommitCharacters;
+  std::optional<vector<std::string_view>> allCommitCharacters;
 
   // The server provides support to resolve additional
   // information for a completion item.
@@ -3192,7 +3194,7 @@ struct WorkspaceEditClientCapabilities {
   // support 'create', 'rename' and 'delete' files and folders.
   //
   // @since 3.13.0
-  std::optional<std::vector<ResourceOperationKind>> resourceOperations;
+  std::optional<vector<ResourceOperationKind>> resourceOperations;
 
   // The failure handling strategy of a client if applying the workspace edit
   // fails.
@@ -3270,7 +3272,7 @@ struct ShowMessageRequestClientCapabilities {
 struct ClientSignatureInformationOptions {
   // Client supports the following content formats for the documentation
   // property. The order describes the preferred format of the client.
-  std::optional<std::vector<MarkupKind>> documentationFormat;
+  std::optional<vector<MarkupKind>> documentationFormat;
 
   // Client capabilities specific to parameter information.
   std::optional<ClientSignatureParameterInformationOptions> parameterInformation;
@@ -3400,7 +3402,7 @@ struct ClientCompletionItemOptions {
 
   // Client supports the following content formats for the documentation
   // property. The order describes the preferred format of the client.
-  std::optional<std::vector<MarkupKind>> documentationFormat;
+  std::optional<vector<MarkupKind>> documentationFormat;
 
   // Client supports the deprecated property on a completion item.
   std::optional<bool> deprecatedSupport;
@@ -3489,7 +3491,7 @@ struct DidOpenTextDocumentParams {
  */
 struct DidChangeWatchedFilesParams {
   // The actual file events.
-  std::vector<FileEvent> changes;
+  vector<FileEvent> changes;
 };
 
 /**
@@ -3559,7 +3561,7 @@ struct ExecuteCommandParams {
   std::string_view command;
 
   // Arguments that the command should be invoked with.
-  std::optional<std::vector<LSPAny>> arguments;
+  std::optional<vector<LSPAny>> arguments;
 
   // An optional token that a server can use to report work done progress.
   std::optional<ProgressToken> workDoneToken;
@@ -3603,7 +3605,7 @@ struct SelectionRangeParams {
   TextDocumentIdentifier textDocument;
 
   // The positions inside the text document.
-  std::vector<Position> positions;
+  vector<Position> positions;
 
   // An optional token that a server can use to report work done progress.
   std::optional<ProgressToken> workDoneToken;
@@ -3681,7 +3683,7 @@ struct WorkspaceDiagnosticParams {
 
   // The currently known diagnostic reports with their
   // previous result ids.
-  std::vector<PreviousResultId> previousResultIds;
+  vector<PreviousResultId> previousResultIds;
 
   // An optional token that a server can use to report work done progress.
   std::optional<ProgressToken> workDoneToken;
@@ -3866,7 +3868,7 @@ struct CodeActionKindDocumentation {
 };
 
 struct RegistrationParams {
-  std::vector<Registration> registrations;
+  vector<Registration> registrations;
 };
 
 /**
@@ -3911,7 +3913,7 @@ struct GeneralClientCapabilities {
   // side.
   //
   // @since 3.17.0
-  std::optional<std::vector<PositionEncodingKind>> positionEncodings;
+  std::optional<vector<PositionEncodingKind>> positionEncodings;
 };
 
 /**
@@ -3945,7 +3947,7 @@ struct WorkspaceSymbolRegistrationOptions {
  */
 struct ExecuteCommandRegistrationOptions {
   // The commands to be executed on the server
-  std::vector<std::string_view> commands;
+  vector<std::string_view> commands;
 };
 
 struct ImplementationParams {
@@ -4221,7 +4223,7 @@ struct CallHierarchyItem {
   SymbolKind kind;
 
   // Tags for this item.
-  std::optional<std::vector<SymbolTag>> tags;
+  std::optional<vector<SymbolTag>> tags;
 
   // More detail for this item, e.g. the signature of a function.
   std::optional<std::string_view> detail;
@@ -4295,7 +4297,7 @@ struct ShowDocumentParams {
 struct LinkedEditingRanges {
   // A list of ranges that can be edited together. The ranges must have
   // identical length and contain identical text content. The ranges cannot overlap.
-  std::vector<Range> ranges;
+  vector<Range> ranges;
 
   // An optional word pattern (regular expression) that describes valid contents for
   // the given ranges. If no pattern is provided, the client configuration's word
@@ -4314,7 +4316,7 @@ struct TypeHierarchyItem {
   SymbolKind kind;
 
   // Tags for this item.
-  std::optional<std::vector<SymbolTag>> tags;
+  std::optional<vector<SymbolTag>> tags;
 
   // More detail for this item, e.g. the signature of a function.
   std::optional<std::string_view> detail;
@@ -4393,7 +4395,7 @@ struct TextEdit {
  */
 struct Hover {
   // The hover's content
-  std::variant<MarkupContent, MarkedString, std::vector<MarkedString>> contents;
+  std::variant<MarkupContent, MarkedString, vector<MarkedString>> contents;
 
   // An optional range inside the text document that is used to
   // visualize the hover, e.g. by changing the background color.
@@ -4433,7 +4435,7 @@ struct DocumentSymbol {
   // Tags for this document symbol.
   //
   // @since 3.16.0
-  std::optional<std::vector<SymbolTag>> tags;
+  std::optional<vector<SymbolTag>> tags;
 
   // Indicates if this symbol is deprecated.
   //
@@ -4450,7 +4452,7 @@ struct DocumentSymbol {
   Range selectionRange;
 
   // Children of this symbol, e.g. properties of a class.
-  std::optional<std::vector<DocumentSymbol>> children;
+  std::optional<vector<DocumentSymbol>> children;
 };
 
 /**
@@ -4525,7 +4527,7 @@ struct DocumentRangesFormattingParams {
   TextDocumentIdentifier textDocument;
 
   // The ranges to format
-  std::vector<Range> ranges;
+  vector<Range> ranges;
 
   // The format options
   FormattingOptions options;
@@ -4776,13 +4778,13 @@ struct SemanticTokensClientCapabilities {
   ClientSemanticTokensRequestOptions requests;
 
   // The token types that the client supports.
-  std::vector<std::string_view> tokenTypes;
+  vector<std::string_view> tokenTypes;
 
   // The token modifiers that the client supports.
-  std::vector<std::string_view> tokenModifiers;
+  vector<std::string_view> tokenModifiers;
 
   // The token formats the clients supports.
-  std::vector<TokenFormat> formats;
+  vector<TokenFormat> formats;
 
   // Whether the client supports tokens that can overlap each other.
   std::optional<bool> overlappingTokenSupport;
@@ -4998,7 +5000,7 @@ struct SignatureInformation {
   std::optional<std::variant<std::string_view, MarkupContent>> documentation;
 
   // The parameters of this signature.
-  std::optional<std::vector<ParameterInformation>> parameters;
+  std::optional<vector<ParameterInformation>> parameters;
 
   // The index of the active parameter.
   //
@@ -5105,7 +5107,7 @@ struct NotebookDocument {
   std::optional<LSPObject> metadata;
 
   // The cells of a notebook.
-  std::vector<NotebookCell> cells;
+  vector<NotebookCell> cells;
 };
 
 /**
@@ -5122,7 +5124,7 @@ struct NotebookCellArrayChange {
   std::uint32_t deleteCount;
 
   // The new cells, if any
-  std::optional<std::vector<NotebookCell>> cells;
+  std::optional<vector<NotebookCell>> cells;
 };
 
 /**
@@ -5133,7 +5135,7 @@ struct CodeActionOptions {
   //
   // The list of kinds may be generic, such as `CodeActionKind.Refactor`, or the server
   // may list out every specific kind they provide.
-  std::optional<std::vector<CodeActionKind>> codeActionKinds;
+  std::optional<vector<CodeActionKind>> codeActionKinds;
 
   // Static documentation for a class of code actions.
   //
@@ -5150,7 +5152,7 @@ struct CodeActionOptions {
   //
   // @since 3.18.0
   // @proposed
-  std::optional<std::vector<CodeActionKindDocumentation>> documentation;
+  std::optional<vector<CodeActionKindDocumentation>> documentation;
 
   // The server provides support to resolve additional
   // information for a code action.
@@ -5288,12 +5290,12 @@ struct NotebookDocumentFilterPattern {
  * Servers should prefer returning `DefinitionLink` over `Definition` if supported
  * by the client.
  */
-using Definition = std::variant<Location, std::vector<Location>>;
+using Definition = std::variant<Location, vector<Location>>;
 
 /**
  * The declaration of a symbol representation as one or many {@link Location locations}.
  */
-using Declaration = std::variant<Location, std::vector<Location>>;
+using Declaration = std::variant<Location, vector<Location>>;
 
 /**
  * Represents information about programming constructs like variables, classes,
@@ -5325,7 +5327,7 @@ struct SymbolInformation {
   // Tags for this symbol.
   //
   // @since 3.16.0
-  std::optional<std::vector<SymbolTag>> tags;
+  std::optional<vector<SymbolTag>> tags;
 
   // The name of the symbol containing this symbol. This information is for
   // user interface purposes (e.g. to render a qualifier in the user interface
@@ -5362,7 +5364,7 @@ struct WorkspaceSymbol {
   // Tags for this symbol.
   //
   // @since 3.16.0
-  std::optional<std::vector<SymbolTag>> tags;
+  std::optional<vector<SymbolTag>> tags;
 
   // The name of the symbol containing this symbol. This information is for
   // user interface purposes (e.g. to render a qualifier in the user interface
@@ -5446,7 +5448,7 @@ struct CallHierarchyIncomingCall {
 
   // The ranges at which the calls appear. This is relative to the caller
   // denoted by {@link CallHierarchyIncomingCall.from `this.from`}.
-  std::vector<Range> fromRanges;
+  vector<Range> fromRanges;
 };
 
 /**
@@ -5477,7 +5479,7 @@ struct CallHierarchyOutgoingCall {
   // The range at which this item is called. This is the range relative to the caller, e.g the item
   // passed to {@link CallHierarchyItemProvider.provideCallHierarchyOutgoingCalls `provideCallHierarchyOutgoingCalls`}
   // and not {@link CallHierarchyOutgoingCall.to `this.to`}.
-  std::vector<Range> fromRanges;
+  vector<Range> fromRanges;
 };
 
 /**
@@ -5520,7 +5522,7 @@ struct TypeHierarchySubtypesParams {
  */
 struct InlineCompletionList {
   // The inline completion items
-  std::vector<InlineCompletionItem> items;
+  vector<InlineCompletionItem> items;
 };
 
 struct ColorPresentation {
@@ -5537,7 +5539,7 @@ struct ColorPresentation {
   // An optional array of additional {@link TextEdit text edits} that are applied when
   // selecting this color presentation. Edits must not overlap with the main {@link ColorPresentation.textEdit edit} nor
   // with themselves.
-  std::optional<std::vector<TextEdit>> additionalTextEdits;
+  std::optional<vector<TextEdit>> additionalTextEdits;
 };
 
 /**
@@ -5634,7 +5636,7 @@ struct CompletionItem {
   // Tags for this completion item.
   //
   // @since 3.15.0
-  std::optional<std::vector<CompletionItemTag>> tags;
+  std::optional<vector<CompletionItemTag>> tags;
 
   // A human-readable string with additional information
   // about this item, like type or symbol information.
@@ -5733,12 +5735,12 @@ struct CompletionItem {
   // Additional text edits should be used to change text unrelated to the current cursor position
   // (for example adding an import statement at the top of the file if the completion item will
   // insert an unqualified type).
-  std::optional<std::vector<TextEdit>> additionalTextEdits;
+  std::optional<vector<TextEdit>> additionalTextEdits;
 
   // An optional set of characters that when pressed while this completion is active will accept it first and
   // then type that character. *Note* that all commit characters should have `length=1` and that superfluous
   // characters will be ignored.
-  std::optional<std::vector<std::string_view>> commitCharacters;
+  std::optional<vector<std::string_view>> commitCharacters;
 
   // An optional {@link Command command} that is executed *after* inserting this completion. *Note* that
   // additional modifications to the current document should be described with the
@@ -5794,7 +5796,7 @@ struct CompletionItemDefaults {
   // A default commit character set.
   //
   // @since 3.17.0
-  std::optional<std::vector<std::string_view>> commitCharacters;
+  std::optional<vector<std::string_view>> commitCharacters;
 
   // A default edit range.
   //
@@ -5824,7 +5826,7 @@ struct CompletionItemDefaults {
  */
 struct FileOperationRegistrationOptions {
   // The actual filters.
-  std::vector<FileOperationFilter> filters;
+  vector<FileOperationFilter> filters;
 };
 
 /**
@@ -5834,7 +5836,7 @@ struct FileOperationRegistrationOptions {
  */
 struct SignatureHelp {
   // One or more signatures.
-  std::vector<SignatureInformation> signatures;
+  vector<SignatureInformation> signatures;
 
   // The active signature. If omitted or the value lies outside the
   // range of `signatures` the value defaults to zero or is ignored if
@@ -6012,7 +6014,7 @@ struct DidOpenNotebookDocumentParams {
 
   // The text documents that represent the content
   // of a notebook cell.
-  std::vector<TextDocumentItem> cellTextDocuments;
+  vector<TextDocumentItem> cellTextDocuments;
 };
 
 /**
@@ -6025,10 +6027,10 @@ struct NotebookDocumentCellChangeStructure {
   NotebookCellArrayChange array;
 
   // Additional opened cell text documents.
-  std::optional<std::vector<TextDocumentItem>> didOpen;
+  std::optional<vector<TextDocumentItem>> didOpen;
 
   // Additional closed cell text documents.
-  std::optional<std::vector<TextDocumentIdentifier>> didClose;
+  std::optional<vector<TextDocumentIdentifier>> didClose;
 };
 
 /**
@@ -6036,7 +6038,7 @@ struct NotebookDocumentCellChangeStructure {
  */
 struct DidChangeWatchedFilesRegistrationOptions {
   // The watchers to register.
-  std::vector<FileSystemWatcher> watchers;
+  vector<FileSystemWatcher> watchers;
 };
 
 /**
@@ -6089,7 +6091,7 @@ struct InlayHint {
   // InlayHintLabelPart label parts.
   //
   // *Note* that neither the string nor the label part can be empty.
-  std::variant<std::string_view, std::vector<InlayHintLabelPart>> label;
+  std::variant<std::string_view, vector<InlayHintLabelPart>> label;
 
   // The kind of this hint. Can be omitted in which case the client
   // should fall back to a reasonable default.
@@ -6100,7 +6102,7 @@ struct InlayHint {
   // *Note* that edits are expected to change the document so that the inlay
   // hint (or its nearest variant) is now part of the document and the inlay
   // hint itself is now obsolete.
-  std::optional<std::vector<TextEdit>> textEdits;
+  std::optional<vector<TextEdit>> textEdits;
 
   // The tooltip text when you hover over this item.
   std::optional<std::variant<std::string_view, MarkupContent>> tooltip;
@@ -6157,11 +6159,11 @@ struct Diagnostic {
   // Additional metadata about the diagnostic.
   //
   // @since 3.15.0
-  std::optional<std::vector<DiagnosticTag>> tags;
+  std::optional<vector<DiagnosticTag>> tags;
 
   // An array of related diagnostic information, e.g. when symbol-names within
   // a scope collide all definitions can be marked via this property.
-  std::optional<std::vector<DiagnosticRelatedInformation>> relatedInformation;
+  std::optional<vector<DiagnosticRelatedInformation>> relatedInformation;
 
   // A data entry field that is preserved between a `textDocument/publishDiagnostics`
   // notification and `textDocument/codeAction` request.
@@ -6187,7 +6189,7 @@ struct TextDocumentEdit {
   //
   // @since 3.18.0 - support for SnippetTextEdit. This is guarded using a
   // client capability.
-  std::vector<std::variant<TextEdit, AnnotatedTextEdit, SnippetTextEdit>> edits;
+  vector<std::variant<TextEdit, AnnotatedTextEdit, SnippetTextEdit>> edits;
 };
 
 /**
@@ -6231,7 +6233,7 @@ struct DidChangeTextDocumentParams {
   // - apply the 'textDocument/didChange' notifications in the order you receive them.
   // - apply the `TextDocumentContentChangeEvent`s in a single notification in the order
   //   you receive them.
-  std::vector<TextDocumentContentChangeEvent> contentChanges;
+  vector<TextDocumentContentChangeEvent> contentChanges;
 };
 
 /**
@@ -6241,7 +6243,7 @@ struct DidChangeTextDocumentParams {
  */
 struct NotebookDocumentCellContentChanges {
   VersionedTextDocumentIdentifier document;
-  std::vector<TextDocumentContentChangeEvent> changes;
+  vector<TextDocumentContentChangeEvent> changes;
 };
 
 /**
@@ -6292,7 +6294,7 @@ struct CompletionList {
   std::optional<CompletionItemApplyKinds> applyKind;
 
   // The completion items.
-  std::vector<CompletionItem> items;
+  vector<CompletionItem> items;
 };
 
 /**
@@ -6384,7 +6386,7 @@ struct NotebookDocumentFilterWithNotebook {
   std::variant<std::string_view, NotebookDocumentFilter> notebook;
 
   // The cells of the matching notebook to be synced.
-  std::optional<std::vector<NotebookCellLanguage>> cells;
+  std::optional<vector<NotebookCellLanguage>> cells;
 };
 
 /**
@@ -6397,7 +6399,7 @@ struct NotebookDocumentFilterWithCells {
   std::optional<std::variant<std::string_view, NotebookDocumentFilter>> notebook;
 
   // The cells of the matching notebook to be synced.
-  std::vector<NotebookCellLanguage> cells;
+  vector<NotebookCellLanguage> cells;
 };
 
 /**
@@ -6433,7 +6435,7 @@ struct PublishDiagnosticsParams {
   std::optional<std::int32_t> version;
 
   // An array of diagnostic information items.
-  std::vector<Diagnostic> diagnostics;
+  vector<Diagnostic> diagnostics;
 };
 
 /**
@@ -6451,7 +6453,7 @@ struct FullDocumentDiagnosticReport {
   std::optional<std::string_view> resultId;
 
   // The actual items.
-  std::vector<Diagnostic> items;
+  vector<Diagnostic> items;
 };
 
 /**
@@ -6464,13 +6466,13 @@ struct CodeActionContext {
   // errors are currently presented to the user for the given range. There is no guarantee
   // that these accurately reflect the error state of the resource. The primary parameter
   // to compute code actions is the provided range.
-  std::vector<Diagnostic> diagnostics;
+  vector<Diagnostic> diagnostics;
 
   // Requested kind of actions to return.
   //
   // Actions not of this kind are filtered out by the client before being shown. So servers
   // can omit computing them.
-  std::optional<std::vector<CodeActionKind>> only;
+  std::optional<vector<CodeActionKind>> only;
 
   // The reason why code actions were requested.
   //
@@ -6494,7 +6496,7 @@ struct CodeActionContext {
  */
 struct WorkspaceEdit {
   // Holds changes to existing resources.
-  std::optional<std::unordered_map<std::string_view, std::vector<TextEdit>>> changes;
+  std::optional<unordered_map<std::string_view, vector<TextEdit>>> changes;
 
   // Depending on the client capability `workspace.workspaceEdit.resourceOperations` document changes
   // are either an array of `TextDocumentEdit`s to express changes to n different text documents
@@ -6506,7 +6508,7 @@ struct WorkspaceEdit {
   //
   // If a client neither supports `documentChanges` nor `workspace.workspaceEdit.resourceOperations` then
   // only plain `TextEdit`s using the `changes` property are supported.
-  std::optional<std::vector<std::variant<TextDocumentEdit, CreateFile, RenameFile, DeleteFile>>> documentChanges;
+  std::optional<vector<std::variant<TextDocumentEdit, CreateFile, RenameFile, DeleteFile>>> documentChanges;
 
   // A map of change annotations that can be referenced in `AnnotatedTextEdit`s or create, rename and
   // delete file / folder operations.
@@ -6514,7 +6516,7 @@ struct WorkspaceEdit {
   // Whether clients honor this property depends on the client capability `workspace.changeAnnotationSupport`.
   //
   // @since 3.16.0
-  std::optional<std::unordered_map<ChangeAnnotationIdentifier, ChangeAnnotation>> changeAnnotations;
+  std::optional<unordered_map<ChangeAnnotationIdentifier, ChangeAnnotation>> changeAnnotations;
 };
 
 /**
@@ -6529,10 +6531,10 @@ struct NotebookDocumentCellChanges {
 
   // Changes to notebook cells properties like its
   // kind, execution summary or metadata.
-  std::optional<std::vector<NotebookCell>> data;
+  std::optional<vector<NotebookCell>> data;
 
   // Changes to the text content of notebook cells.
-  std::optional<std::vector<NotebookDocumentCellContentChanges>> textContent;
+  std::optional<vector<NotebookDocumentCellContentChanges>> textContent;
 };
 
 /**
@@ -6647,7 +6649,7 @@ struct _InitializeParams {
  */
 struct NotebookDocumentSyncOptions {
   // The notebooks to be synced
-  std::vector<std::variant<NotebookDocumentFilterWithNotebook, NotebookDocumentFilterWithCells>> notebookSelector;
+  vector<std::variant<NotebookDocumentFilterWithNotebook, NotebookDocumentFilterWithCells>> notebookSelector;
 
   // Whether save notification should be forwarded to
   // the server. Will only be honored if mode === `notebook`.
@@ -6668,7 +6670,7 @@ using DocumentFilter = std::variant<TextDocumentFilter, NotebookCellTextDocument
  * @since 3.17.0
  */
 struct DocumentDiagnosticReportPartialResult {
-  std::unordered_map<std::string_view, std::variant<FullDocumentDiagnosticReport, UnchangedDocumentDiagnosticReport>>
+  unordered_map<std::string_view, std::variant<FullDocumentDiagnosticReport, UnchangedDocumentDiagnosticReport>>
       relatedDocuments;
 };
 
@@ -6685,7 +6687,7 @@ struct RelatedFullDocumentDiagnosticReport {
   // a.cpp and result in errors in a header file b.hpp.
   //
   // @since 3.17.0
-  std::optional<std::unordered_map<std::string_view,
+  std::optional<unordered_map<std::string_view,
                                    std::variant<FullDocumentDiagnosticReport, UnchangedDocumentDiagnosticReport>>>
       relatedDocuments;
 
@@ -6698,7 +6700,7 @@ struct RelatedFullDocumentDiagnosticReport {
   std::optional<std::string_view> resultId;
 
   // The actual items.
-  std::vector<Diagnostic> items;
+  vector<Diagnostic> items;
 };
 
 /**
@@ -6714,7 +6716,7 @@ struct RelatedUnchangedDocumentDiagnosticReport {
   // a.cpp and result in errors in a header file b.hpp.
   //
   // @since 3.17.0
-  std::optional<std::unordered_map<std::string_view,
+  std::optional<unordered_map<std::string_view,
                                    std::variant<FullDocumentDiagnosticReport, UnchangedDocumentDiagnosticReport>>>
       relatedDocuments;
 
@@ -6751,7 +6753,7 @@ struct WorkspaceFullDocumentDiagnosticReport {
   std::optional<std::string_view> resultId;
 
   // The actual items.
-  std::vector<Diagnostic> items;
+  vector<Diagnostic> items;
 };
 
 /**
@@ -6792,7 +6794,7 @@ struct CodeAction {
   std::optional<CodeActionKind> kind;
 
   // The diagnostics that this code action resolves.
-  std::optional<std::vector<Diagnostic>> diagnostics;
+  std::optional<vector<Diagnostic>> diagnostics;
 
   // Marks this as a preferred action. Preferred actions are used by the `auto fix` command and can be targeted
   // by keybindings.
@@ -6839,7 +6841,7 @@ struct CodeAction {
   // Tags for this code action.
   //
   // @since 3.18.0 - proposed
-  std::optional<std::vector<CodeActionTag>> tags;
+  std::optional<vector<CodeActionTag>> tags;
 };
 
 /**
@@ -6928,7 +6930,7 @@ struct InitializeParams {
   // configured.
   //
   // @since 3.6.0
-  std::optional<std::vector<WorkspaceFolder>> workspaceFolders;
+  std::optional<vector<WorkspaceFolder>> workspaceFolders;
 };
 
 /**
@@ -6938,7 +6940,7 @@ struct InitializeParams {
  */
 struct NotebookDocumentSyncRegistrationOptions {
   // The notebooks to be synced
-  std::vector<std::variant<NotebookDocumentFilterWithNotebook, NotebookDocumentFilterWithCells>> notebookSelector;
+  vector<std::variant<NotebookDocumentFilterWithNotebook, NotebookDocumentFilterWithCells>> notebookSelector;
 
   // Whether save notification should be forwarded to
   // the server. Will only be honored if mode === `notebook`.
@@ -6956,7 +6958,7 @@ struct NotebookDocumentSyncRegistrationOptions {
  *
  * The use of a string as a document filter is deprecated @since 3.16.0.
  */
-using DocumentSelector = std::vector<DocumentFilter>;
+using DocumentSelector = vector<DocumentFilter>;
 
 /**
  * The result of a document diagnostic pull request. A report can
@@ -7021,7 +7023,7 @@ struct TextDocumentRegistrationOptions {
  * @since 3.17.0
  */
 struct WorkspaceDiagnosticReport {
-  std::vector<WorkspaceDocumentDiagnosticReport> items;
+  vector<WorkspaceDocumentDiagnosticReport> items;
 };
 
 /**
@@ -7030,7 +7032,7 @@ struct WorkspaceDiagnosticReport {
  * @since 3.17.0
  */
 struct WorkspaceDiagnosticReportPartialResult {
-  std::vector<WorkspaceDocumentDiagnosticReport> items;
+  vector<WorkspaceDocumentDiagnosticReport> items;
 };
 
 struct ImplementationRegistrationOptions {
@@ -7280,7 +7282,7 @@ struct CompletionRegistrationOptions {
   //
   // If code complete should automatically be trigger on characters not being valid inside
   // an identifier (for example `.` in JavaScript) list them in `triggerCharacters`.
-  std::optional<std::vector<std::string_view>> triggerCharacters;
+  std::optional<vector<std::string_view>> triggerCharacters;
 
   // The list of all possible characters that commit a completion. This field can be used
   // if clients don't support individual commit characters per completion item. See
@@ -7290,7 +7292,7 @@ struct CompletionRegistrationOptions {
   // completion item the ones on the completion item win.
   //
   // @since 3.2.0
-  std::optional<std::vector<std::string_view>> allCommitCharacters;
+  std::optional<vector<std::string_view>> allCommitCharacters;
 
   // The server provides support to resolve additional
   // information for a completion item.
@@ -7321,7 +7323,7 @@ struct SignatureHelpRegistrationOptions {
   DocumentSelector documentSelector;
 
   // List of characters that trigger signature help automatically.
-  std::optional<std::vector<std::string_view>> triggerCharacters;
+  std::optional<vector<std::string_view>> triggerCharacters;
 
   // List of characters that re-trigger signature help.
   //
@@ -7329,7 +7331,7 @@ struct SignatureHelpRegistrationOptions {
   // are also counted as re-trigger characters.
   //
   // @since 3.15.0
-  std::optional<std::vector<std::string_view>> retriggerCharacters;
+  std::optional<vector<std::string_view>> retriggerCharacters;
 };
 
 /**
@@ -7386,7 +7388,7 @@ struct CodeActionRegistrationOptions {
   //
   // The list of kinds may be generic, such as `CodeActionKind.Refactor`, or the server
   // may list out every specific kind they provide.
-  std::optional<std::vector<CodeActionKind>> codeActionKinds;
+  std::optional<vector<CodeActionKind>> codeActionKinds;
 
   // Static documentation for a class of code actions.
   //
@@ -7403,7 +7405,7 @@ struct CodeActionRegistrationOptions {
   //
   // @since 3.18.0
   // @proposed
-  std::optional<std::vector<CodeActionKindDocumentation>> documentation;
+  std::optional<vector<CodeActionKindDocumentation>> documentation;
 
   // The server provides support to resolve additional
   // information for a code action.
@@ -7472,7 +7474,7 @@ struct DocumentOnTypeFormattingRegistrationOptions {
   std::string_view firstTriggerCharacter;
 
   // More trigger characters.
-  std::optional<std::vector<std::string_view>> moreTriggerCharacter;
+  std::optional<vector<std::string_view>> moreTriggerCharacter;
 };
 
 /**
@@ -7667,7 +7669,7 @@ struct glz::meta<lsp::SemanticTokenTypes> {
 };
 
 namespace lsp {
-inline const std::vector<std::string_view> kBuiltinSemanticTokenTypes{
+inline const vector<std::string_view> kBuiltinSemanticTokenTypes{
     "namespace", "type",     "class",      "enum",   "interface", "struct",   "typeParameter", "parameter",
     "variable",  "property", "enumMember", "event",  "function",  "method",   "macro",         "keyword",
     "modifier",  "comment",  "string",     "number", "regexp",    "operator", "decorator",     "label"};
@@ -7683,7 +7685,7 @@ struct glz::meta<lsp::SemanticTokenModifiers> {
 };
 
 namespace lsp {
-inline const std::vector<std::string_view> kBuiltinSemanticTokenModifiers{
+inline const vector<std::string_view> kBuiltinSemanticTokenModifiers{
     "declaration", "definition", "readonly",     "static",        "deprecated",
     "abstract",    "async",      "modification", "documentation", "defaultLibrary"};
 }
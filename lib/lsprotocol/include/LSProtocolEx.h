@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 #include "LSProtocol.h"
 
@@ -8,18 +10,19 @@
 
 // Server -> Client
 namespace lsp {
-using CodeActionResult = std::variant<Command, std::vector<CodeAction>, std::nullptr_t>;
-using DefinitionResult = std::variant<Location, std::vector<Location>, std::vector<LocationLink>, std::nullptr_t>;
-using ReferencesResult = std::variant<std::vector<Location>, std::nullptr_t>;
-using TypeDefinitionResult = std::variant<Location, std::vector<Location>, std::vector<LocationLink>, std::nullptr_t>;
-using DocumentHighlightResults = std::variant<std::vector<DocumentHighlight>, std::nullptr_t>;
+using CodeActionResult = std::variant<Command, vector<CodeAction>, std::nullptr_t>;
+using DefinitionResult = std::variant<Location, vector<Location>, vector<LocationLink>, std::nullptr_t>;
+using ReferencesResult = std::variant<vector<Location>, std::nullptr_t>;
+using TypeDefinitionResult = std::variant<Location, vector<Location>, vector<LocationLink>, std::nullptr_t>;
+using DocumentHighlightResults = std::variant<vector<DocumentHighlight>, std::nullptr_t>;
 using HoverResult = std::variant<Hover, std::nullptr_t>;
 using RenameResult = std::variant<WorkspaceEdit, std::nullptr_t>;
-using CompletionResult = std::variant<std::vector<CompletionItem>, CompletionList, std::nullptr_t>;
-using InlayHintResult = std::variant<std::vector<InlayHint>, std::nullptr_t>;
-using DocumentSybmolResult = std::variant<std::vector<DocumentSymbol>, std::vector<SymbolInformation>, std::nullptr_t>;
+using CompletionResult = std::variant<vector<CompletionItem>, CompletionList, std::nullptr_t>;
+using InlayHintResult = std::variant<vector<InlayHint>, std::nullptr_t>;
+using DocumentSybmolResult = std::variant<vector<DocumentSymbol>, vector<SymbolInformation>, std::nullptr_t>;
 using SignatureHelpResult = std::variant<SignatureHelp, std::nullptr_t>;
 using SemanticTokensRangeResult = std::variant<SemanticTokens, std::nullptr_t>;
+using FormattingResult = std::variant<vector<TextEdit>, std::nullptr_t>;
 }  // namespace lsp
 
 // Client -> Server
@@ -27,6 +30,35 @@ namespace lsp {
 using ShowMessageRequestResult = std::variant<MessageActionItem, std::nullptr_t>;
 }
 
+// Vanadium extensions
+namespace lsp {
+// $/vanadium/memoryStats: the memory held by the analysis, in bytes, the heap figures are estimated
+struct FileMemoryStats {
+  std::string_view path;
+  std::uint64_t arenaAllocated;
+  std::uint64_t arenaUsed;
+  std::uint64_t source;
+  std::uint64_t symbolTables;
+  std::uint64_t module;
+  std::uint64_t diagnostics;
+  std::uint64_t total;
+};
+
+struct ProjectMemoryStats {
+  std::string_view name;
+  vector<FileMemoryStats> files;
+  std::uint64_t index;
+  std::uint64_t asnModulesArena;
+  std::uint64_t asnModulesHeap;
+  std::uint64_t total;
+};
+
+struct MemoryStatsResult {
+  vector<ProjectMemoryStats> projects;
+  std::uint64_t total;
+};
+}  // namespace lsp
+
 namespace glz {
 template <>
 struct from<JSON, lsp::TextDocumentContentChangeEvent> {
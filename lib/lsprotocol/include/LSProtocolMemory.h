@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace lsp {
+
+namespace detail {
+inline thread_local std::pmr::memory_resource* bound_memory_resource{nullptr};
+}  // namespace detail
+
+// The containers of the protocol types take their memory from the resource bound to the thread
+// at the moment they are created (see ScopedMemoryResource), or from the heap if nothing is bound.
+// An allocator sticks to its resource for the whole lifetime of the container, while copies
+// pick up the resource of the thread making them, so a value can be copied out of the scope safely.
+template <typename T>
+class Allocator {
+ public:
+  using value_type = T;
+
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  Allocator() noexcept
+      : resource_(detail::bound_memory_resource != nullptr ? detail::bound_memory_resource
+                                                           : std::pmr::new_delete_resource()) {}
+
+  template <typename U>
+  Allocator(const Allocator<U>& other) noexcept : resource_(other.Resource()) {}
+
+  [[nodiscard]] T* allocate(std::size_t n) {
+    return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    resource_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+  [[nodiscard]] Allocator select_on_container_copy_construction() const noexcept {
+    return Allocator{};
+  }
+
+  [[nodiscard]] std::pmr::memory_resource* Resource() const noexcept {
+    return resource_;
+  }
+
+  template <typename U>
+  bool operator==(const Allocator<U>& other) const noexcept {
+    return resource_ == other.Resource();
+  }
+
+ private:
+  std::pmr::memory_resource* resource_;
+};
+
+template <typename T>
+using vector = std::vector<T, Allocator<T>>;
+
+template <typename K, typename V>
+using unordered_map = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, Allocator<std::pair<const K, V>>>;
+
+// Binds the memory resource to the current thread until the end of the scope,
+// the containers created meanwhile must not outlive it.
+// Whatever else the thread runs in the scope picks up the resource too, so a thread that may execute
+// foreign work while waiting (e.g. in a task scheduler) has to be isolated from it for the duration.
+class ScopedMemoryResource {
+ public:
+  explicit ScopedMemoryResource(std::pmr::memory_resource* resource) noexcept
+      : previous_(std::exchange(detail::bound_memory_resource, resource)) {}
+
+  ~ScopedMemoryResource() {
+    detail::bound_memory_resource = previous_;
+  }
+
+  ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+  ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+  ScopedMemoryResource(ScopedMemoryResource&&) = delete;
+  ScopedMemoryResource& operator=(ScopedMemoryResource&&) = delete;
+
+ private:
+  std::pmr::memory_resource* previous_;
+};
+
+}  // namespace lsp
+
+// NOLINTEND(readability-identifier-naming)
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+#include <glaze/json.hpp>
+
+#include "LSProtocol.h"
+#include "LSProtocolMemory.h"
+
+namespace {
+
+// Counts the allocations passed through to the upstream resource
+class CountingResource final : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations{0};
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) final {
+    ++allocations;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) final {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept final {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+TEST(LSProtocolMemory, ContainersUseBoundResource) {
+  CountingResource resource;
+
+  lsp::vector<lsp::Location> outside;
+  EXPECT_EQ(outside.get_allocator().Resource(), std::pmr::new_delete_resource());
+
+  {
+    const lsp::ScopedMemoryResource bound(&resource);
+
+    lsp::vector<lsp::Location> locations;
+    locations.push_back(lsp::Location{.uri = "file:///a.ttcn"});
+    EXPECT_EQ(locations.get_allocator().Resource(), &resource);
+    EXPECT_EQ(resource.allocations, 1);
+
+    // the copy made after leaving the scope must not refer to the resource anymore
+    outside = locations;
+  }
+
+  const auto copy = outside;
+  EXPECT_EQ(copy.get_allocator().Resource(), std::pmr::new_delete_resource());
+  EXPECT_EQ(copy.front().uri, "file:///a.ttcn");
+}
+
+TEST(LSProtocolMemory, ParsedValuesUseBoundResource) {
+  constexpr std::string_view kJson =
+      R"({"textDocument":{"uri":"file:///a.ttcn"},"range":{"start":{"line":0,"character":0},"end":{"line":1,"character":0}},"context":{"diagnostics":[{"range":{"start":{"line":0,"character":0},"end":{"line":0,"character":1}},"message":"m"}]}})";
+
+  CountingResource resource;
+  const lsp::ScopedMemoryResource bound(&resource);
+
+  lsp::CodeActionParams params;
+  ASSERT_FALSE(glz::read_json(params, kJson));
+  ASSERT_EQ(params.context.diagnostics.size(), 1);
+  EXPECT_EQ(params.context.diagnostics.get_allocator().Resource(), &resource);
+  EXPECT_GE(resource.allocations, 1);
+}
@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/ast/ASTNodes.h>
+#include <vanadium/bench/BenchUtils.h>
+#include <vanadium/bench/Corpus.h>
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/FunctionRef.h>
+
+#include "vanadium/asn1/ast/Asn1ModuleBasket.h"
+
+namespace {
+
+using namespace vanadium;
+using namespace vanadium::bench;
+
+std::size_t CountNodes(const ast::RootNode* root) {
+  std::size_t nodes{1};
+  root->Accept([&](const ast::Node*) {
+    ++nodes;
+    return true;
+  });
+  return nodes;
+}
+
+// Parsing of the ASN.1 modules and their transformation into the TTCN-3 trees
+void BM_AsnTransform(benchmark::State& state) {
+  const auto& corpus = CachedCorpus(UseCorpusShape(state));
+
+  std::vector<std::string_view> sources;
+  for (const auto& file : corpus) {
+    if (IsAsnFile(file.path)) {
+      sources.push_back(file.src);
+    }
+  }
+  std::vector<int> keys(sources.size());  // the basket is keyed by the files
+
+  lib::Arena arena;
+  const auto transform_all = [&](const lib::Consumer<const ast::AST&>& consume) {
+    asn1::ast::Asn1ModuleBasket basket;
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+      basket.Update(&keys[i], sources[i]);
+    }
+    for (auto& key : keys) {
+      arena.Reset();
+      consume(basket.Transform(&key, arena));
+    }
+  };
+
+  std::size_t nodes{0};
+  transform_all([&](const ast::AST& ast) {
+    nodes += CountNodes(ast.root);
+  });
+
+  for (auto _ : state) {
+    transform_all([](const ast::AST& ast) {
+      benchmark::DoNotOptimize(ast.root);
+    });
+  }
+
+  ReportThroughput(state, AsnBytes(corpus), nodes);
+}
+BENCHMARK(BM_AsnTransform)
+    ->Arg(static_cast<std::int64_t>(CorpusShape::kWithAsn))
+    ->ArgName("shape")
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
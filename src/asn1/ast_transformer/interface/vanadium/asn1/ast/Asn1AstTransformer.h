@@ -27,7 +27,12 @@ struct TransformedAsn1Ast {
 
 using Asn1pModuleProvider = lib::FunctionRef<const asn1p_module_t*(const char*)>;
 
-TransformedAsn1Ast TransformAsn1Ast(const asn1p_t* ast, std::string_view src, lib::Arena& arena, Asn1pModuleProvider);
+// Notified of every definition looked up in the other modules (module name, definition name),
+// including the ones that have not been found. The transformation result depends only on them besides the source.
+using Asn1pDefinitionObserver = lib::FunctionRef<void(const char*, const char*)>;
+
+TransformedAsn1Ast TransformAsn1Ast(const asn1p_t* ast, std::string_view src, lib::Arena& arena, Asn1pModuleProvider,
+                                    Asn1pDefinitionObserver = nullptr);
 
 namespace compilerExtensions {
 extern bool eag_grouping;
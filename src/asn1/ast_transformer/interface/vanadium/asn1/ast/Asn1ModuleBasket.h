@@ -1,9 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 #include <ranges>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <vanadium/asn1/ast/Asn1cAstWrapper.h>
@@ -12,13 +16,19 @@
 #include <vanadium/lib/Arena.h>
 #include <vanadium/lib/FunctionRef.h>
 
+#include "vanadium/asn1/ast/Asn1TransformationCache.h"
+
 namespace vanadium::asn1::ast {
 
 // NOLINTNEXTLINE(readability-identifier-naming)
 namespace ttcn_ast = vanadium::ast;
 
 struct Asn1ModuleBasketItem {
+  void* key{nullptr};  // the file the item has been put with
+
   std::string_view src;
+  std::uint64_t content_hash{0};
+  bool cacheable{true};  // whether the transformation is worth storing in the cache, see Asn1ModuleBasket::Update
   ttcn_ast::LineMapping lines;
 
   lib::Arena arena;
@@ -26,13 +36,27 @@ struct Asn1ModuleBasketItem {
   std::vector<Asn1cSyntaxError> errors;
 
   std::optional<std::string_view> module_name;
+  std::unordered_map<std::string_view, std::uint64_t> definition_hashes;  // by the name, hashed are the source texts
+
+  // The definitions of the other modules the last transformation has looked into
+  std::vector<Asn1DefinitionDependency> dependencies;
+  bool transformed{false};           // since the last update
+  bool dependencies_changed{false};  // some of them may have been changed, see Asn1ModuleBasket::NeedsTransform
 };
 
 class Asn1ModuleBasket {
  public:
+  // The transformation of a source that is not going to be seen by the next runs, such as an editor buffer,
+  // is not put into the cache (it is still looked up there)
+  template <typename TKey>
+  void Update(TKey* key, std::string_view src, bool cacheable = true) {
+    UpdateImpl(reinterpret_cast<OpaqueKey*>(key), src, cacheable);
+  }
+
+  // Forgets the file, releasing everything that has been allocated for it
   template <typename TKey>
-  void Update(TKey* key, std::string_view src) {
-    UpdateImpl(reinterpret_cast<OpaqueKey*>(key), src);
+  void Drop(TKey* key) {
+    DropImpl(reinterpret_cast<OpaqueKey*>(key));
   }
 
   template <typename TKey>
@@ -40,6 +64,28 @@ class Asn1ModuleBasket {
     return TransformImpl(reinterpret_cast<OpaqueKey*>(key), arena);
   }
 
+  // Whether the module has to be transformed (again): it has been updated since the last transformation,
+  // or any definition of the other modules the transformation has used is not the same anymore
+  template <typename TKey>
+  bool NeedsTransform(TKey* key) {
+    return NeedsTransformImpl(reinterpret_cast<OpaqueKey*>(key));
+  }
+
+  // Visits the files whose modules may have to be transformed again because of the changes of the other modules
+  // since the last call, so that they don't have to be looked for among all the keys
+  template <typename TKey>
+  void ExtractInvalidated(lib::Consumer<TKey*> visit) {
+    for (auto* key : ExtractInvalidatedImpl()) {
+      visit(reinterpret_cast<TKey*>(key));
+    }
+  }
+
+  // The file providing the module, if it has been put into this basket (references are not looked into)
+  template <typename TKey>
+  TKey* FindModuleKey(std::string_view module_name) {
+    return reinterpret_cast<TKey*>(FindModuleKeyImpl(module_name));
+  }
+
   template <typename TKey>
   auto Keys() const {
     return items_ | std::views::keys | std::views::transform([&](OpaqueKey* k) {
@@ -49,24 +95,47 @@ class Asn1ModuleBasket {
 
   void AddReference(Asn1ModuleBasket*);
 
+  [[nodiscard]] std::size_t SpaceAllocated() const;
+  [[nodiscard]] std::size_t HeapUsage() const;  // held besides the arenas: the items, the diagnostics, the indices
+
+  // The cache shared by all the baskets of the process, nullptr disables it
+  static void SetTransformationCache(const Asn1TransformationCache*);
+
  private:
   using OpaqueKey = void;
 
-  void UpdateImpl(OpaqueKey* key, std::string_view src);
+  void UpdateImpl(OpaqueKey* key, std::string_view src, bool cacheable);
+  void DropImpl(OpaqueKey* key);
   ttcn_ast::AST TransformImpl(OpaqueKey* key, lib::Arena& arena);
+  bool NeedsTransformImpl(OpaqueKey* key);
+  std::vector<OpaqueKey*> ExtractInvalidatedImpl();
+  OpaqueKey* FindModuleKeyImpl(std::string_view module_name);
 
   void RegisterModule(Asn1ModuleBasketItem&);
+  void UnregisterModule(Asn1ModuleBasketItem&);
   Asn1ModuleBasketItem* FindModuleProvider(std::string_view name);
+  std::uint64_t CurrentDefinitionHash(std::string_view module_name, std::string_view definition_name);
+
+  void SetDependencies(Asn1ModuleBasketItem&, std::vector<Asn1DefinitionDependency>&&);
+  void InvalidateImporters(std::string_view module_name);
 
   ttcn_ast::AST TransformAST(Asn1ModuleBasketItem& item, lib::Arena& arena);
 
   std::unordered_map<OpaqueKey*, Asn1ModuleBasketItem> items_;
-  std::mutex items_mutex_;
+  mutable std::mutex items_mutex_;
   //
   std::unordered_map<std::string_view, Asn1ModuleBasketItem*> modules_;
-  std::mutex modules_mutex_;
+  mutable std::mutex modules_mutex_;
+
+  // The import graph: the items whose last transformation has looked into the module, by the module name
+  std::unordered_map<std::string, std::unordered_set<Asn1ModuleBasketItem*>> importers_;
+  std::vector<OpaqueKey*> invalidated_;  // the keys of the importers marked since ExtractInvalidated
+  mutable std::mutex importers_mutex_;
 
   std::vector<Asn1ModuleBasket*> references_;
+  std::vector<Asn1ModuleBasket*> referrers_;  // the baskets referencing this one
+
+  inline static const Asn1TransformationCache* transformation_cache_{nullptr};
 };
 
 }  // namespace vanadium::asn1::ast
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/FunctionRef.h>
+
+#include "vanadium/asn1/ast/Asn1AstTransformer.h"
+
+namespace vanadium::asn1::ast {
+
+// A definition of another module the transformation of a module has looked into
+struct Asn1DefinitionDependency {
+  std::string module_name;
+  std::string definition_name;
+  std::uint64_t definition_hash;  // 0 if it has not been found
+};
+
+// Keeps the transformed modules on disk, so that the ASN.1 sources that have not changed
+// are not transformed again by the next runs. An entry is addressed by the hash of the module source
+// and stays valid while the definitions looked up during its transformation stay the same.
+// Nothing is evicted on the way, the directory is to be trimmed upon startup (see Trim).
+class Asn1TransformationCache {
+ public:
+  using Dependency = Asn1DefinitionDependency;
+
+  // Provides the hash of the definition as it is now (module name, definition name), 0 if there is no such
+  using DefinitionHashProvider = lib::FunctionRef<std::uint64_t(std::string_view, std::string_view)>;
+
+  explicit Asn1TransformationCache(std::filesystem::path directory);
+
+  // The dependencies of the entry are put into `dependencies` if it is valid
+  std::optional<TransformedAsn1Ast> Load(std::uint64_t content_hash, DefinitionHashProvider current_hash,
+                                         std::vector<Dependency>& dependencies, lib::Arena& arena) const;
+
+  void Store(std::uint64_t content_hash, std::span<const Dependency> dependencies,
+             const TransformedAsn1Ast& transformed) const;
+
+  // Removes the least recently used entries (by their modification time, which a load renews)
+  // until the rest takes at most `max_size` bytes
+  void Trim(std::uintmax_t max_size) const;
+
+ private:
+  [[nodiscard]] std::filesystem::path EntryPath(std::uint64_t content_hash) const;
+
+  std::filesystem::path directory_;
+};
+
+}  // namespace vanadium::asn1::ast
@@ -123,8 +123,13 @@ void DebugDumpExpr(std::string_view prefix, const asn1p_expr_t* expr) {
 
 class AstTransformer {
  public:
-  AstTransformer(const asn1p_t* ast, std::string_view src, lib::Arena& arena, Asn1pModuleProvider module_provider)
-      : ast_(ast), original_src_(src), arena_(arena), get_module_(std::move(module_provider)) {
+  AstTransformer(const asn1p_t* ast, std::string_view src, lib::Arena& arena, Asn1pModuleProvider module_provider,
+                 Asn1pDefinitionObserver definition_observer)
+      : ast_(ast),
+        original_src_(src),
+        arena_(arena),
+        get_module_(std::move(module_provider)),
+        on_foreign_definition_(std::move(definition_observer)) {
     adjusted_src_.reserve(original_src_.length() + 256);
     adjusted_src_.append(original_src_);
   }
@@ -366,7 +371,7 @@ class AstTransformer {
         return nullptr;
     }
 
-    const asn1p_expr_t* clsexpr = ResolveModuleMember(ref->module, clscomp.name);
+    const asn1p_expr_t* clsexpr = FindModuleMember(ref->module, clscomp.name);
     if (!clsexpr) {
       EmitError(ConsumeRange(clscomp, ref->module), std::format("unresolved reference to '{}'", clscomp.name));
       return nullptr;
@@ -765,7 +770,7 @@ class AstTransformer {
       return true;
     }
 
-    const auto* referenced_expr = ResolveModuleMember(ref->module, name);
+    const auto* referenced_expr = FindModuleMember(ref->module, name);
     if (referenced_expr && referenced_expr->meta_type == AMT_OBJECTCLASS) {
       known_class_names_.emplace(name);
       return true;
@@ -811,7 +816,7 @@ class AstTransformer {
     return ResolveReferenceViaModule(ref->module, ref->components[0].name);
   }
   const asn1p_expr_t* ResolveReferenceViaModule(const asn1p_module_t* own_module, const char* name) {
-    if (const auto* expr = ResolveModuleMember(own_module, name); expr) {
+    if (const auto* expr = FindModuleMember(own_module, name); expr) {
       return expr;
     }
 
@@ -824,6 +829,9 @@ class AstTransformer {
           continue;
         }
 
+        if (on_foreign_definition_) {
+          on_foreign_definition_(xp->fromModuleName, name);  // the module may be missing
+        }
         const asn1p_module_t* provider_module = get_module_(xp->fromModuleName);
         if (!provider_module) {
           return nullptr;
@@ -834,6 +842,13 @@ class AstTransformer {
 
     return nullptr;
   }
+  // The references found in the definitions of the other modules are resolved in those modules as well
+  const asn1p_expr_t* FindModuleMember(const asn1p_module_t* mod, const char* name) {
+    if (on_foreign_definition_ && mod != TQ_FIRST(&(ast_->modules))) {
+      on_foreign_definition_(mod->ModuleName, name);
+    }
+    return ResolveModuleMember(mod, name);
+  }
   const asn1p_expr_t* TryResolveReferenceViaParameters(const asn1p_ref_t* ref, const ParametrizationContext* ctx) {
     if (!ctx) {
       return nullptr;
@@ -964,6 +979,7 @@ class AstTransformer {
   std::vector<TransformedAsn1Ast::TransformationError> errors_;
   lib::Arena& arena_;
   Asn1pModuleProvider get_module_;
+  Asn1pDefinitionObserver on_foreign_definition_;
 
   //
 
@@ -973,8 +989,8 @@ class AstTransformer {
 };
 
 TransformedAsn1Ast TransformAsn1Ast(const asn1p_t* ast, std::string_view src, lib::Arena& arena,
-                                    Asn1pModuleProvider module_provider) {
-  return AstTransformer(ast, src, arena, std::move(module_provider)).Transform();
+                                    Asn1pModuleProvider module_provider, Asn1pDefinitionObserver definition_observer) {
+  return AstTransformer(ast, src, arena, std::move(module_provider), std::move(definition_observer)).Transform();
 }
 
 }  // namespace vanadium::asn1::ast
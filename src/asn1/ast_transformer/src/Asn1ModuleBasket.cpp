@@ -1,8 +1,16 @@
 #include "vanadium/asn1/ast/Asn1ModuleBasket.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
 #include <mutex>
+#include <optional>
+#include <ranges>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <asn1c/libasn1parser/asn1parser_cxx.h>
@@ -11,8 +19,11 @@
 #include <vanadium/ast/ASTTypes.h>
 #include <vanadium/lib/Arena.h>
 #include <vanadium/lib/FunctionRef.h>
+#include <vanadium/lib/Hash.h>
+#include <vanadium/lib/MemoryUsage.h>
 
 #include "vanadium/asn1/ast/Asn1AstTransformer.h"
+#include "vanadium/asn1/ast/Asn1TransformationCache.h"
 
 namespace vanadium::asn1::ast {
 
@@ -27,13 +38,56 @@ std::vector<pos_t> CollectLineStarts(std::string_view src) {
   }
   return line_starts;
 }
+
+// A definition is hashed along with everything up to the next one, as only their beginnings are known.
+// The imported names are hashed as well, a lookup of such name continues in the module it is imported from.
+std::unordered_map<std::string_view, std::uint64_t> HashDefinitions(const asn1p_module_t* mod, std::string_view src) {
+  constexpr std::uint64_t kImportSeed = lib::ContentHash("IMPORTS");
+
+  std::vector<const asn1p_expr_t*> definitions;
+  const asn1p_expr_t* expr;
+  TQ_FOR(expr, &(mod->members), next) {
+    if (expr->Identifier) {
+      definitions.push_back(expr);
+    }
+  }
+  std::ranges::sort(definitions, {}, [](const asn1p_expr_t* e) {
+    return e->_Identifier_Range.begin;
+  });
+
+  std::unordered_map<std::string_view, std::uint64_t> hashes;
+  hashes.reserve(definitions.size());
+  for (std::size_t i = 0; i < definitions.size(); ++i) {
+    const std::size_t begin = std::min<std::size_t>(definitions[i]->_Identifier_Range.begin, src.size());
+    const std::size_t end =
+        i + 1 < definitions.size() ? std::min<std::size_t>(definitions[i + 1]->_Identifier_Range.begin, src.size())
+                                   : src.size();
+    hashes.emplace(definitions[i]->Identifier, lib::ContentHash(src.substr(begin, end - begin)));
+  }
+
+  const asn1p_xports_t* xp;
+  TQ_FOR(xp, &(mod->imports), xp_next) {
+    TQ_FOR(expr, &(xp->xp_members), next) {
+      if (expr->Identifier) {
+        hashes.try_emplace(expr->Identifier, lib::ContentHash(xp->fromModuleName, kImportSeed));
+      }
+    }
+  }
+
+  return hashes;
+}
 }  // namespace
 
 void Asn1ModuleBasket::AddReference(Asn1ModuleBasket* ref) {
   references_.emplace_back(ref);
+  ref->referrers_.emplace_back(this);
 }
 
-void Asn1ModuleBasket::UpdateImpl(OpaqueKey* key, std::string_view src) {
+void Asn1ModuleBasket::SetTransformationCache(const Asn1TransformationCache* cache) {
+  transformation_cache_ = cache;
+}
+
+void Asn1ModuleBasket::UpdateImpl(OpaqueKey* key, std::string_view src, bool cacheable) {
   decltype(items_)::iterator it;
   bool inserted;
   {
@@ -42,14 +96,23 @@ void Asn1ModuleBasket::UpdateImpl(OpaqueKey* key, std::string_view src) {
   }
   auto& item = it->second;
 
-  if (!inserted) {
-    item.arena.Reset();
+  std::optional<std::string> previous_module_name;
+  if (inserted) {
+    item.key = key;
+  } else {
     if (item.module_name) {
-      modules_.erase(*item.module_name);
+      previous_module_name.emplace(*item.module_name);
     }
+    UnregisterModule(item);
+    item.definition_hashes.clear();
+    item.ast = std::nullopt;  // it walks the tree allocated on the arena when destroyed
+    item.arena.Reset();
   }
 
+  item.transformed = false;
   item.src = src;
+  item.content_hash = lib::ContentHash(src);
+  item.cacheable = cacheable;
   item.lines = ttcn_ast::LineMapping(CollectLineStarts(src));
   if (auto result = Parse(item.arena, src)) {
     item.ast = std::move(result);
@@ -59,28 +122,173 @@ void Asn1ModuleBasket::UpdateImpl(OpaqueKey* key, std::string_view src) {
     item.ast = std::nullopt;
     item.errors = std::move(result.ErrorsMut());
   }
+
+  if (previous_module_name && previous_module_name != item.module_name) {
+    InvalidateImporters(*previous_module_name);
+  }
+  if (item.module_name) {
+    InvalidateImporters(*item.module_name);
+  }
 }
 
 void Asn1ModuleBasket::RegisterModule(Asn1ModuleBasketItem& item) {
   if (const asn1p_module_t* mod = TQ_FIRST(&(item.ast->Raw()->modules)); mod) {
+    item.definition_hashes = HashDefinitions(mod, item.src);
+
+    std::lock_guard lock(modules_mutex_);
     item.module_name = mod->ModuleName;
+    // a duplicate stays unregistered until the module is gone from the other file (see TransformImpl)
+    modules_.try_emplace(*item.module_name, &item);
+  }
+}
+
+void Asn1ModuleBasket::UnregisterModule(Asn1ModuleBasketItem& item) {
+  std::lock_guard items_lock(items_mutex_);
+  std::lock_guard lock(modules_mutex_);
+  if (!item.module_name) {
+    return;
+  }
 
-    {
-      std::lock_guard lock(modules_mutex_);
-      auto it = modules_.find(*item.module_name);
-      if (it == modules_.end()) {
-        modules_.emplace(*item.module_name, &item);
-        return;
+  const auto module_name = *std::exchange(item.module_name, std::nullopt);
+  if (auto it = modules_.find(module_name); it != modules_.end() && it->second == &item) {
+    modules_.erase(it);
+
+    // the file defining the same module takes its place, e.g. when the file has been renamed
+    for (auto& other : items_ | std::views::values) {
+      if (&other != &item && other.module_name == module_name) {
+        modules_.emplace(*other.module_name, &other);
+        break;
       }
     }
+  }
+}
 
-    item.errors.emplace_back(Asn1cSyntaxError{
-        .range = {},
-        .message = std::format("module '{}' is already defined in another file", *item.module_name),
-    });
+void Asn1ModuleBasket::DropImpl(OpaqueKey* key) {
+  decltype(items_)::node_type node;
+  {
+    std::lock_guard lock(items_mutex_);
+    node = items_.extract(key);
+  }
+  if (!node) {
+    return;
+  }
+
+  auto& item = node.mapped();
+  std::optional<std::string> module_name;
+  if (item.module_name) {
+    module_name.emplace(*item.module_name);
+  }
+
+  UnregisterModule(item);
+  SetDependencies(item, {});
+  {
+    std::lock_guard lock(importers_mutex_);
+    std::erase(invalidated_, key);
+  }
+
+  if (module_name) {
+    InvalidateImporters(*module_name);
+  }
+}
+
+void Asn1ModuleBasket::SetDependencies(Asn1ModuleBasketItem& item, std::vector<Asn1DefinitionDependency>&& deps) {
+  std::lock_guard lock(importers_mutex_);
+  for (const auto& dep : item.dependencies) {
+    if (auto it = importers_.find(dep.module_name); it != importers_.end()) {
+      it->second.erase(&item);
+      if (it->second.empty()) {
+        importers_.erase(it);
+      }
+    }
+  }
+  item.dependencies = std::move(deps);
+  for (const auto& dep : item.dependencies) {
+    importers_[dep.module_name].insert(&item);
+  }
+  item.dependencies_changed = false;
+}
+
+// Only marks the importers, they are checked precisely once they are asked about (see NeedsTransformImpl)
+void Asn1ModuleBasket::InvalidateImporters(std::string_view module_name) {
+  const std::string name(module_name);
+  const auto invalidate = [&](Asn1ModuleBasket& basket) {
+    std::lock_guard lock(basket.importers_mutex_);
+    if (auto it = basket.importers_.find(name); it != basket.importers_.end()) {
+      for (auto* importer : it->second) {
+        if (!std::exchange(importer->dependencies_changed, true)) {
+          basket.invalidated_.push_back(importer->key);
+        }
+      }
+    }
+  };
+  invalidate(*this);
+  for (auto* referrer : referrers_) {  // they are bound transitively
+    invalidate(*referrer);
   }
 }
 
+bool Asn1ModuleBasket::NeedsTransformImpl(OpaqueKey* key) {
+  auto& item = items_.at(key);
+  {
+    std::lock_guard lock(importers_mutex_);
+    if (!item.transformed) {
+      return true;
+    }
+    if (!std::exchange(item.dependencies_changed, false)) {
+      return false;
+    }
+  }
+  return std::ranges::any_of(item.dependencies, [&](const Asn1DefinitionDependency& dep) {
+    return dep.definition_hash != CurrentDefinitionHash(dep.module_name, dep.definition_name);
+  });
+}
+
+std::vector<Asn1ModuleBasket::OpaqueKey*> Asn1ModuleBasket::ExtractInvalidatedImpl() {
+  std::lock_guard lock(importers_mutex_);
+  return std::exchange(invalidated_, {});
+}
+
+std::size_t Asn1ModuleBasket::SpaceAllocated() const {
+  std::lock_guard lock(items_mutex_);
+  std::size_t total{0};
+  for (const auto& item : items_ | std::views::values) {
+    total += item.arena.SpaceAllocated();
+  }
+  return total;
+}
+
+std::size_t Asn1ModuleBasket::HeapUsage() const {
+  std::size_t total{0};
+  {
+    std::lock_guard lock(items_mutex_);
+    total += lib::HeapUsage(items_);
+    for (const auto& item : items_ | std::views::values) {
+      total += item.lines.Count() * sizeof(pos_t);
+      total += lib::HeapUsage(item.errors);
+      for (const auto& error : item.errors) {
+        total += lib::HeapUsage(error.message);
+      }
+      total += lib::HeapUsage(item.definition_hashes);
+      total += lib::HeapUsage(item.dependencies);
+      for (const auto& dep : item.dependencies) {
+        total += lib::HeapUsage(dep.module_name) + lib::HeapUsage(dep.definition_name);
+      }
+    }
+  }
+  {
+    std::lock_guard lock(modules_mutex_);
+    total += lib::HeapUsage(modules_);
+  }
+  {
+    std::lock_guard lock(importers_mutex_);
+    total += lib::HeapUsage(importers_) + lib::HeapUsage(invalidated_);
+    for (const auto& [module_name, importers] : importers_) {
+      total += lib::HeapUsage(module_name) + lib::HeapUsage(importers);
+    }
+  }
+  return total;
+}
+
 Asn1ModuleBasketItem* Asn1ModuleBasket::FindModuleProvider(std::string_view name) {
   if (auto it = modules_.find(name); it != modules_.end()) {
     return it->second;
@@ -93,8 +301,26 @@ Asn1ModuleBasketItem* Asn1ModuleBasket::FindModuleProvider(std::string_view name
   return nullptr;
 }
 
+std::uint64_t Asn1ModuleBasket::CurrentDefinitionHash(std::string_view module_name, std::string_view definition_name) {
+  const auto* provider = FindModuleProvider(module_name);
+  if (!provider) {
+    return 0;
+  }
+  const auto it = provider->definition_hashes.find(definition_name);
+  return it != provider->definition_hashes.end() ? it->second : 0;
+}
+
+Asn1ModuleBasket::OpaqueKey* Asn1ModuleBasket::FindModuleKeyImpl(std::string_view module_name) {
+  std::lock_guard lock(modules_mutex_);
+  if (auto it = modules_.find(module_name); it != modules_.end()) {
+    return it->second->key;
+  }
+  return nullptr;
+}
+
 ttcn_ast::AST Asn1ModuleBasket::TransformImpl(OpaqueKey* key, lib::Arena& arena) {
-  const auto& item = items_.at(key);
+  auto& item = items_.at(key);
+  item.transformed = true;
 
   std::vector<ttcn_ast::SyntaxError> errors;
   errors.reserve(item.errors.size());
@@ -105,8 +331,15 @@ ttcn_ast::AST Asn1ModuleBasket::TransformImpl(OpaqueKey* key, lib::Arena& arena)
         .description = err.message,
     });
   }
+  if (item.module_name && FindModuleKeyImpl(*item.module_name) != key) {
+    errors.emplace_back(ttcn_ast::SyntaxError{
+        .range = {},
+        .description = std::format("module '{}' is already defined in another file", *item.module_name),
+    });
+  }
 
   if (!item.ast) {
+    SetDependencies(item, {});
     return {
         .src = item.src,
         .root =
@@ -120,18 +353,51 @@ ttcn_ast::AST Asn1ModuleBasket::TransformImpl(OpaqueKey* key, lib::Arena& arena)
     };
   }
 
-  auto transformed_ast = TransformAsn1Ast(item.ast->Raw(), item.src, arena,
-                                          [&](const char* required_module_name) -> const asn1p_module_t* {
-                                            const auto* provider = FindModuleProvider(required_module_name);
-                                            if (!provider) {
-                                              return nullptr;
-                                            }
-                                            return TQ_FIRST(&(provider->ast->Raw()->modules));
-                                          });
+  const auto* cache = transformation_cache_;
+  const auto current_hash = [&](std::string_view module_name, std::string_view definition_name) {
+    return CurrentDefinitionHash(module_name, definition_name);
+  };
+
+  std::vector<Asn1DefinitionDependency> dependencies;
+  std::optional<TransformedAsn1Ast> transformed_ast;
+  if (cache) {
+    transformed_ast = cache->Load(item.content_hash, current_hash, dependencies, arena);
+  }
+
+  if (!transformed_ast) {
+    std::vector<std::pair<std::string_view, std::string_view>> looked_up;  // the names are owned by the asn1c trees
+    transformed_ast = TransformAsn1Ast(
+        item.ast->Raw(), item.src, arena,
+        [&](const char* required_module_name) -> const asn1p_module_t* {
+          const auto* provider = FindModuleProvider(required_module_name);
+          if (!provider) {
+            return nullptr;
+          }
+          return TQ_FIRST(&(provider->ast->Raw()->modules));
+        },
+        [&](const char* module_name, const char* definition_name) {
+          looked_up.emplace_back(module_name, definition_name);
+        });
+
+    std::ranges::sort(looked_up);
+    looked_up.erase(std::ranges::unique(looked_up).begin(), looked_up.end());
+
+    dependencies.reserve(looked_up.size());
+    for (const auto& [module_name, definition_name] : looked_up) {
+      dependencies.emplace_back(std::string(module_name), std::string(definition_name),
+                                current_hash(module_name, definition_name));
+    }
+
+    if (cache && item.cacheable) {
+      cache->Store(item.content_hash, dependencies, *transformed_ast);
+    }
+  }
+
+  SetDependencies(item, std::move(dependencies));
 
-  errors.reserve(errors.size() + transformed_ast.errors.size());
+  errors.reserve(errors.size() + transformed_ast->errors.size());
   //
-  for (auto& err : transformed_ast.errors) {
+  for (auto& err : transformed_ast->errors) {
     errors.emplace_back(ttcn_ast::SyntaxError{
         .range = err.range,
         .description = std::move(err.message),
@@ -139,8 +405,8 @@ ttcn_ast::AST Asn1ModuleBasket::TransformImpl(OpaqueKey* key, lib::Arena& arena)
   }
 
   return {
-      .src = transformed_ast.adjusted_src,
-      .root = transformed_ast.root,
+      .src = transformed_ast->adjusted_src,
+      .root = transformed_ast->root,
       .lines = item.lines,
       .errors = std::move(errors),
   };
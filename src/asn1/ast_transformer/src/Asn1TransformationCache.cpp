@@ -0,0 +1,219 @@
+#include "vanadium/asn1/ast/Asn1TransformationCache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vanadium/ast/ASTSerializer.h>
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/BinaryStream.h>
+#include <vanadium/lib/Hash.h>
+
+#include "vanadium/asn1/ast/Asn1AstTransformer.h"
+
+// Entry layout: header, dependencies, adjusted source, errors, the tree, and the checksum of all of that
+
+namespace vanadium::asn1::ast {
+
+namespace {
+constexpr std::uint32_t kMagic = 0x4e534156;  // "VASN"
+constexpr std::uint32_t kFormatVersion = 2;
+
+constexpr std::string_view kEntryExtension = ".vast";
+// The entries written by the processes that have been killed meanwhile, see Store
+constexpr std::string_view kTemporaryExtension = ".tmp";
+constexpr auto kTemporaryFileLifetime = std::chrono::hours(1);
+
+// The transformation depends on the enabled compiler extensions as well
+std::uint64_t TransformationFlags() {
+  return compilerExtensions::eag_grouping ? 1 : 0;
+}
+
+std::optional<std::string> ReadFile(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return std::nullopt;
+  }
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+}  // namespace
+
+Asn1TransformationCache::Asn1TransformationCache(std::filesystem::path directory) : directory_(std::move(directory)) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+}
+
+std::filesystem::path Asn1TransformationCache::EntryPath(std::uint64_t content_hash) const {
+  return directory_ / std::format("{:016x}{}", content_hash, kEntryExtension);
+}
+
+std::optional<TransformedAsn1Ast> Asn1TransformationCache::Load(std::uint64_t content_hash,
+                                                                DefinitionHashProvider current_hash,
+                                                                std::vector<Dependency>& dependencies,
+                                                                lib::Arena& arena) const {
+  const auto path = EntryPath(content_hash);
+  const auto data = ReadFile(path);
+  if (!data || data->size() < sizeof(std::uint64_t)) {
+    return std::nullopt;
+  }
+
+  const std::string_view contents = std::string_view{*data}.substr(0, data->size() - sizeof(std::uint64_t));
+  lib::BinaryReader checksum_reader(std::string_view{*data}.substr(contents.size()));
+  if (checksum_reader.Fixed<std::uint64_t>() != lib::ContentHash(contents)) {
+    return std::nullopt;
+  }
+
+  lib::BinaryReader in(contents);
+  if (in.Fixed<std::uint32_t>() != kMagic || in.Fixed<std::uint32_t>() != kFormatVersion ||
+      in.Fixed<std::uint64_t>() != content_hash || in.Varint() != TransformationFlags()) {
+    return std::nullopt;
+  }
+
+  std::vector<Dependency> entry_dependencies;
+  for (auto n = in.Varint(); n > 0 && !in.Failed(); --n) {
+    auto& dep = entry_dependencies.emplace_back();
+    dep.module_name = in.Bytes();
+    dep.definition_name = in.Bytes();
+    dep.definition_hash = in.Fixed<std::uint64_t>();
+    if (dep.definition_hash != current_hash(dep.module_name, dep.definition_name)) {
+      return std::nullopt;
+    }
+  }
+
+  const auto src = in.Bytes();
+  const auto adjusted_src = arena.AllocStringBuffer(src.size());
+  std::ranges::copy(src, adjusted_src.begin());
+
+  TransformedAsn1Ast transformed{
+      .adjusted_src = {adjusted_src.data(), adjusted_src.size()},
+      .root = nullptr,
+      .errors = {},
+  };
+
+  for (auto n = in.Varint(); n > 0 && !in.Failed(); --n) {
+    auto& err = transformed.errors.emplace_back();
+    err.range.begin = static_cast<ttcn_ast::pos_t>(in.Varint());
+    err.range.end = static_cast<ttcn_ast::pos_t>(in.Varint());
+    err.message = in.Bytes();
+  }
+
+  transformed.root = ttcn_ast::DeserializeTree(in, arena);
+  if (transformed.root == nullptr || in.Failed()) {
+    return std::nullopt;
+  }
+
+  dependencies = std::move(entry_dependencies);
+
+  std::error_code ec;  // the entry is just used less recently for Trim otherwise
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+
+  return transformed;
+}
+
+void Asn1TransformationCache::Store(std::uint64_t content_hash, std::span<const Dependency> dependencies,
+                                    const TransformedAsn1Ast& transformed) const {
+  std::string buf;
+  lib::BinaryWriter out(buf);
+
+  out.Fixed(kMagic);
+  out.Fixed(kFormatVersion);
+  out.Fixed(content_hash);
+  out.Varint(TransformationFlags());
+
+  out.Varint(dependencies.size());
+  for (const auto& dep : dependencies) {
+    out.Bytes(dep.module_name);
+    out.Bytes(dep.definition_name);
+    out.Fixed(dep.definition_hash);
+  }
+
+  out.Bytes(transformed.adjusted_src);
+
+  out.Varint(transformed.errors.size());
+  for (const auto& err : transformed.errors) {
+    out.Varint(err.range.begin);
+    out.Varint(err.range.end);
+    out.Bytes(err.message);
+  }
+
+  ttcn_ast::SerializeTree(transformed.root, out);
+
+  out.Fixed(lib::ContentHash(buf));
+
+  // the entry is published by renaming, so that the concurrent readers never see it incomplete
+  const auto path = EntryPath(content_hash);
+  auto tmp_path = path;
+  tmp_path += std::format(".{}-{}{}", ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id()),
+                          kTemporaryExtension);
+  {
+    std::ofstream tmp(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!tmp.write(buf.data(), static_cast<std::streamsize>(buf.size()))) {
+      std::error_code ec;
+      std::filesystem::remove(tmp_path, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+  }
+}
+
+void Asn1TransformationCache::Trim(std::uintmax_t max_size) const {
+  struct Entry {
+    std::filesystem::file_time_type last_use;
+    std::uintmax_t size;
+    std::filesystem::path path;
+  };
+  std::vector<Entry> entries;
+
+  const auto now = std::filesystem::file_time_type::clock::now();
+  std::error_code ec;
+  for (const auto& dirent : std::filesystem::directory_iterator(directory_, ec)) {
+    if (!dirent.is_regular_file(ec)) {
+      continue;
+    }
+    const auto last_use = dirent.last_write_time(ec);
+    if (ec) {
+      continue;
+    }
+    const auto extension = dirent.path().extension();
+    if (extension == kTemporaryExtension) {
+      if (now - last_use > kTemporaryFileLifetime) {
+        std::filesystem::remove(dirent.path(), ec);
+      }
+    } else if (extension == kEntryExtension) {
+      if (const auto size = dirent.file_size(ec); !ec) {
+        entries.emplace_back(last_use, size, dirent.path());
+      }
+    }
+  }
+
+  std::ranges::sort(entries, std::ranges::greater{}, &Entry::last_use);
+
+  std::uintmax_t kept_size{0};
+  for (const auto& entry : entries) {
+    kept_size += entry.size;
+    if (kept_size > max_size) {
+      std::filesystem::remove(entry.path, ec);
+    }
+  }
+}
+
+}  // namespace vanadium::asn1::ast
@@ -1 +1,291 @@
 #include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vanadium/ast/ASTSerializer.h>
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/BinaryStream.h>
+#include <vanadium/lib/Hash.h>
+
+#include "vanadium/asn1/ast/Asn1ModuleBasket.h"
+#include "vanadium/asn1/ast/Asn1TransformationCache.h"
+
+using namespace vanadium;
+using namespace vanadium::asn1::ast;
+
+namespace {
+constexpr std::string_view kAsnSource = R"(
+  Test DEFINITIONS AUTOMATIC TAGS ::=
+  BEGIN
+
+  Kind ::= ENUMERATED { first, second }
+
+  Item ::= SEQUENCE {
+    kind  Kind,
+    value INTEGER OPTIONAL,
+    tags  SEQUENCE OF UTF8String
+  }
+
+  END
+)";
+
+class TemporaryDirectory {
+ public:
+  TemporaryDirectory()
+      : path_(std::filesystem::temp_directory_path() /
+              std::format("vanadium-{}-{}", ::getpid(), ::testing::UnitTest::GetInstance()->random_seed())) {
+    std::filesystem::remove_all(path_);
+  }
+  ~TemporaryDirectory() {
+    std::filesystem::remove_all(path_);
+  }
+
+  [[nodiscard]] const std::filesystem::path& Path() const {
+    return path_;
+  }
+
+ private:
+  std::filesystem::path path_;
+};
+
+std::string Serialize(const ttcn_ast::RootNode* root) {
+  std::string buf;
+  lib::BinaryWriter writer(buf);
+  ttcn_ast::SerializeTree(root, writer);
+  return buf;
+}
+
+ttcn_ast::AST TransformWith(const Asn1TransformationCache* cache, lib::Arena& arena, bool cacheable = true) {
+  int key{0};
+  Asn1ModuleBasket basket;
+  Asn1ModuleBasket::SetTransformationCache(cache);
+  basket.Update(&key, kAsnSource, cacheable);
+  auto ast = basket.Transform(&key, arena);
+  Asn1ModuleBasket::SetTransformationCache(nullptr);
+  return ast;
+}
+}  // namespace
+
+TEST(Asn1ModuleBasketTest, TransformationCacheReproducesTransformedAst) {
+  const TemporaryDirectory dir;
+  const Asn1TransformationCache cache(dir.Path());
+
+  lib::Arena uncached_arena;
+  const auto uncached = TransformWith(nullptr, uncached_arena);
+  ASSERT_TRUE(uncached.errors.empty());
+
+  lib::Arena stored_arena;
+  const auto stored = TransformWith(&cache, stored_arena);
+  ASSERT_FALSE(std::filesystem::is_empty(dir.Path()));
+
+  lib::Arena loaded_arena;
+  const auto loaded = TransformWith(&cache, loaded_arena);
+
+  for (const auto* ast : {&stored, &loaded}) {
+    EXPECT_EQ(ast->src, uncached.src);
+    EXPECT_EQ(Serialize(ast->root), Serialize(uncached.root));
+    EXPECT_TRUE(ast->errors.empty());
+  }
+  EXPECT_NE(loaded.src.data(), stored.src.data());
+}
+
+TEST(Asn1ModuleBasketTest, TransformationCacheSkipsUncacheableSources) {
+  const TemporaryDirectory dir;
+  const Asn1TransformationCache cache(dir.Path());
+
+  lib::Arena arena;
+  const auto transformed = TransformWith(&cache, arena, false);
+  ASSERT_TRUE(transformed.errors.empty());
+  EXPECT_TRUE(std::filesystem::is_empty(dir.Path()));
+}
+
+TEST(Asn1ModuleBasketTest, TransformationCacheTrimsLeastRecentlyUsed) {
+  const TemporaryDirectory dir;
+  const Asn1TransformationCache cache(dir.Path());
+
+  const auto now = std::filesystem::file_time_type::clock::now();
+  const auto put = [&](std::string_view name, std::chrono::hours age) {
+    const auto path = dir.Path() / name;
+    std::ofstream(path) << std::string(100, 'x');
+    std::filesystem::last_write_time(path, now - age);
+    return path;
+  };
+  const auto oldest = put("0000000000000001.vast", std::chrono::hours(3));
+  const auto older = put("0000000000000002.vast", std::chrono::hours(2));
+  const auto newest = put("0000000000000003.vast", std::chrono::hours(0));
+  const auto abandoned = put("0000000000000004.vast.1-1.tmp", std::chrono::hours(2));
+  const auto written = put("0000000000000005.vast.1-2.tmp", std::chrono::hours(0));
+
+  cache.Trim(250);
+
+  EXPECT_FALSE(std::filesystem::exists(oldest));
+  EXPECT_TRUE(std::filesystem::exists(older));
+  EXPECT_TRUE(std::filesystem::exists(newest));
+  EXPECT_FALSE(std::filesystem::exists(abandoned));
+  EXPECT_TRUE(std::filesystem::exists(written));  // may still be in progress
+
+  cache.Trim(0);
+  EXPECT_FALSE(std::filesystem::exists(older));
+  EXPECT_FALSE(std::filesystem::exists(newest));
+}
+
+TEST(Asn1ModuleBasketTest, TransformationCacheTracksDependencies) {
+  const TemporaryDirectory dir;
+  const Asn1TransformationCache cache(dir.Path());
+
+  lib::Arena arena;
+  const auto transformed = TransformWith(nullptr, arena);
+
+  const std::uint64_t content_hash = lib::ContentHash(kAsnSource);
+  const std::uint64_t definition_hash = lib::ContentHash("Other ::= INTEGER");
+  const Asn1DefinitionDependency dependencies[] = {
+      {.module_name = "Other", .definition_name = "Other", .definition_hash = definition_hash},
+  };
+  cache.Store(content_hash, dependencies,
+              TransformedAsn1Ast{.adjusted_src = transformed.src, .root = transformed.root, .errors = {}});
+
+  const auto load = [&](std::uint64_t current_definition_hash) {
+    lib::Arena load_arena;
+    std::vector<Asn1DefinitionDependency> loaded_dependencies;
+    const bool loaded = cache
+                            .Load(
+                                content_hash,
+                                [&](std::string_view module_name, std::string_view definition_name) -> std::uint64_t {
+                                  return module_name == "Other" && definition_name == "Other"
+                                             ? current_definition_hash
+                                             : 0;
+                                },
+                                loaded_dependencies, load_arena)
+                            .has_value();
+    EXPECT_EQ(loaded_dependencies.size(), loaded ? 1 : 0);
+    return loaded;
+  };
+
+  EXPECT_TRUE(load(definition_hash));
+  EXPECT_FALSE(load(definition_hash + 1));
+  EXPECT_FALSE(load(0));  // the definition is gone
+
+  lib::Arena load_arena;
+  std::vector<Asn1DefinitionDependency> loaded_dependencies;
+  EXPECT_FALSE(cache.Load(
+      content_hash + 1,
+      [](std::string_view, std::string_view) -> std::uint64_t {
+        return 0;
+      },
+      loaded_dependencies, load_arena));
+}
+
+TEST(Asn1ModuleBasketTest, ChangedDefinitionRetransformsItsUsersOnly) {
+  constexpr std::string_view kDefs = R"(
+    Defs DEFINITIONS ::= BEGIN
+    Container {Type} ::= SEQUENCE { value Type }
+    Pair {Type} ::= SEQUENCE { first Type, second Type }
+    END
+  )";
+  constexpr std::string_view kDefsWithChangedPair = R"(
+    Defs DEFINITIONS ::= BEGIN
+    Container {Type} ::= SEQUENCE { value Type }
+    Pair {Type} ::= SEQUENCE { first Type, second Type, third Type OPTIONAL }
+    END
+  )";
+  constexpr std::string_view kUsesContainer = R"(
+    UsesContainer DEFINITIONS ::= BEGIN
+    IMPORTS Container FROM Defs;
+    Item ::= Container {INTEGER}
+    END
+  )";
+  constexpr std::string_view kUsesPair = R"(
+    UsesPair DEFINITIONS ::= BEGIN
+    IMPORTS Pair FROM Defs;
+    Item ::= Pair {BOOLEAN}
+    END
+  )";
+
+  Asn1ModuleBasket basket;
+  int defs{}, uses_container{}, uses_pair{};
+  basket.Update(&defs, kDefs);
+  basket.Update(&uses_container, kUsesContainer);
+  basket.Update(&uses_pair, kUsesPair);
+
+  lib::Arena arena;
+  for (auto* key : {&defs, &uses_container, &uses_pair}) {
+    EXPECT_TRUE(basket.NeedsTransform(key));
+    basket.Transform(key, arena);
+  }
+  for (auto* key : {&defs, &uses_container, &uses_pair}) {
+    EXPECT_FALSE(basket.NeedsTransform(key));
+  }
+
+  basket.Update(&defs, kDefsWithChangedPair);
+  EXPECT_TRUE(basket.NeedsTransform(&defs));
+  EXPECT_FALSE(basket.NeedsTransform(&uses_container));
+  EXPECT_TRUE(basket.NeedsTransform(&uses_pair));
+
+  basket.Transform(&defs, arena);
+  basket.Transform(&uses_pair, arena);
+  EXPECT_FALSE(basket.NeedsTransform(&uses_pair));
+
+  basket.Update(&defs, kDefsWithChangedPair);  // the same contents
+  EXPECT_FALSE(basket.NeedsTransform(&uses_container));
+  EXPECT_FALSE(basket.NeedsTransform(&uses_pair));
+
+  basket.Drop(&defs);
+  EXPECT_TRUE(basket.NeedsTransform(&uses_container));
+  EXPECT_TRUE(basket.NeedsTransform(&uses_pair));
+}
+
+TEST(Asn1ModuleBasketTest, DropReleasesModules) {
+  constexpr std::size_t kFiles = 16;
+  constexpr std::size_t kRounds = 8;
+
+  std::vector<std::string> sources;
+  for (std::size_t i = 0; i < kFiles; ++i) {
+    sources.emplace_back(std::format("Module{} DEFINITIONS ::= BEGIN Value{} ::= INTEGER END", i, i));
+  }
+
+  Asn1ModuleBasket basket;
+  std::array<int, kFiles * 2> keys{};
+
+  std::optional<std::size_t> space_per_round;
+  for (std::size_t round = 0; round < kRounds; ++round) {
+    // the files are renamed each round, as on switching between the branches
+    auto* const current_keys = keys.data() + (round % 2) * kFiles;
+    auto* const previous_keys = keys.data() + ((round + 1) % 2) * kFiles;
+    for (std::size_t i = 0; i < kFiles; ++i) {
+      if (round > 0) {
+        basket.Drop(&previous_keys[i]);
+      }
+      basket.Update(&current_keys[i], sources[i]);
+    }
+
+    for (std::size_t i = 0; i < kFiles; ++i) {
+      EXPECT_EQ(basket.FindModuleKey<int>(std::format("Module{}", i)), &current_keys[i]);
+    }
+    EXPECT_EQ(std::ranges::distance(basket.Keys<int>()), kFiles);
+
+    const auto space = basket.SpaceAllocated();
+    if (!space_per_round) {
+      space_per_round = space;
+    }
+    EXPECT_EQ(space, *space_per_round) << "round " << round;
+  }
+
+  for (auto& key : keys) {
+    basket.Drop(&key);
+  }
+  EXPECT_EQ(basket.SpaceAllocated(), 0);
+  EXPECT_EQ(basket.FindModuleKey<int>("Module0"), nullptr);
+}
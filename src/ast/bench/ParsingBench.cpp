@@ -0,0 +1,76 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <vanadium/bench/BenchUtils.h>
+#include <vanadium/bench/Corpus.h>
+#include <vanadium/lib/Arena.h>
+
+#include "vanadium/ast/AST.h"
+#include "vanadium/ast/ASTNodes.h"
+#include "vanadium/ast/Parser.h"
+#include "vanadium/ast/Scanner.h"
+
+namespace {
+
+using namespace vanadium;
+using namespace vanadium::bench;
+
+std::size_t CountNodes(const ast::RootNode* root) {
+  std::size_t nodes{1};
+  root->Accept([&](const ast::Node*) {
+    ++nodes;
+    return true;
+  });
+  return nodes;
+}
+
+void BM_Scan(benchmark::State& state) {
+  const auto& corpus = CachedCorpus(UseCorpusShape(state));
+
+  std::size_t tokens{0};
+  for (auto _ : state) {
+    for (const auto& file : corpus) {
+      if (IsAsnFile(file.path)) {
+        continue;
+      }
+      ast::parser::Scanner scanner(file.src);
+      while (scanner.Scan().kind != ast::TokenKind::kEOF) {
+        ++tokens;
+      }
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * TtcnBytes(corpus)));
+  state.counters["tokens"] = benchmark::Counter(static_cast<double>(tokens), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Scan)->Apply(ApplyCorpusShapes);
+
+void BM_Parse(benchmark::State& state) {
+  const auto& corpus = CachedCorpus(UseCorpusShape(state));
+
+  lib::Arena arena;
+  std::size_t nodes{0};
+  for (const auto& file : corpus) {
+    if (!IsAsnFile(file.path)) {
+      arena.Reset();
+      nodes += CountNodes(ast::Parse(arena, file.src).root);
+    }
+  }
+
+  for (auto _ : state) {
+    for (const auto& file : corpus) {
+      if (IsAsnFile(file.path)) {
+        continue;
+      }
+      arena.Reset();
+      benchmark::DoNotOptimize(ast::Parse(arena, file.src));
+    }
+  }
+
+  ReportThroughput(state, TtcnBytes(corpus), nodes);
+}
+BENCHMARK(BM_Parse)->Apply(ApplyCorpusShapes);
+
+}  // namespace
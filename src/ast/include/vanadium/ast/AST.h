@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string_view>
 #include <vector>
 
@@ -32,6 +33,8 @@ struct AST {
   RootNode* root;
   LineMapping lines;
   std::vector<SyntaxError> errors;
+  std::vector<Token> trivia;  // comments and preprocessor directives in the order of appearance, see Parser::Tokenize
+  std::span<const Token> tokens;  // the rest of the tokens, in the arena of the AST and ending with kEOF, if parsed
 
   [[nodiscard]] std::string_view Text(const Node* n) const noexcept {
     return n->On(src);
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/BinaryStream.h>
+
+#include "vanadium/ast/AST.h"
+
+namespace vanadium::ast {
+
+#include "vanadium/ast/gen/ASTSchema.inc"
+
+// Compact binary form of a syntax tree, so that it can be kept across the runs.
+// Neither the source text nor RootNode::file are included, the ranges keep referring to the original source.
+void SerializeTree(const RootNode* root, lib::BinaryWriter& out);
+
+// Restores the tree written by SerializeTree into the arena.
+// Returns nullptr if the input is malformed or has been written with another nodes schema
+RootNode* DeserializeTree(lib::BinaryReader& in, lib::Arena& arena);
+
+}  // namespace vanadium::ast
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <string_view>
 #include <type_traits>
 
@@ -21,6 +22,10 @@ class Parser {
   RootNode* ParseRoot();
   std::vector<SyntaxError>&& GetErrors() noexcept;
   std::vector<pos_t>&& ExtractLineMapping() noexcept;
+  std::vector<Token>&& ExtractTrivia() noexcept;
+  [[nodiscard]] std::span<const Token> Tokens() const noexcept {
+    return tokens_;
+  }
 
  private:
   Node* Parse();
@@ -148,7 +153,7 @@ class Parser {
 
   Token Consume();
   Token ConsumeInvariant(TokenKind);
-  void Grow(std::uint8_t n);
+  void Tokenize();
   Token& Peek(std::uint8_t i);
   std::string_view Lit(std::uint8_t i);
   Token Expect(TokenKind expected);
@@ -188,13 +193,16 @@ class Parser {
 
   std::vector<SyntaxError> errors_;
 
+  // The source is scanned at once beforehand, so the lookahead and the speculation are just the moves of the cursor
+  std::span<Token> tokens_;  // in the arena, ends with kEOF
   ast::pos_t cursor_{};
   std::vector<ast::pos_t> markers_;
 
   TokenKind tok_;
-  std::vector<Token> queue_;
   ast::pos_t last_consumed_pos_;
 
+  std::vector<Token> trivia_;
+
   Scanner scanner_;
   std::string_view src_;
 
@@ -211,6 +219,8 @@ inline AST Parse(lib::Arena& arena, std::string_view src) {
       .root = root,
       .lines = parser.ExtractLineMapping(),
       .errors = parser.GetErrors(),
+      .trivia = parser.ExtractTrivia(),
+      .tokens = parser.Tokens(),
   };
 }
 
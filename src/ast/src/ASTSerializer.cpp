@@ -0,0 +1,404 @@
+#include "vanadium/ast/ASTSerializer.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/BinaryStream.h>
+
+#include "vanadium/ast/AST.h"
+#include "vanadium/ast/ASTNodes.h"
+#include "vanadium/ast/ASTTypes.h"
+
+// Every node gets an index in the order of the traversal, the pointers are stored as references:
+//   0 - nullptr, 1 - the node follows in place, k + 2 - the node already seen with the index k.
+// The parents are written separately after the tree, as they are not always the enclosing nodes.
+
+namespace vanadium::ast {
+
+namespace {
+
+enum NodeRef : std::uint64_t {
+  kNullRef = 0,
+  kInplaceRef = 1,
+  kFirstBackRef = 2,
+};
+
+// The abstract node types a field may be declared with, besides the concrete ones
+enum class NodeBase : std::uint8_t {
+  kExpr = 1 << 0,
+  kStmt = 1 << 1,
+  kDecl = 1 << 2,
+  kTypeSpec = 1 << 3,
+  kIdent = 1 << 4,  // the only concrete node that others derive from
+};
+
+template <IsNode T>
+[[nodiscard]] constexpr std::optional<NodeBase> AsNodeBase() {
+  if constexpr (std::is_same_v<T, nodes::Expr>) {
+    return NodeBase::kExpr;
+  } else if constexpr (std::is_same_v<T, nodes::Stmt>) {
+    return NodeBase::kStmt;
+  } else if constexpr (std::is_same_v<T, nodes::Decl>) {
+    return NodeBase::kDecl;
+  } else if constexpr (std::is_same_v<T, nodes::TypeSpec>) {
+    return NodeBase::kTypeSpec;
+  } else if constexpr (std::is_same_v<T, nodes::Ident>) {
+    return NodeBase::kIdent;
+  } else {
+    return std::nullopt;
+  }
+}
+
+template <IsNode T>
+[[nodiscard]] constexpr std::uint8_t NodeBasesOf() {
+  std::uint8_t bases{0};
+  const auto add = [&]<IsNode Base>() {
+    if constexpr (std::is_base_of_v<Base, T>) {
+      bases |= static_cast<std::uint8_t>(*AsNodeBase<Base>());
+    }
+  };
+  add.template operator()<nodes::Expr>();
+  add.template operator()<nodes::Stmt>();
+  add.template operator()<nodes::Decl>();
+  add.template operator()<nodes::TypeSpec>();
+  add.template operator()<nodes::Ident>();
+  return bases;
+}
+
+// NOLINTBEGIN(misc-no-recursion)
+class TreeWriter {
+ public:
+  explicit TreeWriter(lib::BinaryWriter& out) : out_(out) {}
+
+  void Write(const RootNode* root) {
+    out_.Fixed(kNodesSchemaFingerprint);
+    VisitNode(root);
+
+    out_.Varint(nodes_.size());
+    for (const auto* n : nodes_) {
+      const auto it = indices_.find(n->parent);
+      out_.Varint(it == indices_.end() ? 0 : it->second + 1);
+    }
+  }
+
+ private:
+  void VisitNode(const Node* n) {
+    if (n == nullptr) {
+      out_.Varint(kNullRef);
+      return;
+    }
+    if (const auto it = indices_.find(n); it != indices_.end()) {
+      out_.Varint(kFirstBackRef + it->second);
+      return;
+    }
+    out_.Varint(kInplaceRef);
+    out_.Fixed(static_cast<std::uint8_t>(n->nkind));
+
+    using namespace nodes;
+    switch (n->nkind) {
+      case NodeKind::RootNode: {
+        auto* nn = Materialize<RootNode>(n);
+        Visit(nn->nodes);
+        break;
+      }
+      case NodeKind::ErrorNode:
+        Register(n);
+        break;
+      case NodeKind::Ident:
+        Materialize<Ident>(n);
+        break;
+      case NodeKind::CompositeIdent: {
+        auto* nn = Materialize<CompositeIdent>(n);
+        Visit(nn->tok1);
+        Visit(nn->tok2);
+        break;
+      }
+      case NodeKind::DeclStmt: {
+        auto* nn = Materialize<DeclStmt>(n);
+        Visit(nn->decl);
+        break;
+      }
+      case NodeKind::ExprStmt: {
+        auto* nn = Materialize<ExprStmt>(n);
+        Visit(nn->expr);
+        break;
+      }
+#include "vanadium/ast/gen/ASTSerializer.inc"
+      default:
+        assert(false && "unhandled node kind in serializer code");
+        break;
+    }
+  }
+
+  void Register(const Node* n) {
+    indices_.emplace(n, nodes_.size());
+    nodes_.push_back(n);
+    Visit(n->nrange);
+  }
+
+  template <IsNode T>
+  const T* Materialize(const Node* n) {
+    Register(n);
+    return n->As<T>();
+  }
+
+  template <IsNode T>
+  void Visit(const T* n) {
+    VisitNode(n);
+  }
+
+  void Visit(const std::optional<nodes::Ident>& ident) {
+    out_.Fixed<std::uint8_t>(ident.has_value());
+    if (ident) {
+      Register(std::addressof(*ident));
+    }
+  }
+
+  void Visit(const Range& range) {
+    out_.Varint(range.begin);
+    out_.Varint(range.end);
+  }
+
+  void Visit(const Token& tok) {
+    out_.Fixed(static_cast<std::uint8_t>(tok.kind));
+    Visit(tok.range);
+  }
+
+  void Visit(const Token* tok) {
+    out_.Fixed<std::uint8_t>(tok != nullptr);
+    if (tok != nullptr) {
+      Visit(*tok);
+    }
+  }
+
+  void Visit(bool b) {
+    out_.Fixed<std::uint8_t>(b);
+  }
+
+  template <typename T>
+  void Visit(const std::vector<T>& v) {
+    out_.Varint(v.size());
+    for (const auto& e : v) {
+      Visit(e);
+    }
+  }
+
+  lib::BinaryWriter& out_;
+  std::vector<const Node*> nodes_;
+  std::unordered_map<const Node*, std::uint64_t> indices_;
+};
+
+class TreeReader {
+ public:
+  TreeReader(lib::BinaryReader& in, lib::Arena& arena) : in_(in), arena_(arena) {}
+
+  RootNode* Read() {
+    if (in_.Fixed<std::uint64_t>() != kNodesSchemaFingerprint) {
+      return nullptr;
+    }
+
+    auto* root = VisitNode(&NewErrorNode<Node>);
+    if (root == nullptr || root->nkind != NodeKind::RootNode) {
+      return nullptr;
+    }
+
+    if (in_.Varint() != nodes_.size()) {
+      return nullptr;
+    }
+    for (auto* n : nodes_) {
+      const auto parent = in_.Varint();
+      if (parent > nodes_.size()) {
+        return nullptr;
+      }
+      n->parent = parent == 0 ? nullptr : nodes_[parent - 1];
+    }
+
+    return in_.Failed() ? nullptr : root->As<RootNode>();
+  }
+
+ private:
+  using ErrorNodeFactory = Node* (*)(lib::Arena&);
+
+  // The error nodes take the shape of the field they are stored in, as the parser makes them
+  template <IsNode T>
+  static Node* NewErrorNode(lib::Arena& arena) {
+    T* n;
+    if constexpr (std::is_constructible_v<T, NodeKind>) {
+      n = arena.Alloc<T>(NodeKind::ErrorNode);
+    } else {
+      n = arena.Alloc<T>();
+      const_cast<NodeKind&>(n->nkind) = NodeKind::ErrorNode;
+    }
+    return n;
+  }
+
+  Node* VisitNode(ErrorNodeFactory new_error_node) {
+    const auto ref = in_.Varint();
+    if (ref == kNullRef || in_.Failed()) {
+      return nullptr;
+    }
+    if (ref >= kFirstBackRef) {
+      if (ref - kFirstBackRef >= nodes_.size()) {
+        in_.Fail();
+        return nullptr;
+      }
+      return nodes_[ref - kFirstBackRef];
+    }
+    if (ref != kInplaceRef) {
+      in_.Fail();
+      return nullptr;
+    }
+
+    Node* n{nullptr};
+
+    using namespace nodes;
+    switch (static_cast<NodeKind>(in_.Fixed<std::uint8_t>())) {
+      case NodeKind::RootNode: {
+        auto* nn = Materialize<RootNode>(n);
+        Visit(nn->nodes);
+        break;
+      }
+      case NodeKind::ErrorNode:
+        n = new_error_node(arena_);
+        Register(n);
+        break;
+      case NodeKind::Ident:
+        Materialize<Ident>(n);
+        break;
+      case NodeKind::CompositeIdent: {
+        auto* nn = Materialize<CompositeIdent>(n);
+        Visit(nn->tok1);
+        Visit(nn->tok2);
+        break;
+      }
+      case NodeKind::DeclStmt: {
+        auto* nn = Materialize<DeclStmt>(n);
+        Visit(nn->decl);
+        break;
+      }
+      case NodeKind::ExprStmt: {
+        auto* nn = Materialize<ExprStmt>(n);
+        Visit(nn->expr);
+        break;
+      }
+#include "vanadium/ast/gen/ASTSerializer.inc"
+      default:
+        in_.Fail();
+        break;
+    }
+
+    return in_.Failed() ? nullptr : n;
+  }
+
+  void Register(Node* n) {
+    nodes_.push_back(n);
+    Visit(n->nrange);
+  }
+
+  template <IsNode T>
+  T* Materialize(Node*& n) {
+    auto* nn = arena_.Alloc<T>();
+    node_bases_[static_cast<std::uint8_t>(nn->nkind)] = NodeBasesOf<T>();
+    Register(nn);
+    n = nn;
+    return nn;
+  }
+
+  // A stale or corrupted cache may hold a node of another kind, which must not be cast to the type
+  template <IsNode T>
+  [[nodiscard]] bool IsStorableAs(const Node* n) const {
+    if constexpr (std::is_same_v<T, Node>) {
+      return true;
+    } else if (n->nkind == NodeKind::ErrorNode) {  // they are put in place of any node, see Parser::NewErrorNode
+      return true;
+    } else if constexpr (constexpr auto base = AsNodeBase<T>(); base.has_value()) {
+      return (node_bases_[static_cast<std::uint8_t>(n->nkind)] & static_cast<std::uint8_t>(*base)) != 0;
+    } else {
+      return n->nkind == T::kKind;
+    }
+  }
+
+  template <IsNode T>
+  void Visit(T*& n) {
+    auto* node = VisitNode(&NewErrorNode<T>);
+    if (node != nullptr && !IsStorableAs<T>(node)) {
+      in_.Fail();
+      node = nullptr;
+    }
+    n = static_cast<T*>(node);
+  }
+
+  void Visit(std::optional<nodes::Ident>& ident) {
+    if (in_.Fixed<std::uint8_t>() != 0) {
+      Register(std::addressof(ident.emplace()));
+    }
+  }
+
+  void Visit(Range& range) {
+    range.begin = static_cast<pos_t>(in_.Varint());
+    range.end = static_cast<pos_t>(in_.Varint());
+  }
+
+  void Visit(Token& tok) {
+    const auto kind = in_.Fixed<std::uint8_t>();
+    if (kind >= static_cast<std::uint8_t>(TokenKind::kTokenKindEnd)) {
+      in_.Fail();
+      return;
+    }
+    tok.kind = static_cast<TokenKind>(kind);
+    Visit(tok.range);
+  }
+
+  void Visit(Token*& tok) {
+    if (in_.Fixed<std::uint8_t>() == 0) {
+      tok = nullptr;
+      return;
+    }
+    tok = arena_.Alloc<Token>();
+    Visit(*tok);
+  }
+
+  void Visit(bool& b) {
+    b = in_.Fixed<std::uint8_t>() != 0;
+  }
+
+  template <typename T>
+  void Visit(std::vector<T>& v) {
+    const auto size = in_.Varint();
+    if (size > in_.Remaining().size()) {  // every element takes at least a byte
+      in_.Fail();
+      return;
+    }
+    v.resize(size);
+    for (auto& e : v) {
+      Visit(e);
+      if (in_.Failed()) {
+        return;
+      }
+    }
+  }
+
+  lib::BinaryReader& in_;
+  lib::Arena& arena_;
+  std::vector<Node*> nodes_;
+  std::array<std::uint8_t, 256> node_bases_{};  // by the kinds materialized so far
+};
+// NOLINTEND(misc-no-recursion)
+
+}  // namespace
+
+void SerializeTree(const RootNode* root, lib::BinaryWriter& out) {
+  TreeWriter(out).Write(root);
+}
+
+RootNode* DeserializeTree(lib::BinaryReader& in, lib::Arena& arena) {
+  return TreeReader(in, arena).Read();
+}
+
+}  // namespace vanadium::ast
@@ -1,9 +1,13 @@
 #include "vanadium/ast/Parser.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstring>
 #include <format>
+#include <memory>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <magic_enum/magic_enum.hpp>
 
@@ -204,9 +208,15 @@ inline void ExtendByIncorporatedNode(Node* n, Node* x) {
   n->parent = std::exchange(x->parent, n);
   n->nrange.begin = x->nrange.begin;
 }
+
+constexpr bool IsTrivia(TokenKind kind) {
+  return kind == TokenKind::COMMENT || kind == TokenKind::PREPROC;
+}
 }  // namespace
 
-Parser::Parser(lib::Arena& arena, std::string_view src) : scanner_(src), src_(src), arena_(&arena) {}
+Parser::Parser(lib::Arena& arena, std::string_view src) : scanner_(src), src_(src), arena_(&arena) {
+  Tokenize();
+}
 
 RootNode* Parser::ParseRoot() {
   return NewNode<RootNode>([&](auto& root) {
@@ -217,10 +227,6 @@ RootNode* Parser::ParseRoot() {
       root.nodes.push_back(node);
       if (tok_ != TokenKind::kEOF && !kTokTopLevel.contains(tok_)) {
         EmitError(Peek(1).range, std::format("unexpected '{}' token", magic_enum::enum_name(tok_)));
-        while (scanner_.Scan().kind != TokenKind::kEOF) {
-          // eat all tokens to calculate remaining line offsets
-          ;
-        }
         break;
       }
       if (tok_ == TokenKind::SEMICOLON) {
@@ -238,6 +244,10 @@ std::vector<pos_t>&& Parser::ExtractLineMapping() noexcept {
   return scanner_.ExtractLineMapping();
 }
 
+std::vector<Token>&& Parser::ExtractTrivia() noexcept {
+  return std::move(trivia_);
+}
+
 Node* Parser::Parse() {
   switch (tok_) {
     case TokenKind::MODULE:
@@ -2510,18 +2520,14 @@ nodes::Ident* Parser::TryParseTypeIdent() {
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 Token Parser::Consume() {
-  auto tok = queue_[cursor_];
-  ++cursor_;
+  auto tok = tokens_[cursor_];
+  if (cursor_ + 1 < tokens_.size()) {
+    ++cursor_;
+  }
 
   seen_closing_brace_ = tok_ == TokenKind::RBRACE;
 
-  if (cursor_ == queue_.size() && !IsSpeculating()) {
-    cursor_ = 0;
-    queue_.clear();
-  }
-
-  Peek(1);
-  tok_ = queue_[cursor_].kind;
+  tok_ = tokens_[cursor_].kind;
 
   last_consumed_pos_ = tok.range.end;
 
@@ -2532,20 +2538,17 @@ Token Parser::ConsumeInvariant(TokenKind) {
   return Consume();
 }
 
-void Parser::Grow(std::uint8_t n) {
-  constexpr auto kShouldIgnore = [](TokenKind kind) -> bool {
-    switch (kind) {
-      case TokenKind::COMMENT:
-      case TokenKind::PREPROC:
-        return true;
-      default:
-        return false;
-    }
-  };
-
-  while (n > 0) {
+void Parser::Tokenize() {
+  // The tokens are written straight into the arena, as nothing else is allocated there meanwhile,
+  // starting off the usual density of the tokens in the code
+  static_assert(std::is_trivially_copyable_v<Token> && std::is_trivially_destructible_v<Token>);
+  auto buf = arena_->Extend({}, 0, (src_.size() / 4 + 1) * sizeof(Token), alignof(Token));
+  std::size_t n{0};
+  for (;;) {
     auto token = scanner_.Scan();
-    if (kShouldIgnore(token.kind)) {
+    if (IsTrivia(token.kind)) {
+      // kept aside for the lookups of the attached comments, see utils::ExtractAttachedComment
+      trivia_.push_back(token);
       continue;
     }
 
@@ -2553,18 +2556,22 @@ void Parser::Grow(std::uint8_t n) {
       EmitError(token.range, "malformed or unterminated token");
       continue;
     }
-    queue_.push_back(token);
-    --n;
+    if ((n + 1) * sizeof(Token) > buf.size()) [[unlikely]] {
+      buf = arena_->Extend(buf, n * sizeof(Token), (n + 1) * sizeof(Token), alignof(Token));
+    }
+    std::construct_at(reinterpret_cast<Token*>(buf.data()) + n++, token);
+    if (token.kind == TokenKind::kEOF) {
+      break;
+    }
   }
+
+  arena_->Commit(buf, n * sizeof(Token));
+  tokens_ = {reinterpret_cast<Token*>(buf.data()), n};
 }
 
 Token& Parser::Peek(std::uint8_t i) {
-  const auto idx = cursor_ + i - 1;
-  const auto cached = queue_.size();
-  if (idx + 1 > cached) {
-    Grow(idx - cached + 1);
-  }
-  return queue_[idx];
+  // everything beyond the end is kEOF
+  return tokens_[std::min<std::size_t>(cursor_ + i - 1, tokens_.size() - 1)];
 }
 
 std::string_view Parser::Lit(std::uint8_t i) {
@@ -2638,7 +2645,7 @@ inline void Parser::Reset() {
   const ast::pos_t marker = markers_.back();
   markers_.pop_back();
   cursor_ = marker;
-  tok_ = queue_[cursor_].kind;
+  tok_ = tokens_[cursor_].kind;
 }
 
 inline bool Parser::IsSpeculating() const noexcept {
@@ -1,8 +1,10 @@
 #include "vanadium/ast/utils/ASTUtils.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <vanadium/ast/ASTNodes.h>
 #include <vanadium/ast/ASTTypes.h>
-#include <vanadium/ast/Scanner.h>
 
 namespace vanadium::ast {
 namespace utils {
@@ -122,35 +124,28 @@ const Node* GetNodeAt(const AST& ast, pos_t pos) {
 std::optional<Range> ExtractAttachedComment(const AST& ast, const Node* n) {
   const auto anchor{n->nrange.begin};
 
-  ast::Token preceding{};
-  pos_t preceding_end_line{};
-
-  parser::Scanner scanner(ast.src);
-  while (true) {
-    const ast::Token tok = scanner.Scan();
-    if (tok.range.end > anchor) {
-      // EOF check can be avoided ig
-      break;
-    }
-
-    const auto is_continuation_comment = [&] {
-      const auto tok_begin_line = ast.lines.LineOf(tok.range.begin);
-      return (preceding.kind == TokenKind::COMMENT && tok.kind == TokenKind::COMMENT) &&
-             (tok_begin_line - preceding_end_line) <= 1;
-    };
-
-    if (!is_continuation_comment()) {
-      preceding = tok;
-    }
-    if (tok.kind == TokenKind::COMMENT) {
-      preceding_end_line = ast.lines.LineOf(tok.range.end);
-    }
+  const auto only_spaces_between = [&](pos_t begin, pos_t end) {
+    return ast.src.substr(begin, end - begin).find_first_not_of(" \t\r\n") == std::string_view::npos;
+  };
+  const auto is_attached_to = [&](const Token& comment, pos_t pos) {
+    return comment.kind == TokenKind::COMMENT && only_spaces_between(comment.range.end, pos) &&
+           (ast.lines.LineOf(pos) - ast.lines.LineOf(comment.range.end)) <= 1;
+  };
+
+  // the last trivia preceding the anchor
+  auto it = std::ranges::upper_bound(ast.trivia, anchor, {}, [](const Token& tok) {
+    return tok.range.end;
+  });
+  if (it == ast.trivia.begin() || !is_attached_to(*std::prev(it), anchor)) {
+    return std::nullopt;
   }
 
-  if (preceding.kind != TokenKind::COMMENT || ((ast.lines.LineOf(n->nrange.begin) - preceding_end_line) > 1)) {
-    return std::nullopt;
+  // the comments of a run are attached to each other, e.g. the consecutive single-line ones
+  --it;
+  while (it != ast.trivia.begin() && is_attached_to(*std::prev(it), it->range.begin)) {
+    --it;
   }
-  return Range{.begin = preceding.range.begin, .end = n->nrange.begin};
+  return Range{.begin = it->range.begin, .end = anchor};
 }
 
 }  // namespace utils
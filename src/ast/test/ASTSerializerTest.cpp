@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include <vanadium/lib/Arena.h>
+#include <vanadium/lib/BinaryStream.h>
+
+#include "vanadium/ast/AST.h"
+#include "vanadium/ast/ASTNodes.h"
+#include "vanadium/ast/ASTSerializer.h"
+#include "vanadium/ast/Parser.h"
+
+using namespace vanadium;
+using namespace vanadium::ast;
+
+namespace {
+constexpr std::string_view kSource = R"(
+module M {
+  import from N all;
+
+  type record R {
+    integer a optional,
+    charstring b
+  }
+
+  function f(in R r) return integer {
+    var integer x := r.a + 1;
+    if (x > 2) {
+      return x;
+    }
+    return 0;
+  }
+}
+)";
+
+std::string Serialize(const RootNode* root) {
+  std::string buf;
+  lib::BinaryWriter writer(buf);
+  SerializeTree(root, writer);
+  return buf;
+}
+}  // namespace
+
+TEST(ASTSerializer, RoundTrip) {
+  lib::Arena arena;
+  const auto ast = Parse(arena, kSource);
+  ASSERT_TRUE(ast.errors.empty());
+
+  const auto serialized = Serialize(ast.root);
+
+  lib::Arena restored_arena;
+  lib::BinaryReader reader(serialized);
+  const auto* restored = DeserializeTree(reader, restored_arena);
+  ASSERT_NE(restored, nullptr);
+  EXPECT_TRUE(reader.Remaining().empty());
+
+  EXPECT_EQ(Serialize(restored), serialized);
+
+  ASSERT_EQ(restored->nodes.size(), ast.root->nodes.size());
+  const auto* module = restored->nodes.front()->As<nodes::Module>();
+  ASSERT_EQ(module->nkind, NodeKind::Module);
+  EXPECT_EQ(module->parent, restored);
+  ASSERT_TRUE(module->name.has_value());
+  EXPECT_EQ(ast.Text(*module->name), "M");
+  ASSERT_EQ(module->defs.size(), 3);
+  EXPECT_EQ(module->defs[1]->parent, module);
+}
+
+TEST(ASTSerializer, RejectsMalformedInput) {
+  lib::Arena arena;
+  const auto ast = Parse(arena, kSource);
+  const auto serialized = Serialize(ast.root);
+
+  for (const auto length : {std::size_t{0}, std::size_t{4}, serialized.size() / 2, serialized.size() - 1}) {
+    lib::Arena restored_arena;
+    lib::BinaryReader reader(std::string_view{serialized}.substr(0, length));
+    EXPECT_EQ(DeserializeTree(reader, restored_arena), nullptr) << length;
+  }
+
+  auto foreign_schema = serialized;
+  foreign_schema[0] ^= 1;
+  lib::Arena restored_arena;
+  lib::BinaryReader reader(foreign_schema);
+  EXPECT_EQ(DeserializeTree(reader, restored_arena), nullptr);
+}
+
+TEST(ASTSerializer, RejectsNodesOfUnexpectedKind) {
+  lib::Arena arena;
+  const auto ast = Parse(arena, kSource);
+  ASSERT_TRUE(ast.errors.empty());
+
+  // A function declaration where the module expects a definition wrapping it
+  auto* module = ast.root->nodes.front()->As<nodes::Module>();
+  auto* func = module->defs[2]->def;
+  ASSERT_EQ(func->nkind, NodeKind::FuncDecl);
+  module->defs[2] = static_cast<nodes::Definition*>(func);
+
+  const auto serialized = Serialize(ast.root);
+  lib::Arena restored_arena;
+  lib::BinaryReader reader(serialized);
+  EXPECT_EQ(DeserializeTree(reader, restored_arena), nullptr);
+}
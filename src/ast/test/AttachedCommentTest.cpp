@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string_view>
+
+#include <vanadium/lib/Arena.h>
+
+#include "vanadium/ast/AST.h"
+#include "vanadium/ast/ASTNodes.h"
+#include "vanadium/ast/ASTTypes.h"
+#include "vanadium/ast/Parser.h"
+#include "vanadium/ast/utils/ASTUtils.h"
+
+using namespace vanadium;
+using namespace vanadium::ast;
+
+namespace {
+constexpr std::string_view kSource = R"(module M {
+// first line
+// second line
+const integer c_doc := 1;
+
+/* detached */
+
+const integer c_detached := 2;
+const integer c_none := 3;
+
+#define X
+// after a directive
+function f_doc() {}
+
+/** block */
+// and a line
+type integer Int;
+}
+)";
+
+// comment attached to the top-level declaration whose name is first found in the source
+std::optional<std::string_view> CommentOf(const AST& ast, std::string_view name) {
+  const auto* decl = utils::GetNodeAt(ast, static_cast<pos_t>(ast.src.find(name)));
+  while (decl != nullptr && (decl->parent == nullptr || decl->parent->nkind != NodeKind::Definition)) {
+    decl = decl->parent;
+  }
+  if (decl == nullptr) {
+    ADD_FAILURE() << name;
+    return std::nullopt;
+  }
+  const auto comment = utils::ExtractAttachedComment(ast, decl);
+  if (!comment) {
+    return std::nullopt;
+  }
+  return ast.Text(*comment);
+}
+}  // namespace
+
+TEST(AttachedComment, Lookup) {
+  lib::Arena arena;
+  const auto ast = Parse(arena, kSource);
+  ASSERT_TRUE(ast.errors.empty());
+  EXPECT_EQ(ast.trivia.size(), 7);
+
+  EXPECT_EQ(CommentOf(ast, "c_doc"), "// first line\n// second line\n");
+  EXPECT_EQ(CommentOf(ast, "c_detached"), std::nullopt);
+  EXPECT_EQ(CommentOf(ast, "c_none"), std::nullopt);
+  EXPECT_EQ(CommentOf(ast, "f_doc"), "// after a directive\n");
+  EXPECT_EQ(CommentOf(ast, "Int"), "/** block */\n// and a line\n");
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+#include <vanadium/lib/Arena.h>
+
+#include "vanadium/ast/AST.h"
+#include "vanadium/ast/ASTTypes.h"
+#include "vanadium/ast/Parser.h"
+
+using namespace vanadium;
+using namespace vanadium::ast;
+
+TEST(Parser, KeepsCodeTokensApartFromTrivia) {
+  constexpr std::string_view kSource = "module M {\n"
+                                       "// c\n"
+                                       "const integer x := 1;\n"
+                                       "}\n";
+  lib::Arena arena;
+  const auto ast = Parse(arena, kSource);
+  ASSERT_TRUE(ast.errors.empty());
+  ASSERT_EQ(ast.trivia.size(), 1);
+  EXPECT_EQ(ast.trivia.front().On(kSource), "// c");
+
+  ASSERT_EQ(ast.tokens.size(), 11);
+  EXPECT_EQ(ast.tokens.front().kind, TokenKind::MODULE);
+  EXPECT_EQ(ast.tokens[ast.tokens.size() - 2].kind, TokenKind::RBRACE);
+  EXPECT_EQ(ast.tokens.back().kind, TokenKind::kEOF);
+}
+
+TEST(Parser, ScansPastUnexpectedTopLevelToken) {
+  constexpr std::string_view kSource = "module M {}\n"
+                                       ")\n"
+                                       "// c\n"
+                                       "module N {}\n";
+  lib::Arena arena;
+  const auto ast = Parse(arena, kSource);
+  ASSERT_EQ(ast.errors.size(), 1);
+  EXPECT_EQ(ast.errors.front().range.begin, kSource.find(')'));
+
+  EXPECT_EQ(ast.trivia.size(), 1);
+  EXPECT_EQ(ast.lines.LineOf(static_cast<pos_t>(kSource.find("module N"))), 3);
+  EXPECT_EQ(ast.tokens.back().kind, TokenKind::kEOF);
+}
@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 
 import argparse
+import hashlib
 import os
 import re
 import sys
@@ -276,6 +277,31 @@ def generate_dumper_code(nodes: AstNodesDict) -> str:
   return buf.build()
 
 
+def generate_serializer_code(nodes: AstNodesDict) -> str:
+  buf = SourceCodeBuilder()
+
+  for node in nodes.values():
+    buf.write(f"case NodeKind::{node.name}: {{")
+    with buf.indented():
+      buf.write(f"auto* nn = Materialize<nodes::{node.name}>(n);")
+      for field in node.fields:
+        buf.write(f"Visit(nn->{field.name});")
+      buf.write("break;")
+    buf.write("}")
+
+  return buf.build()
+
+
+def generate_schema_fingerprint(nodes: AstNodesDict) -> str:
+  # changes whenever the layout of any node does, so that the serialized trees get invalidated
+  description = ";".join(
+    f"{node.name}:" + ",".join(f"{field.name}={field}" for field in node.fields)
+    for node in nodes.values()
+  )
+  fingerprint = hashlib.sha256(description.encode()).hexdigest()[:16]
+  return f"inline constexpr std::uint64_t kNodesSchemaFingerprint = 0x{fingerprint}ULL;\n"
+
+
 class ArgumentsNamespace(argparse.Namespace):
   input: str
   output: str
@@ -316,6 +342,8 @@ def main():
     ("ASTNodes.inc", generate_nodes_descriptors),
     ("ASTInspector.inc", generate_macro_inspector),
     ("ASTDumper.inc", generate_dumper_code),
+    ("ASTSerializer.inc", generate_serializer_code),
+    ("ASTSchema.inc", generate_schema_fingerprint),
   ]
   for filepath, transform in TARGETS:
     (dest / filepath).write_text(
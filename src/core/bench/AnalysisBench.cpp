@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <oneapi/tbb/global_control.h>
+
+#include <vanadium/bench/Corpus.h>
+
+#include "vanadium/core/Program.h"
+
+namespace {
+
+using namespace vanadium;
+
+constexpr std::size_t kPrograms = 4;
+
+// The modules of the corpus are split between the programs in order, each program referencing the previous one,
+// so that the typecheck of a program depends on the crossbind of the modules it imports from the previous one
+struct Workspace {
+  std::vector<std::unique_ptr<core::Program>> programs;
+  std::vector<core::Program*> program_ptrs;
+
+  explicit Workspace(const std::vector<bench::CorpusFile>& corpus) {
+    for (std::size_t p = 0; p < kPrograms; ++p) {
+      auto& program = *programs.emplace_back(std::make_unique<core::Program>());
+      if (p > 0) {
+        program.AddReference(programs[p - 1].get());
+      }
+      program_ptrs.push_back(&program);
+    }
+    for (auto* program : program_ptrs) {
+      program->SealReferences();
+    }
+
+    std::unordered_map<std::string_view, std::string_view> sources;
+    for (const auto& file : corpus) {
+      sources.emplace(file.path, file.src);
+    }
+    const auto read_source = [&](const std::string& path, std::string& buf) {
+      buf = sources.at(path);
+    };
+    for (std::size_t p = 0; p < kPrograms; ++p) {
+      programs[p]->Update([&](const core::Program::ProgramModifier& modify) {
+        for (std::size_t i = p * corpus.size() / kPrograms; i < (p + 1) * corpus.size() / kPrograms; ++i) {
+          modify.update(corpus[i].path, read_source);
+        }
+      });
+    }
+  }
+};
+
+template <bool Together>
+void AnalyzeSolution(benchmark::State& state) {
+  const tbb::global_control parallelism(tbb::global_control::max_allowed_parallelism,
+                                        static_cast<std::size_t>(state.range(0)));
+
+  const auto& corpus = bench::CachedCorpus(bench::CorpusShape::kManyModules);
+  state.SetLabel(std::string(bench::CorpusShapeName(bench::CorpusShape::kManyModules)));
+
+  std::optional<Workspace> workspace;
+  for (auto _ : state) {
+    state.PauseTiming();
+    workspace.emplace(corpus);
+    state.ResumeTiming();
+
+    if constexpr (Together) {
+      core::Program::Analyze(workspace->program_ptrs);
+    } else {
+      for (auto* program : workspace->program_ptrs) {
+        core::Program::Analyze({&program, 1});
+      }
+    }
+
+    state.PauseTiming();
+    workspace.reset();  // teardown is not measured
+    state.ResumeTiming();
+  }
+
+  state.counters["modules"] = static_cast<double>(corpus.size());
+}
+
+// The whole solution analyzed from scratch, as it happens upon the initial load, given the number of threads
+void BM_AnalyzeSolution(benchmark::State& state) {
+  AnalyzeSolution<true>(state);
+}
+BENCHMARK(BM_AnalyzeSolution)->RangeMultiplier(2)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// The projects analyzed one after another in the references order, for comparison
+void BM_AnalyzeSolution_PerProgram(benchmark::State& state) {
+  AnalyzeSolution<false>(state);
+}
+BENCHMARK(BM_AnalyzeSolution_PerProgram)
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,173 @@
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/ast/ASTNodes.h>
+#include <vanadium/ast/Parser.h>
+#include <vanadium/bench/BenchUtils.h>
+#include <vanadium/bench/Corpus.h>
+
+#include "vanadium/core/Program.h"
+#include "vanadium/core/Semantic.h"
+#include "vanadium/core/TypeChecker.h"
+
+namespace {
+
+using namespace vanadium;
+using namespace vanadium::bench;
+
+std::size_t CountNodes(const ast::RootNode* root) {
+  std::size_t nodes{1};
+  root->Accept([&](const ast::Node*) {
+    ++nodes;
+    return true;
+  });
+  return nodes;
+}
+
+std::size_t CountNodes(const core::Program& program) {
+  std::size_t nodes{0};
+  for (const auto& sf : program.Files() | std::views::values) {
+    nodes += sf.ast.root ? CountNodes(sf.ast.root) : 0;  // none for the ASN.1 modules nobody imports
+  }
+  return nodes;
+}
+
+std::size_t CountTtcnNodes(const core::Program& program) {
+  std::size_t nodes{0};
+  for (const auto& sf : program.Files() | std::views::values) {
+    nodes += IsAsnFile(sf.path) ? 0 : CountNodes(sf.ast.root);
+  }
+  return nodes;
+}
+
+void CommitCorpus(core::Program& program, const std::vector<CorpusFile>& corpus) {
+  std::unordered_map<std::string, const CorpusFile*> files;
+  for (const auto& file : corpus) {
+    files.emplace(file.path, &file);
+  }
+  // the files are read asynchronously, so the reader has to outlive the modification
+  const auto read_source = [&](const std::string& path, std::string& buf) {
+    buf = files.at(path)->src;
+  };
+  program.Commit([&](const core::Program::ProgramModifier& modify) {
+    for (const auto& path : files | std::views::keys) {
+      modify.update(path, read_source);
+    }
+  });
+}
+
+// The whole pipeline as on the initial load: parsing, binding, crossbinding and typechecking
+void BM_Commit(benchmark::State& state) {
+  const auto& corpus = CachedCorpus(UseCorpusShape(state));
+
+  std::size_t nodes{0};
+  std::optional<core::Program> program;
+  for (auto _ : state) {
+    program.emplace();
+    CommitCorpus(*program, corpus);
+
+    state.PauseTiming();
+    nodes = CountNodes(*program);
+    program.reset();  // teardown is not measured
+    state.ResumeTiming();
+  }
+
+  ReportThroughput(state, CorpusBytes(corpus), nodes);
+}
+BENCHMARK(BM_Commit)->Apply(ApplyCorpusShapes)->UseRealTime();
+
+void BM_Bind(benchmark::State& state) {
+  const auto& corpus = CachedCorpus(UseCorpusShape(state));
+
+  std::deque<core::SourceFile> files;
+  for (const auto& file : corpus) {
+    if (!IsAsnFile(file.path)) {
+      auto& sf = files.emplace_back();
+      sf.path = file.path;
+      sf.src = file.src;
+    }
+  }
+
+  std::size_t nodes{0};
+  for (auto _ : state) {
+    state.PauseTiming();
+    nodes = 0;
+    for (auto& sf : files) {
+      sf.module.reset();
+      sf.semantic_errors.clear();
+      sf.arena.Reset();
+      sf.ast = ast::Parse(sf.arena, sf.src);
+      sf.ast.root->file = &sf;
+      nodes += CountNodes(sf.ast.root);
+    }
+    state.ResumeTiming();
+
+    for (auto& sf : files) {
+      core::semantic::Bind(sf);
+    }
+  }
+
+  ReportThroughput(state, TtcnBytes(corpus), nodes);
+}
+BENCHMARK(BM_Bind)->Apply(ApplyCorpusShapes);
+
+// Typechecking of the modules again, once everything is crossbound
+void BM_TypeCheck(benchmark::State& state) {
+  const auto& corpus = CachedCorpus(UseCorpusShape(state));
+
+  core::Program program;
+  CommitCorpus(program, corpus);
+
+  for (auto _ : state) {
+    for (const auto& sf : program.Files() | std::views::values) {
+      if (!sf.module || IsAsnFile(sf.path)) {
+        continue;
+      }
+      auto& mutable_sf = const_cast<core::SourceFile&>(sf);
+      mutable_sf.type_errors.clear();
+      mutable_sf.type_errors_arena.Reset();
+      core::checker::PerformTypeCheck(mutable_sf);
+    }
+  }
+
+  ReportThroughput(state, TtcnBytes(corpus), CountTtcnNodes(program));
+}
+BENCHMARK(BM_TypeCheck)->Apply(ApplyCorpusShapes);
+
+// A keystroke in a large program: a single module is edited, as with didChange, and the program is analyzed again.
+// Either the top module nobody imports is edited, or the bottom one, so that its importers are analyzed again too
+void BM_EditFile(benchmark::State& state) {
+  const bool edit_bottom = state.range(0) != 0;
+  state.SetLabel(edit_bottom ? "bottom" : "top");
+
+  static const auto corpus = GenerateCorpus({.modules = 5'000, .records_per_module = 2, .functions_per_module = 2});
+  const auto& edited = edit_bottom ? corpus.front() : corpus.back();
+
+  core::Program program;
+  CommitCorpus(program, corpus);
+
+  std::string src;
+  const auto read_source = [&](const std::string&, std::string& buf) {
+    buf = src;
+  };
+  for (auto _ : state) {
+    src = edited.src;
+    src += (state.iterations() % 2 == 0) ? "// even\n" : "// odd\n";
+    program.Commit([&](const core::Program::ProgramModifier& modify) {
+      modify.update(edited.path, read_source);
+    });
+  }
+
+  state.counters["modules"] = static_cast<double>(corpus.size());
+}
+BENCHMARK(BM_EditFile)->ArgName("bottom")->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
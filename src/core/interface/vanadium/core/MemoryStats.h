@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace vanadium::core {
+
+// The memory held by a source file, in bytes.
+// The heap figures are estimates: the containers are accounted by their capacity, not by the allocator.
+struct FileMemoryStats {
+  std::string_view path;
+
+  std::size_t arena_allocated{0};  // the blocks of the arena: AST, scopes, symbols, types
+  std::size_t arena_used{0};       // the part of them in use
+  std::size_t source{0};           // the text and the line mapping
+  std::size_t symbol_tables{0};    // the nodes of the symbol tables and the scope vectors
+  std::size_t module{0};           // the module descriptor: imports, dependencies, externals
+  std::size_t diagnostics{0};      // the syntax, semantic and type errors
+
+  [[nodiscard]] std::size_t HeapUsage() const noexcept {
+    return source + symbol_tables + module + diagnostics;
+  }
+  [[nodiscard]] std::size_t Total() const noexcept {
+    return arena_allocated + HeapUsage();
+  }
+};
+
+struct ProgramMemoryStats {
+  std::vector<FileMemoryStats> files;
+  std::size_t index{0};  // the files and the modules by their names
+
+  std::size_t asn_modules_arena{0};  // the parsed ASN.1 modules
+  std::size_t asn_modules_heap{0};   // and their bookkeeping
+
+  [[nodiscard]] std::size_t FilesTotal() const noexcept {
+    std::size_t total{0};
+    for (const auto& file : files) {
+      total += file.Total();
+    }
+    return total;
+  }
+  [[nodiscard]] std::size_t Total() const noexcept {
+    return FilesTotal() + index + asn_modules_arena + asn_modules_heap;
+  }
+};
+
+}  // namespace vanadium::core
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <ranges>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -17,6 +21,7 @@
 #include <vanadium/lib/DelimitedStringView.h>
 #include <vanadium/lib/FunctionRef.h>
 
+#include "vanadium/core/MemoryStats.h"
 #include "vanadium/core/Semantic.h"
 #include "vanadium/core/TypeChecker.h"
 
@@ -112,11 +117,13 @@ struct SourceFile {
 
   std::vector<semantic::SemanticError> semantic_errors;
   std::vector<checker::TypeError> type_errors;
+  lib::Arena type_errors_arena;  // the texts of the type errors that are not in the source, see checker::TypeError
 
   std::optional<ModuleDescriptor> module;
 
   AnalysisState::Value analysis_state{AnalysisState::kDirty};
   bool skip_analysis{false};
+  bool typecheck_deferred{false};
 
   [[nodiscard]] std::string_view Text(const ast::Node* n) const noexcept {
     return ast.Text(n);
@@ -139,8 +146,9 @@ class Program {
   Program() = default;
 
  private:
-  void UpdateFile(const std::string& path, const FileReadFn& read);
-  void DropFile(const std::string& path);
+  void UpdateFile(const std::string& path, const FileReadFn& read, bool editor_buffer);
+  std::optional<std::string> DropFile(const std::string& path);  // returns the name of the dropped module
+  void InvalidateImporters(std::span<const std::string> module_names);
 
  public:
   const std::unordered_map<std::string, SourceFile>& Files() const {
@@ -158,6 +166,9 @@ class Program {
 
   struct ProgramModifier {
     lib::Consumer<const std::string& /* path */, const FileReadFn&> update;
+    // The same as update for a source taken from the editor rather than from the file,
+    // so that nothing derived from it is kept across the runs
+    lib::Consumer<const std::string& /* path */, const FileReadFn&> update_buffer;
     lib::Consumer<const std::string& /* path */> drop;
   };
 
@@ -179,6 +190,27 @@ class Program {
     return it == files_.end() ? nullptr : &it->second;
   }
 
+  // The files opened in the editor are analyzed fully, the others only as much as their dependents need.
+  // Takes effect upon the next analysis
+  void SetAnalysisSkipped(const std::string& path, bool skipped);
+  // The typecheck of a fully analyzed file only yields its diagnostics, so it may be postponed
+  // while the crossbind the other results rely on goes on as usual. Takes effect upon the next analysis
+  void SetTypecheckDeferred(const std::string& path, bool deferred);
+
+  // Advances whenever anything the analysis results of any program rely on may have changed,
+  // so the data derived from them (and the pointers into them) may be cached until it does
+  [[nodiscard]] static std::uint64_t AnalysisRevision() noexcept {
+    return analysis_revision_.load(std::memory_order_acquire);
+  }
+
+  // Not synchronized with the updates
+  [[nodiscard]] ProgramMemoryStats CollectMemoryStats() const;
+
+  // Analyzes the programs as a single task graph: crossbind of all the modules runs at once,
+  // and the typecheck of a module starts as soon as the modules reachable through its imports are crossbound,
+  // regardless of the program they belong to, so there are no barriers between the phases and the programs
+  static void Analyze(std::span<Program* const> programs);
+
   void AddReference(Program*);
   void SealReferences();
   auto References() const {
@@ -209,19 +241,34 @@ class Program {
  private:
   void AttachFile(SourceFile&);
   void DetachFile(SourceFile&);
+  void ResetFile(SourceFile&);  // detaches the file and drops everything built from its source
+  void MarkDirty(SourceFile&);
 
   void Crossbind(SourceFile&, ExternallyResolvedGroup&);
+  void CrossbindFile(SourceFile&);
   void Analyze();
 
+  std::vector<Program*> WithDependents();
+
+  void TransformAsnModule(SourceFile&);
+  SourceFile* FindAsnModuleFile(std::string_view module_name);
+  static void TransformDemandedAsnModules(std::vector<Program*>& programs);
+
   std::unordered_map<std::string, SourceFile> files_;
   tbb::speculative_spin_mutex files_mutex_;
 
+  // The files that may need to be analyzed, so that the analysis does not have to look through all of them
+  std::unordered_set<SourceFile*> dirty_files_;
+  tbb::spin_mutex dirty_files_mutex_;
+
   std::unordered_map<std::string_view, ModuleDescriptor*> modules_;
   asn1::ast::Asn1ModuleBasket asn_modules_;
 
   std::unordered_set<Program*> explicit_references_;
   std::unordered_set<Program*> references_;
   std::unordered_set<Program*> direct_dependents_;
+
+  inline static std::atomic<std::uint64_t> analysis_revision_{0};
 };
 
 }  // namespace vanadium::core
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include <vanadium/ast/ASTTypes.h>
+#include <vanadium/lib/MemoryUsage.h>
 
 #include "vanadium/core/Builtins.h"
 
@@ -165,6 +166,19 @@ class SymbolTable {
     names_.reserve(n);
   }
 
+  // The table itself lives in the arena, but its nodes are on the heap, the member tables are included
+  [[nodiscard]] std::size_t HeapUsage() const noexcept {
+    std::size_t total = lib::HeapUsage(names_);
+    for (const auto& sym : names_ | std::views::values) {
+      // the others keep their members in an own scope
+      constexpr auto kMembersFlags = SymbolFlags::kStructural | SymbolFlags::kEnum | SymbolFlags::kList;
+      if ((sym.Flags() & kMembersFlags) && sym.Members() != nullptr) {
+        total += sym.Members()->HeapUsage();
+      }
+    }
+    return total;
+  }
+
  private:
   std::unordered_map<std::string_view, Symbol> names_;
 };
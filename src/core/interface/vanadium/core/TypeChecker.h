@@ -1,5 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <string_view>
+
 #include <vanadium/ast/ASTNodes.h>
 #include <vanadium/ast/ASTTypes.h>
 #include <vanadium/lib/EnumFlags.h>
@@ -97,9 +103,41 @@ namespace utils {
                                                                   const ast::nodes::ParenExpr*);
 }  // namespace utils
 
+// The message is rendered only when it is to be shown (see the formatter below), the error keeps just its operands:
+// the texts are either in the source of the file or in SourceFile::type_errors_arena
 struct TypeError {
   ast::Range range;
-  std::string message;
+  enum class Type : std::uint8_t {
+    kNotATypeReference,         // texts: expression
+    kNotSubscriptable,          // texts: type
+    kNotAType,                  // texts: expression
+    kArrayDepthMismatch,        // counts: actual depth, expected depth
+    kTemplateInsteadOfValue,
+    kTypeMismatch,              // texts: expected type, actual type
+    kArgumentsCount,            // counts: expected, provided
+    kNotArrayLike,              // texts: type
+    kArgumentOutOfOrder,        // texts: argument, the one it should precede
+    kUnknownArgument,           // texts: argument, callable
+    kUnknownProperty,           // texts: property, type
+    kPositionalAfterNamed,
+    kUnionArgumentsCount,
+    kNotCallable,               // texts: expression
+    kErrorTypeNotCallable,      // texts: property
+    kNumericExpected,           // texts: actual type
+    kStringOrListExpected,      // texts: actual type
+    kStringExpected,            // texts: actual type
+    kListElementExpected,
+    kElementsCountOutOfBounds,  // counts: minimum, maximum
+    kNotStructural,             // texts: type
+    kNonStaticProperty,         // texts: property, type
+    kNonInstanceProperty,       // texts: property, type
+    kInvertedBounds,
+    kUnexpectedReturnValue,
+    kMissingReturnValue,
+    kUnionExpected,
+  } type;
+  std::array<std::string_view, 2> texts{};
+  std::array<std::size_t, 2> counts{};
 };
 
 void PerformTypeCheck(SourceFile&);
@@ -107,3 +145,11 @@ void PerformTypeCheck(SourceFile&);
 }  // namespace checker
 
 }  // namespace vanadium::core
+
+template <>
+struct std::formatter<vanadium::core::checker::TypeError> {
+  constexpr auto parse(std::format_parse_context& ctx) {
+    return ctx.begin();
+  }
+  std::format_context::iterator format(const vanadium::core::checker::TypeError&, std::format_context&) const;
+};
@@ -0,0 +1,90 @@
+#include "vanadium/core/MemoryStats.h"
+
+#include <cstddef>
+#include <ranges>
+
+#include <vanadium/lib/Bitset.h>
+#include <vanadium/lib/MemoryUsage.h>
+
+#include "vanadium/core/Program.h"
+#include "vanadium/core/Semantic.h"
+
+namespace vanadium::core {
+
+namespace {
+std::size_t HeapUsage(const lib::Bitset& bitset) {
+  return ((bitset.Size() + lib::Bitset::kCellBits - 1) / lib::Bitset::kCellBits) * sizeof(lib::Bitset::storage_t);
+}
+
+std::size_t HeapUsage(const ExternallyResolvedGroup& group) {
+  return lib::HeapUsage(group.idents) + lib::HeapUsage(group.scopes) + HeapUsage(group.resolution_set);
+}
+
+std::size_t HeapUsage(const ModuleDescriptor& module) {
+  std::size_t total{0};
+  total += lib::HeapUsage(module.imports);
+  total += lib::HeapUsage(module.dependencies);
+  for (const auto& entries : module.dependencies | std::views::values) {
+    total += lib::HeapUsage(entries);
+    for (const auto& entry : entries) {
+      total += HeapUsage(entry.contribution);
+    }
+  }
+  total += lib::HeapUsage(module.transitive_dependency_providers);
+  total += lib::HeapUsage(module.dependents);
+  total += lib::HeapUsage(module.required_imports);
+  total += HeapUsage(module.externals.primary) + HeapUsage(module.externals.secondary);
+  total += lib::HeapUsage(module.externals.augmented);
+  for (const auto& group : module.externals.augmented) {
+    total += HeapUsage(group);
+  }
+  total += lib::HeapUsage(module.unresolved);
+  return total;
+}
+
+// The scopes are allocated in the arena of the file, their tables and vectors are not
+std::size_t HeapUsage(const semantic::Scope* scope) {
+  std::size_t total = scope->symbols.HeapUsage() + lib::HeapUsage(scope->augmentation);
+  total += lib::HeapUsage(scope->GetChildren());
+  for (const auto* child : scope->GetChildren()) {
+    total += HeapUsage(child);
+  }
+  return total;
+}
+}  // namespace
+
+ProgramMemoryStats Program::CollectMemoryStats() const {
+  ProgramMemoryStats stats;
+  stats.files.reserve(files_.size());
+  for (const auto& [path, sf] : files_) {
+    auto& fs = stats.files.emplace_back(FileMemoryStats{
+        .path = path,
+        .arena_allocated = sf.arena.SpaceAllocated(),
+        .arena_used = sf.arena.SpaceUsed(),
+        .source = lib::HeapUsage(path) + lib::HeapUsage(sf.src) + sf.ast.lines.Count() * sizeof(ast::pos_t) +
+                  lib::HeapUsage(sf.ast.trivia),
+    });
+
+    fs.diagnostics += lib::HeapUsage(sf.ast.errors) + lib::HeapUsage(sf.semantic_errors) +
+                      lib::HeapUsage(sf.type_errors);
+    for (const auto& err : sf.ast.errors) {
+      fs.diagnostics += lib::HeapUsage(err.description);
+    }
+    fs.diagnostics += sf.type_errors_arena.SpaceAllocated();
+
+    if (sf.module) {
+      fs.module = HeapUsage(*sf.module);
+      if (sf.module->scope != nullptr) {
+        fs.symbol_tables = HeapUsage(sf.module->scope);
+      }
+    }
+  }
+
+  stats.index = lib::HeapUsage(files_) + lib::HeapUsage(modules_);
+  stats.asn_modules_arena = asn_modules_.SpaceAllocated();
+  stats.asn_modules_heap = asn_modules_.HeapUsage();
+
+  return stats;
+}
+
+}  // namespace vanadium::core
@@ -4,13 +4,24 @@
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <deque>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <ranges>
+#include <span>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include <oneapi/tbb/flow_graph.h>
+#include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/parallel_for_each.h>
 #include <oneapi/tbb/spin_mutex.h>
 #include <oneapi/tbb/task_group.h>
@@ -37,25 +48,45 @@ inline AnalysisState::Value& operator|=(AnalysisState::Value& lhs, AnalysisState
 bool IsAsnModule(const SourceFile& sf) {
   return sf.path.ends_with(".asn");
 }
+
+// The syntax tree takes about 8 bytes per source byte and its token array about 3 more,
+// the first block is sized for them upfront
+constexpr std::size_t kArenaBytesPerSourceByte = 11;
 }  // namespace
 
 void Program::Update(const lib::Consumer<const ProgramModifier&>& modify) {
+  std::vector<std::string> dropped_modules;
+  tbb::spin_mutex dropped_modules_mutex;
+
   tbb::task_group wg;
   modify({
       .update =
           [&](const std::string& path, const FileReadFn& read) {
             wg.run([this, path, read] {
-              UpdateFile(path, read);
+              UpdateFile(path, read, false);
+            });
+          },
+      .update_buffer =
+          [&](const std::string& path, const FileReadFn& read) {
+            wg.run([this, path, read] {
+              UpdateFile(path, read, true);
             });
           },
       .drop =
           [&](const std::string& path) {
-            wg.run([this, path] {
-              DropFile(path);
+            wg.run([this, path, &dropped_modules, &dropped_modules_mutex] {
+              if (auto module_name = DropFile(path)) {
+                std::lock_guard lock(dropped_modules_mutex);
+                dropped_modules.emplace_back(std::move(*module_name));
+              }
             });
           },
   });
   wg.wait();
+
+  if (!dropped_modules.empty()) {
+    InvalidateImporters(dropped_modules);
+  }
 }
 
 void Program::Commit(const lib::Consumer<const ProgramModifier&>& modify) {
@@ -63,7 +94,9 @@ void Program::Commit(const lib::Consumer<const ProgramModifier&>& modify) {
   Analyze();
 }
 
-void Program::UpdateFile(const std::string& path, const FileReadFn& read) {
+void Program::UpdateFile(const std::string& path, const FileReadFn& read, bool editor_buffer) {
+  analysis_revision_.fetch_add(1, std::memory_order_release);
+
   decltype(files_)::iterator it;
   bool inserted;
   {
@@ -76,41 +109,78 @@ void Program::UpdateFile(const std::string& path, const FileReadFn& read) {
     sf.path = path;
     sf.program = this;
   } else {
-    DetachFile(sf);
-    sf.module = std::nullopt;
-    sf.semantic_errors.clear();
-    sf.arena.Reset();
+    ResetFile(sf);
   }
 
   read(path, sf.src);
   if (!IsAsnModule(sf)) {
+    sf.arena.Reserve(sf.src.size() * kArenaBytesPerSourceByte);
     sf.ast = ast::Parse(sf.arena, sf.src);
     sf.ast.root->file = &sf;
 
     AttachFile(sf);
   } else {
-    // Attach is postponed until all other modules are parsed
-    asn_modules_.Update(&sf, sf.src);
+    // Attach is postponed until the module is demanded (see TransformDemandedAsnModules)
+    asn_modules_.Update(&sf, sf.src, !editor_buffer);
+    MarkDirty(sf);
   }
 }
 
-void Program::DropFile(const std::string& path) {
-  auto& sf = files_[path];
+std::optional<std::string> Program::DropFile(const std::string& path) {
+  SourceFile* sf;
+  {
+    std::lock_guard lock(files_mutex_);
+    const auto it = files_.find(path);
+    if (it == files_.end()) {
+      return std::nullopt;
+    }
+    sf = &it->second;
+  }
 
-  DetachFile(sf);
+  analysis_revision_.fetch_add(1, std::memory_order_release);
+
+  std::optional<std::string> module_name;
+  if (sf->module) {
+    module_name.emplace(sf->module->name);
+  }
+
+  DetachFile(*sf);
+
+  if (IsAsnModule(*sf)) {
+    asn_modules_.Drop(sf);
+  }
 
-  if (IsAsnModule(sf)) {
-    // asnModules_.Drop((void*) &sf);
+  {
+    std::lock_guard lock(dirty_files_mutex_);
+    dirty_files_.erase(sf);
+  }
+  {
+    std::lock_guard lock(files_mutex_);
+    files_.erase(path);
   }
 
-  files_.erase(path);
+  return module_name;
+}
+
+// DetachFile takes care of the modules that have been bound to something from the dropped one,
+// while the rest of its importers have to be analyzed again as well to report it missing
+void Program::InvalidateImporters(std::span<const std::string> module_names) {
+  for (auto* program : WithDependents()) {
+    for (auto& sf : program->files_ | std::views::values) {
+      if (sf.module && std::ranges::any_of(module_names, [&](const std::string& name) {
+            return sf.module->imports.contains(name);
+          })) {
+        program->MarkDirty(sf);
+      }
+    }
+  }
 }
 
 void Program::AttachFile(SourceFile& sf) {
   semantic::Bind(sf);
 
   if (sf.module.has_value()) [[likely]] {
-    sf.analysis_state = AnalysisState::kDirty;
+    MarkDirty(sf);
   }
 
   {
@@ -160,7 +230,7 @@ void Program::DetachFile(SourceFile& sf) {
       dependent->dependencies.erase(it);
     }
 
-    dependent->sf->analysis_state = AnalysisState::kDirty;
+    dependent->sf->program->MarkDirty(*dependent->sf);
   }
 
   {
@@ -169,6 +239,52 @@ void Program::DetachFile(SourceFile& sf) {
   }
 }
 
+void Program::ResetFile(SourceFile& sf) {
+  DetachFile(sf);
+  sf.module = std::nullopt;
+  sf.semantic_errors.clear();
+  sf.type_errors.clear();  // they refer to the source
+  sf.type_errors_arena.Reset();
+  sf.arena.Reset();
+}
+
+void Program::MarkDirty(SourceFile& sf) {
+  sf.analysis_state = AnalysisState::kDirty;
+  analysis_revision_.fetch_add(1, std::memory_order_release);
+
+  std::lock_guard lock(dirty_files_mutex_);
+  dirty_files_.insert(&sf);
+}
+
+void Program::SetAnalysisSkipped(const std::string& path, bool skipped) {
+  const auto it = files_.find(path);
+  if (it == files_.end()) {
+    return;
+  }
+  auto& sf = it->second;
+  sf.skip_analysis = skipped;
+  analysis_revision_.fetch_add(1, std::memory_order_release);
+  if (!skipped) {
+    // the analysis state is kept, only the missing phases are to be done
+    std::lock_guard lock(dirty_files_mutex_);
+    dirty_files_.insert(&sf);
+  }
+}
+
+void Program::SetTypecheckDeferred(const std::string& path, bool deferred) {
+  const auto it = files_.find(path);
+  if (it == files_.end()) {
+    return;
+  }
+  auto& sf = it->second;
+  sf.typecheck_deferred = deferred;
+  if (!deferred) {
+    // the typecheck only adds the diagnostics, so the revision is kept along with the data derived from it
+    std::lock_guard lock(dirty_files_mutex_);
+    dirty_files_.insert(&sf);
+  }
+}
+
 void Program::AddReference(Program* program) {
   explicit_references_.emplace(program);
   program->direct_dependents_.emplace(this);
@@ -414,70 +530,360 @@ void Program::Crossbind(SourceFile& sf, ExternallyResolvedGroup& ext_group) {
   }
 }
 
-// TODO: quick hack
-extern thread_local bool do_reanalyse_program_deps;
-thread_local bool do_reanalyse_program_deps = true;
+void Program::TransformAsnModule(SourceFile& sf) {
+  ResetFile(sf);
 
-void Program::Analyze() {
-  tbb::parallel_for_each(asn_modules_.Keys<SourceFile>(), [&](SourceFile* sf) {
-    if (sf->analysis_state != AnalysisState::kDirty) {
-      // Hereby, incrementalized ASN.1 modules analysis resides here, in Program
-      // Possible problems:
-      //  1) if it is a multi-project solution, and Program::Analyze was called in a non-optimal order,
-      //     i.e. project's B, which depends on A, crossbind will occur before project A's ASN modules transformation,
-      //     B's crossbind will have invalid state as it did not know about those ASN modules existence
-      // 2) Dirtyness propagation is powered by the crossbind's dependency detector
+  sf.ast = asn_modules_.Transform(&sf, sf.arena);
+  sf.ast.root->file = &sf;
+  AttachFile(sf);
+}
+
+SourceFile* Program::FindAsnModuleFile(std::string_view module_name) {
+  if (auto* sf = asn_modules_.FindModuleKey<SourceFile>(module_name)) {
+    return sf;
+  }
+  for (auto* ref : references_) {
+    if (auto* sf = ref->asn_modules_.FindModuleKey<SourceFile>(module_name)) {
+      return sf;
+    }
+  }
+  return nullptr;
+}
+
+// ASN.1 modules stay parsed in the basket until something needs their TTCN-3 view: either they are imported
+// by a module that is going to be crossbound, or they are to be analyzed themselves (e.g. opened in the editor).
+// A transformed module may import other ASN.1 modules in turn, so the demand is resolved wave by wave.
+// The programs providing the demanded modules are appended to the analyzed ones.
+void Program::TransformDemandedAsnModules(std::vector<Program*>& programs) {
+  std::vector<SourceFile*> demanded;
+  std::unordered_set<SourceFile*> seen;
+
+  const auto demand_file = [&](SourceFile* sf) {
+    // The basket tracks which definitions of the other ASN.1 modules a transformation has used,
+    // so a module whose imports have changed elsewhere is only crossbound again, not retransformed
+    if (!sf->program->asn_modules_.NeedsTransform(sf)) {
       return;
     }
+    if (seen.insert(sf).second) {
+      demanded.push_back(sf);
+    }
+  };
+  const auto demand_imports = [&](SourceFile& sf) {
+    for (const auto& name : sf.module->imports | std::views::keys) {
+      if (auto* provider = sf.program->FindAsnModuleFile(name)) {
+        demand_file(provider);
+      }
+    }
+  };
 
-    // todo: this is a copypaste from Program::UpdateFile
-    DetachFile(*sf);
-    sf->module = std::nullopt;
-    sf->semantic_errors.clear();
-    sf->arena.Reset();
+  const auto demand_own_file = [&](SourceFile* sf) {
+    if (!sf->skip_analysis || sf->module) {  // the transformed ones are kept up to date
+      demand_file(sf);
+    }
+  };
 
-    sf->ast = asn_modules_.Transform(sf, sf->arena);
-    sf->ast.root->file = sf;
-    AttachFile(*sf);
-  });
+  // Only the changed files are looked into, and the ASN.1 modules whose imports have changed
+  for (auto* program : programs) {
+    for (auto* sf : program->dirty_files_) {
+      if (IsAsnModule(*sf)) {
+        demand_own_file(sf);
+      }
+      if (sf->module && !(sf->analysis_state & AnalysisState::kBasicCrossbind)) {
+        demand_imports(*sf);
+      }
+    }
+    program->asn_modules_.ExtractInvalidated<SourceFile>(demand_own_file);
+  }
 
-  tbb::parallel_for_each(files_ | std::views::values, [&](SourceFile& sf) {
-    auto& module = *sf.module;
+  while (!demanded.empty()) {
+    const auto wave = std::exchange(demanded, {});
+    tbb::parallel_for_each(wave, [](SourceFile* sf) {
+      sf->program->TransformAsnModule(*sf);
+    });
+    for (auto* sf : wave) {
+      if (std::ranges::find(programs, sf->program) == programs.end()) {
+        programs.push_back(sf->program);
+      }
+      if (sf->module) {
+        demand_imports(*sf);
+      }
+    }
+  }
+}
+
+void Program::CrossbindFile(SourceFile& sf) {
+  auto& module = *sf.module;
+
+  if (sf.analysis_state == AnalysisState::kDirty) {
+    sf.type_errors.clear();
+    sf.type_errors_arena.Reset();
+  }
+
+  if (!(sf.analysis_state & AnalysisState::kBasicCrossbind)) {
+    module.unresolved.clear();
+
+    Crossbind(sf, module.externals.primary);
+
+    sf.analysis_state |= AnalysisState::kBasicCrossbind;
+  }
 
-    if (sf.analysis_state == AnalysisState::kDirty) {
-      sf.type_errors.clear();
+  if (!sf.skip_analysis && !(sf.analysis_state & AnalysisState::kFullCrossbind)) {
+    Crossbind(sf, module.externals.secondary);
+    for (auto& ext_group : module.externals.augmented) {
+      Crossbind(sf, ext_group);
     }
 
-    if (!(sf.analysis_state & AnalysisState::kBasicCrossbind)) {
-      module.unresolved.clear();
+    sf.analysis_state |= AnalysisState::kFullCrossbind;
+  }
+}
 
-      Crossbind(sf, module.externals.primary);
+namespace {
+void TypecheckFile(SourceFile& sf) {
+  if (!sf.skip_analysis && !sf.typecheck_deferred && !(sf.analysis_state & AnalysisState::kTypecheck)) {
+    checker::PerformTypeCheck(sf);
 
-      sf.analysis_state |= AnalysisState::kBasicCrossbind;
+    sf.analysis_state |= AnalysisState::kTypecheck;
+  }
+}
+
+bool NeedsAnalysis(const SourceFile& sf) {
+  if (!(sf.analysis_state & AnalysisState::kBasicCrossbind)) {
+    return true;
+  }
+  if (sf.skip_analysis) {
+    return false;
+  }
+  if (sf.typecheck_deferred) {
+    return !(sf.analysis_state & AnalysisState::kFullCrossbind);
+  }
+  return sf.analysis_state != AnalysisState::kComplete;
+}
+
+// Strongly connected components of the import graph (imports may be cyclic), Tarjan's algorithm without recursion.
+// Components are numbered in reverse topological order, i.e. a component is numbered after all the ones it imports.
+std::vector<std::uint32_t> CondenseImportGraph(const std::vector<std::vector<std::uint32_t>>& imports,
+                                               std::uint32_t& components_count) {
+  constexpr auto kUnvisited = std::numeric_limits<std::uint32_t>::max();
+
+  const auto n = static_cast<std::uint32_t>(imports.size());
+  std::vector<std::uint32_t> component(n, kUnvisited);
+  std::vector<std::uint32_t> order(n, kUnvisited);
+  std::vector<std::uint32_t> lowlink(n);
+  std::vector<std::uint32_t> stack;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> dfs;  // vertex, next import to visit
+
+  std::uint32_t next_order{0};
+  components_count = 0;
+
+  const auto enter = [&](std::uint32_t v) {
+    order[v] = lowlink[v] = next_order++;
+    stack.push_back(v);
+    dfs.emplace_back(v, 0);
+  };
+
+  for (std::uint32_t root = 0; root < n; ++root) {
+    if (order[root] != kUnvisited) {
+      continue;
     }
+    enter(root);
+    while (!dfs.empty()) {
+      const auto [v, next_import] = dfs.back();
+      if (next_import < imports[v].size()) {
+        ++dfs.back().second;
+        const auto w = imports[v][next_import];
+        if (order[w] == kUnvisited) {
+          enter(w);
+        } else if (component[w] == kUnvisited) {  // still on the stack
+          lowlink[v] = std::min(lowlink[v], order[w]);
+        }
+        continue;
+      }
 
-    if (!sf.skip_analysis && !(sf.analysis_state & AnalysisState::kFullCrossbind)) {
-      Crossbind(sf, module.externals.secondary);
-      for (auto& ext_group : module.externals.augmented) {
-        Crossbind(sf, ext_group);
+      dfs.pop_back();
+      if (!dfs.empty()) {
+        auto& parent_lowlink = lowlink[dfs.back().first];
+        parent_lowlink = std::min(parent_lowlink, lowlink[v]);
       }
 
-      sf.analysis_state |= AnalysisState::kFullCrossbind;
+      if (lowlink[v] == order[v]) {
+        std::uint32_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          component[w] = components_count;
+        } while (w != v);
+        ++components_count;
+      }
     }
-  });
-  tbb::parallel_for_each(files_ | std::views::values, [&](SourceFile& sf) {
-    if (!sf.skip_analysis && !(sf.analysis_state & AnalysisState::kTypecheck)) {
-      checker::PerformTypeCheck(sf);
+  }
+
+  return component;
+}
+}  // namespace
 
-      sf.analysis_state |= AnalysisState::kTypecheck;
+void Program::Analyze(std::span<Program* const> analyzed_programs) {
+  // ASN.1 modules have to be transformed before anything that may import them gets crossbound
+  std::vector<Program*> programs(analyzed_programs.begin(), analyzed_programs.end());
+  TransformDemandedAsnModules(programs);
+
+  // The worklists are drained: the files that don't need the analysis now are enqueued again once they do,
+  // e.g. when they are changed, or when their analysis is not to be skipped anymore
+  std::vector<SourceFile*> files;
+  std::unordered_map<const ModuleDescriptor*, std::uint32_t> file_index;
+  for (auto* program : programs) {
+    for (auto* sf : std::exchange(program->dirty_files_, {})) {
+      if (!sf->module || !NeedsAnalysis(*sf)) {
+        continue;
+      }
+      file_index.emplace(std::addressof(*sf->module), static_cast<std::uint32_t>(files.size()));
+      files.push_back(sf);
+    }
+  }
+  if (files.empty()) {
+    return;
+  }
+  const auto analyzed_count = files.size();
+
+  const auto resolve_imports = [](const SourceFile& sf) {
+    std::vector<const ModuleDescriptor*> imported_modules;
+    for (const auto& name : sf.module->imports | std::views::keys) {
+      const auto* imported_module = sf.program->GetModule(name);
+      if (imported_module != nullptr && imported_module != std::addressof(*sf.module)) {
+        imported_modules.push_back(imported_module);
+      }
     }
+    return imported_modules;
+  };
+
+  // The typecheck of a module may look into any module reachable through its imports,
+  // so it has to wait until all of them are crossbound. The modules which are not analyzed now are already complete,
+  // but the analyzed ones may be reachable through them, so they are walked as well.
+  std::vector<std::vector<const ModuleDescriptor*>> analyzed_imports(analyzed_count);
+  tbb::parallel_for(std::size_t{0}, analyzed_count, [&](std::size_t i) {
+    analyzed_imports[i] = resolve_imports(*files[i]);
   });
 
-  if (do_reanalyse_program_deps) [[likely]] {
-    for (auto* program : direct_dependents_) {
-      program->Analyze();
+  // A few edited modules on top of a deep import chain would have the whole chain walked for nothing,
+  // so once there are more complete modules to walk than the analyzed ones, the typecheck waits for all the crossbinds
+  std::vector<std::vector<std::uint32_t>> imports;
+  imports.reserve(analyzed_count);
+  for (std::size_t i = 0; i < files.size(); ++i) {
+    if (files.size() - analyzed_count > analyzed_count) {
+      files.resize(analyzed_count);
+      tbb::parallel_for_each(files, [](SourceFile* sf) {
+        sf->program->CrossbindFile(*sf);
+      });
+      tbb::parallel_for_each(files, [](SourceFile* sf) {
+        TypecheckFile(*sf);
+      });
+      return;
+    }
+
+    const auto imported_modules = i < analyzed_count ? std::move(analyzed_imports[i]) : resolve_imports(*files[i]);
+    auto& edges = imports.emplace_back();
+    for (const auto* imported_module : imported_modules) {
+      const auto [it, inserted] = file_index.emplace(imported_module, static_cast<std::uint32_t>(files.size()));
+      if (inserted) {
+        files.push_back(imported_module->sf);
+      }
+      edges.push_back(it->second);
+    }
+    std::ranges::sort(edges);
+    edges.erase(std::ranges::unique(edges).begin(), edges.end());
+  }
+
+  std::uint32_t components_count{0};
+  const auto component = CondenseImportGraph(imports, components_count);
+
+  // A component has to be waited for only if something in it or below it is being analyzed,
+  // the others are ready right away. Components are numbered after the ones they import.
+  std::vector<std::vector<std::uint32_t>> members(components_count);
+  std::vector<std::vector<std::uint32_t>> component_imports(components_count);
+  std::vector<bool> pending(components_count, false);
+  for (std::uint32_t i = 0; i < files.size(); ++i) {
+    members[component[i]].push_back(i);
+    for (const auto j : imports[i]) {
+      if (component[j] != component[i]) {
+        component_imports[component[i]].push_back(component[j]);
+      }
     }
   }
+  for (std::uint32_t c = 0; c < components_count; ++c) {
+    std::ranges::sort(component_imports[c]);
+    component_imports[c].erase(std::ranges::unique(component_imports[c]).begin(), component_imports[c].end());
+
+    pending[c] = std::ranges::any_of(members[c],
+                                     [&](std::uint32_t i) {
+                                       return NeedsAnalysis(*files[i]);
+                                     }) ||
+                 std::ranges::any_of(component_imports[c], [&](std::uint32_t d) {
+                   return pending[d];
+                 });
+  }
+
+  using tbb::flow::continue_msg;
+  using TaskNode = tbb::flow::continue_node<continue_msg>;
+
+  tbb::flow::graph graph;
+  tbb::flow::broadcast_node<continue_msg> start(graph);
+  std::deque<TaskNode> tasks;
+  std::vector<TaskNode*> crossbound(components_count, nullptr);  // the component and everything below it
+
+  for (std::uint32_t c = 0; c < components_count; ++c) {
+    if (!pending[c]) {
+      continue;
+    }
+    auto& ready = *(crossbound[c] = &tasks.emplace_back(graph, [](continue_msg) {}));
+
+    bool has_predecessors{false};
+    for (const auto d : component_imports[c]) {
+      if (pending[d]) {
+        tbb::flow::make_edge(*crossbound[d], ready);
+        has_predecessors = true;
+      }
+    }
+    for (const auto i : members[c]) {
+      auto* const sf = files[i];
+      if (!NeedsAnalysis(*sf)) {
+        continue;
+      }
+
+      auto& crossbind = tasks.emplace_back(graph, [sf](continue_msg) {
+        sf->program->CrossbindFile(*sf);
+      });
+      tbb::flow::make_edge(start, crossbind);
+      tbb::flow::make_edge(crossbind, ready);
+      has_predecessors = true;
+
+      auto& typecheck = tasks.emplace_back(graph, [sf](continue_msg) {
+        TypecheckFile(*sf);
+      });
+      tbb::flow::make_edge(ready, typecheck);
+    }
+    if (!has_predecessors) {
+      tbb::flow::make_edge(start, ready);
+    }
+  }
+
+  start.try_put(continue_msg{});
+  graph.wait_for_all();
+}
+
+std::vector<Program*> Program::WithDependents() {
+  std::vector<Program*> programs{this};
+  for (std::size_t i = 0; i < programs.size(); ++i) {
+    for (auto* dependent : programs[i]->direct_dependents_) {
+      if (std::ranges::find(programs, dependent) == programs.end()) {
+        programs.push_back(dependent);
+      }
+    }
+  }
+  return programs;
+}
+
+void Program::Analyze() {
+  // the dependent programs may have been affected by the changes of this one
+  Analyze(WithDependents());
 }
 
 }  // namespace vanadium::core
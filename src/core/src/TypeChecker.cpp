@@ -381,7 +381,8 @@ class IndexExprResolver {
         options_.with_error_emitter([&](ErrorEmitterFn auto emit_error) {
           emit_error(TypeError{
               .range = ie->x->nrange,
-              .message = std::format("'{}' is not a type reference", sf_->Text(ie->x)),
+              .type = TypeError::Type::kNotATypeReference,
+              .texts = {sf_->Text(ie->x)},
           });
         });
         return nullptr;
@@ -425,7 +426,8 @@ class IndexExprResolver {
     options_.with_error_emitter([&](ErrorEmitterFn auto emit_error) {
       emit_error(TypeError{
           .range = x->nrange,
-          .message = std::format("type '{}' is not subscriptable", semantic::utils::GetReadableTypeName(sym)),
+          .type = TypeError::Type::kNotSubscriptable,
+          .texts = {semantic::utils::GetReadableTypeName(sym)},
       });
     });
   }
@@ -1123,6 +1125,16 @@ class BasicTypeChecker {
 
  private:
   void EmitError(TypeError&& err) {
+    // the names coming from the other modules are copied, as those may be changed before the message is rendered
+    const auto* src_begin = sf_.src.data();
+    const auto* src_end = src_begin + sf_.src.size();
+    for (auto& text : err.texts) {
+      if (!text.empty() && (text.data() < src_begin || text.data() >= src_end)) {
+        const auto buf = sf_.type_errors_arena.AllocStringBuffer(text.size());
+        std::ranges::copy(text, buf.begin());
+        text = {buf.data(), buf.size()};
+      }
+    }
     sf_.type_errors.emplace_back(std::move(err));
   }
 
@@ -1168,7 +1180,8 @@ class BasicTypeChecker {
     if (sym && sym != &symbols::kTypeError && !(sym->Flags() & semantic::SymbolFlags::kType)) {
       EmitError({
           .range = n->nrange,
-          .message = std::format("'{}' is not a type", sf_.Text(n)),
+          .type = TypeError::Type::kNotAType,
+          .texts = {sf_.Text(n)},
       });
     }
   }
@@ -1215,7 +1228,8 @@ void BasicTypeChecker::MatchTypes(const ast::Range& range, InstantiatedType actu
   if (actual.depth != expected.depth) {
     EmitError(TypeError{
         .range = range,
-        .message = std::format("expected value of array depth {}, got with depth {}", actual.depth, expected.depth),
+        .type = TypeError::Type::kArrayDepthMismatch,
+        .counts = {actual.depth, expected.depth},
     });
     return;
   }
@@ -1232,7 +1246,7 @@ void BasicTypeChecker::MatchTypes(const ast::Range& range, InstantiatedType actu
     if (!is_legit) {
       EmitError(TypeError{
           .range = range,
-          .message = std::format("expected value, got template"),
+          .type = TypeError::Type::kTemplateInsteadOfValue,
       });
     }
   }
@@ -1274,9 +1288,8 @@ void BasicTypeChecker::MatchTypes(const ast::Range& range, InstantiatedType actu
 
   EmitError(TypeError{
       .range = range,
-      .message =
-          std::format("expected value of type '{}', got '{}'", semantic::utils::GetReadableTypeName(expected.sym),
-                      semantic::utils::GetReadableTypeName(actual.sym)),
+      .type = TypeError::Type::kTypeMismatch,
+      .texts = {semantic::utils::GetReadableTypeName(expected.sym), semantic::utils::GetReadableTypeName(actual.sym)},
   });
 }
 
@@ -1299,7 +1312,8 @@ void BasicTypeChecker::CheckArguments(std::span<const ast::nodes::Expr* const> a
                       .begin = args_range.end - 1,
                       .end = args_range.end,  // closing paren
                   } : args_range,
-              .message = std::format("{} arguments expected, {} provided", minimal_args_cnt, args_count),
+              .type = TypeError::Type::kArgumentsCount,
+              .counts = {minimal_args_cnt, args_count},
           });
     }
   }
@@ -1338,8 +1352,8 @@ void BasicTypeChecker::CheckArguments(std::span<const ast::nodes::Expr* const> a
           // most likely it is IndexExpr, e.g. { [0] := value }
           EmitError(TypeError{
               .range = ae->value->nrange,
-              .message = std::format("type '{}' is not array-like",
-                                     semantic::utils::GetReadableTypeName(params_file, subject_type_sym)),
+              .type = TypeError::Type::kNotArrayLike,
+              .texts = {semantic::utils::GetReadableTypeName(params_file, subject_type_sym)},
           });
           continue;
         }
@@ -1358,8 +1372,8 @@ void BasicTypeChecker::CheckArguments(std::span<const ast::nodes::Expr* const> a
           if (last_named_argument_idx > idx) {
             EmitError(TypeError{
                 .range = ae->nrange,
-                .message = std::format("argument '{}' is out of order, it should precede '{}'", property_name,
-                                       params_file->Text(*params[last_named_argument_idx]->name)),
+                .type = TypeError::Type::kArgumentOutOfOrder,
+                .texts = {property_name, params_file->Text(*params[last_named_argument_idx]->name)},
             });
           }
           last_named_argument_idx = idx;
@@ -1367,16 +1381,9 @@ void BasicTypeChecker::CheckArguments(std::span<const ast::nodes::Expr* const> a
         } else {
           EmitError(TypeError{
               .range = ae->property->nrange,
-              .message = [&] -> std::string {
-                if constexpr (std::is_same_v<TParamDescriptorNode, ast::nodes::FormalPar>) {
-                  return std::format("callable '{}' does not have an argument with name '{}'",
-                                     semantic::utils::GetReadableTypeName(params_file, subject_type_sym),
-                                     property_name);
-                } else {
-                  return std::format("property '{}' does not exist on type '{}'", property_name,
-                                     semantic::utils::GetReadableTypeName(params_file, subject_type_sym));
-                }
-              }(),
+              .type = std::is_same_v<TParamDescriptorNode, ast::nodes::FormalPar> ? TypeError::Type::kUnknownArgument
+                                                                                   : TypeError::Type::kUnknownProperty,
+              .texts = {property_name, semantic::utils::GetReadableTypeName(params_file, subject_type_sym)},
           });
           Visit(argnode);
         }
@@ -1387,7 +1394,7 @@ void BasicTypeChecker::CheckArguments(std::span<const ast::nodes::Expr* const> a
         if (seen_named_argument && !Options.is_union) {
           EmitError(TypeError{
               .range = argnode->nrange,
-              .message = "positional arguments cannot follow named ones",
+              .type = TypeError::Type::kPositionalAfterNamed,
           });
         }
         if (i >= maximal_args_cnt) {
@@ -1404,7 +1411,7 @@ void BasicTypeChecker::CheckArguments(std::span<const ast::nodes::Expr* const> a
     if (!seen_named_argument || args_count != 1) {
       EmitError(TypeError{
           .range = args_range,
-          .message = std::format("exactly one named argument is expected in union"),
+          .type = TypeError::Type::kUnionArgumentsCount,
       });
     }
   }
@@ -1429,9 +1436,9 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
         }
         EmitError(TypeError{
             .range = tgt_errnode->nrange,
-            .message = callee_sym == &symbols::kTypeError
-                           ? std::format("'<error-type>.{}' is not callable", sf_.Text(tgt_errnode))
-                           : std::format("'{}' is not callable", sf_.Text(tgt_errnode)),
+            .type = callee_sym == &symbols::kTypeError ? TypeError::Type::kErrorTypeNotCallable
+                                                       : TypeError::Type::kNotCallable,
+            .texts = {sf_.Text(tgt_errnode)},
         });
         Visit(m->args);
         break;
@@ -1494,7 +1501,8 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
           if (x_type && x_type.sym != &builtins::kInteger && x_type.sym != &builtins::kFloat) [[unlikely]] {
             EmitError(TypeError{
                 .range = m->x->nrange,
-                .message = std::format("integer or float expected, got '{}'", x_type->GetName()),
+                .type = TypeError::Type::kNumericExpected,
+                .texts = {x_type->GetName()},
             });
             break;
           }
@@ -1551,7 +1559,8 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
           if (x_type && !(x_type->Flags() & (semantic::SymbolFlags::kBuiltinString | semantic::SymbolFlags::kList))) {
             EmitError({
                 .range = m->x->nrange,
-                .message = std::format("string or list type expected, got '{}'", x_type->GetName()),
+                .type = TypeError::Type::kStringOrListExpected,
+                .texts = {x_type->GetName()},
             });
           } else {
             match_both(x_type.sym);
@@ -1568,7 +1577,8 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
               !(x_type->Flags() & semantic::SymbolFlags::kEnumMember)) [[unlikely]] {
             EmitError(TypeError{
                 .range = m->x->nrange,
-                .message = std::format("integer or float expected, got '{}'", x_type->GetName()),
+                .type = TypeError::Type::kNumericExpected,
+                .texts = {x_type->GetName()},
             });
             break;
           }
@@ -1584,7 +1594,8 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
           if (x_type && !(x_type->Flags() & semantic::SymbolFlags::kBuiltinStringType)) {
             EmitError({
                 .range = m->x->nrange,
-                .message = std::format("string type expected, got '{}'", x_type->GetName()),
+                .type = TypeError::Type::kStringExpected,
+                .texts = {x_type->GetName()},
             });
             break;
           }
@@ -1598,7 +1609,8 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
               !(x_type.sym->Flags() & semantic::SymbolFlags::kEnum)) [[unlikely]] {
             EmitError(TypeError{
                 .range = m->x->nrange,
-                .message = std::format("integer or float expected, got '{}'", x_type->GetName()),
+                .type = TypeError::Type::kNumericExpected,
+                .texts = {x_type->GetName()},
             });
             break;
           }
@@ -1664,7 +1676,7 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
           // TODO: unify with identical code for Ro chk below
           if (arg->nkind == ast::NodeKind::AssignmentExpr &&
               arg->As<ast::nodes::AssignmentExpr>()->property->nkind != ast::NodeKind::IndexExpr) [[unlikely]] {
-            EmitError({.range = arg->nrange, .message = "list element expected"});
+            EmitError({.range = arg->nrange, .type = TypeError::Type::kListElementExpected});
           }
           const InstantiatedType expected_arg_sym{
               .sym = desired_type.sym,
@@ -1701,7 +1713,8 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
                           .begin = m->nrange.end - 1,
                           .end = m->nrange.end,  // closing paren
                       },
-                  .message = std::format("elements count is restricted to be in between {} and {}", min_args, max_args),
+                  .type = TypeError::Type::kElementsCountOutOfBounds,
+                  .counts = {min_args, max_args},
               });
             }
           }
@@ -1711,7 +1724,7 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
         for (const auto* arg : m->list) {
           if (arg->nkind == ast::NodeKind::AssignmentExpr &&
               arg->As<ast::nodes::AssignmentExpr>()->property->nkind != ast::NodeKind::IndexExpr) [[unlikely]] {
-            EmitError({.range = arg->nrange, .message = "list element expected"});
+            EmitError({.range = arg->nrange, .type = TypeError::Type::kListElementExpected});
           }
           const InstantiatedType expected_arg_sym{
               .sym = element_type_sym,
@@ -1769,31 +1782,32 @@ InstantiatedType BasicTypeChecker::CheckType(const ast::Node* n, InstantiatedTyp
                             .begin = sel->nrange.begin - 1,
                             .end = sel->nrange.end,
                         },
-                    .message = std::format("type '{}' is not structural", semantic::utils::GetReadableTypeName(sym)),
+                    .type = TypeError::Type::kNotStructural,
+                    .texts = {semantic::utils::GetReadableTypeName(sym)},
                 });
               },
           .on_unknown_property =
               [&](const ast::nodes::SelectorExpr* se, const semantic::Symbol* sym) {
                 EmitError(TypeError{
                     .range = se->sel->nrange,
-                    .message = std::format("property '{}' does not exist on type '{}'", sf_.Text(se->sel),
-                                           semantic::utils::GetReadableTypeName(sym)),
+                    .type = TypeError::Type::kUnknownProperty,
+                    .texts = {sf_.Text(se->sel), semantic::utils::GetReadableTypeName(sym)},
                 });
               },
           .on_non_static_property_invalid_access =
               [&](const ast::nodes::SelectorExpr* se, const semantic::Symbol* sym) {
                 EmitError(TypeError{
                     .range = se->sel->nrange,
-                    .message = std::format("property '{}' of type '{}' is not static", sf_.Text(se->sel),
-                                           semantic::utils::GetReadableTypeName(sym)),
+                    .type = TypeError::Type::kNonStaticProperty,
+                    .texts = {sf_.Text(se->sel), semantic::utils::GetReadableTypeName(sym)},
                 });
               },
           .on_static_property_invalid_access =
               [&](const ast::nodes::SelectorExpr* se, const semantic::Symbol* sym) {
                 EmitError(TypeError{
                     .range = se->sel->nrange,
-                    .message = std::format("property '{}' of type '{}' is not instance-bound", sf_.Text(se->sel),
-                                           semantic::utils::GetReadableTypeName(sym)),
+                    .type = TypeError::Type::kNonInstanceProperty,
+                    .texts = {sf_.Text(se->sel), semantic::utils::GetReadableTypeName(sym)},
                 });
               },
       }};
@@ -2004,7 +2018,7 @@ bool BasicTypeChecker::Inspect(const ast::Node* n) {
             if (min_args > max_args) {
               EmitError(TypeError{
                   .range = ls->length->nrange,
-                  .message = "lower bound cannot exceed the highest",
+                  .type = TypeError::Type::kInvertedBounds,
               });
               break;
             }
@@ -2052,7 +2066,7 @@ bool BasicTypeChecker::Inspect(const ast::Node* n) {
         if (m->result) {
           EmitError(TypeError{
               .range = m->result->nrange,
-              .message = "void function should not return a value",
+              .type = TypeError::Type::kUnexpectedReturnValue,
           });
         }
         break;
@@ -2060,7 +2074,7 @@ bool BasicTypeChecker::Inspect(const ast::Node* n) {
       if (!m->result) {
         EmitError(TypeError{
             .range = m->nrange,
-            .message = "return value expected",
+            .type = TypeError::Type::kMissingReturnValue,
         });
         break;
       }
@@ -2148,7 +2162,7 @@ bool BasicTypeChecker::Inspect(const ast::Node* n) {
         if (!tag_type || !(tag_type->Flags() & semantic::SymbolFlags::kUnion)) {
           EmitError(TypeError{
               .range = m->tag->nrange,
-              .message = "union type expected",
+              .type = TypeError::Type::kUnionExpected,
           });
           return true;
         }
@@ -2159,8 +2173,8 @@ bool BasicTypeChecker::Inspect(const ast::Node* n) {
             if (!tag_type->Members()->Has(property)) {
               EmitError(TypeError{
                   .range = cond->nrange,
-                  .message = std::format("property '{}' does not exist on type '{}'", property,
-                                         semantic::utils::GetReadableTypeName(tag_type.sym)),
+                  .type = TypeError::Type::kUnknownProperty,
+                  .texts = {property, semantic::utils::GetReadableTypeName(tag_type.sym)},
               });
             }
           }
@@ -2195,3 +2209,67 @@ void PerformTypeCheck(SourceFile& sf) {
 
 }  // namespace checker
 }  // namespace vanadium::core
+
+std::format_context::iterator std::formatter<vanadium::core::checker::TypeError>::format(
+    const vanadium::core::checker::TypeError& err, std::format_context& ctx) const {
+  using Type = vanadium::core::checker::TypeError::Type;
+  const auto& [a, b] = err.texts;
+  const auto& [n, m] = err.counts;
+  switch (err.type) {
+    case Type::kNotATypeReference:
+      return std::format_to(ctx.out(), "'{}' is not a type reference", a);
+    case Type::kNotSubscriptable:
+      return std::format_to(ctx.out(), "type '{}' is not subscriptable", a);
+    case Type::kNotAType:
+      return std::format_to(ctx.out(), "'{}' is not a type", a);
+    case Type::kArrayDepthMismatch:
+      return std::format_to(ctx.out(), "expected value of array depth {}, got with depth {}", n, m);
+    case Type::kTemplateInsteadOfValue:
+      return std::format_to(ctx.out(), "expected value, got template");
+    case Type::kTypeMismatch:
+      return std::format_to(ctx.out(), "expected value of type '{}', got '{}'", a, b);
+    case Type::kArgumentsCount:
+      return std::format_to(ctx.out(), "{} arguments expected, {} provided", n, m);
+    case Type::kNotArrayLike:
+      return std::format_to(ctx.out(), "type '{}' is not array-like", a);
+    case Type::kArgumentOutOfOrder:
+      return std::format_to(ctx.out(), "argument '{}' is out of order, it should precede '{}'", a, b);
+    case Type::kUnknownArgument:
+      return std::format_to(ctx.out(), "callable '{}' does not have an argument with name '{}'", b, a);
+    case Type::kUnknownProperty:
+      return std::format_to(ctx.out(), "property '{}' does not exist on type '{}'", a, b);
+    case Type::kPositionalAfterNamed:
+      return std::format_to(ctx.out(), "positional arguments cannot follow named ones");
+    case Type::kUnionArgumentsCount:
+      return std::format_to(ctx.out(), "exactly one named argument is expected in union");
+    case Type::kNotCallable:
+      return std::format_to(ctx.out(), "'{}' is not callable", a);
+    case Type::kErrorTypeNotCallable:
+      return std::format_to(ctx.out(), "'<error-type>.{}' is not callable", a);
+    case Type::kNumericExpected:
+      return std::format_to(ctx.out(), "integer or float expected, got '{}'", a);
+    case Type::kStringOrListExpected:
+      return std::format_to(ctx.out(), "string or list type expected, got '{}'", a);
+    case Type::kStringExpected:
+      return std::format_to(ctx.out(), "string type expected, got '{}'", a);
+    case Type::kListElementExpected:
+      return std::format_to(ctx.out(), "list element expected");
+    case Type::kElementsCountOutOfBounds:
+      return std::format_to(ctx.out(), "elements count is restricted to be in between {} and {}", n, m);
+    case Type::kNotStructural:
+      return std::format_to(ctx.out(), "type '{}' is not structural", a);
+    case Type::kNonStaticProperty:
+      return std::format_to(ctx.out(), "property '{}' of type '{}' is not static", a, b);
+    case Type::kNonInstanceProperty:
+      return std::format_to(ctx.out(), "property '{}' of type '{}' is not instance-bound", a, b);
+    case Type::kInvertedBounds:
+      return std::format_to(ctx.out(), "lower bound cannot exceed the highest");
+    case Type::kUnexpectedReturnValue:
+      return std::format_to(ctx.out(), "void function should not return a value");
+    case Type::kMissingReturnValue:
+      return std::format_to(ctx.out(), "return value expected");
+    case Type::kUnionExpected:
+      return std::format_to(ctx.out(), "union type expected");
+  }
+  std::unreachable();
+}
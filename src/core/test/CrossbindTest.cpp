@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <array>
+#include <format>
 #include <initializer_list>
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <vanadium/ast/utils/ASTUtils.h>
 #include <vanadium/core/Program.h>
@@ -559,3 +563,279 @@ TEST_P(AugmentedDirect, Parametrized) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CrossbindTest, AnalyzesProgramsTogether) {
+  const std::unordered_map<std::string, std::string_view> base_files{
+      {kModuleA, "const integer imported_name := 1;"},
+  };
+  const std::unordered_map<std::string, std::string_view> dependent_files{
+      {kModuleB, "import from ModuleA all; import from ModuleC all; const integer canary := imported_name * 2;"},
+      {kModuleC, "import from ModuleA all; import from ModuleB all; const integer other_canary := canary + imported_name;"},
+  };
+  const auto update = [](core::Program& program, const std::unordered_map<std::string, std::string_view>& files) {
+    const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+      srcbuf = wrapModule(path, files.at(path));
+    };
+    program.Update([&](auto& modify) {
+      for (const auto& filename : files | std::ranges::views::keys) {
+        modify.update(filename, read_source);
+      }
+    });
+  };
+
+  core::Program base;
+  core::Program dependent;
+  dependent.AddReference(&base);
+  dependent.SealReferences();
+
+  update(base, base_files);
+  update(dependent, dependent_files);
+
+  // the order of the programs does not matter
+  const std::array<core::Program*, 2> programs{&dependent, &base};
+  core::Program::Analyze(programs);
+
+  for (const auto* program : programs) {
+    for (const auto& sf : program->Files() | std::views::values) {
+      EXPECT_EQ(sf.analysis_state, AnalysisState::kComplete) << sf.path;
+      EXPECT_TRUE(sf.module->unresolved.empty()) << sf.path;
+    }
+  }
+
+  const auto* sym = dependent.Files().at(kModuleC).module->scope->Resolve("imported_name");
+  ASSERT_TRUE(sym != nullptr);
+  EXPECT_TRUE(ast::utils::IsInHierarchyOf(sym->Declaration(), base.Files().at(kModuleA).ast.root));
+}
+
+// The edited modules and the ones bound to them are analyzed again, however far apart they are in the import graph
+TEST_F(CrossbindTest, AnalyzesOnlyChangedModules) {
+  constexpr std::size_t kChainLength = 10;
+
+  core::Program program;
+  std::unordered_map<std::string, std::string> sources;
+  const auto set_source = [&](std::size_t i, std::string_view defined_name, std::string_view value) {
+    sources[std::format("M{}", i)] =
+        i == 0 ? std::format("module M0 {{ const integer {} := {}; }}", defined_name, value)
+               : std::format("module M{0} {{ import from M{1} all; const integer {2} := {3}; }}", i, i - 1,
+                             defined_name, value);
+  };
+  const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+    srcbuf = sources.at(path);
+  };
+  const auto commit = [&](const std::vector<std::size_t>& changed) {
+    program.Commit([&](auto& modify) {
+      for (const auto i : changed) {
+        modify.update(std::format("M{}", i), read_source);
+      }
+    });
+  };
+  const auto file = [&](std::size_t i) -> const SourceFile& {
+    return program.Files().at(std::format("M{}", i));
+  };
+
+  std::vector<std::size_t> chain(kChainLength);
+  for (std::size_t i = 0; i < kChainLength; ++i) {
+    set_source(i, std::format("c{}", i), i == 0 ? "0" : std::format("c{}", i - 1));
+    chain[i] = i;
+  }
+  commit(chain);
+  for (std::size_t i = 0; i < kChainLength; ++i) {
+    ASSERT_EQ(file(i).analysis_state, AnalysisState::kComplete) << i;
+    ASSERT_TRUE(file(i).module->unresolved.empty()) << i;
+  }
+
+  // the bottom and the top of the chain at once: M1 is bound to M0, the modules in between are already complete
+  set_source(0, "c0_renamed", "0");
+  set_source(9, "c9", "c8 + 1");
+  commit({0, 9});
+
+  for (std::size_t i = 0; i < kChainLength; ++i) {
+    EXPECT_EQ(file(i).analysis_state, AnalysisState::kComplete) << i;
+    EXPECT_EQ(file(i).module->unresolved.empty(), i != 1) << i;
+  }
+}
+
+TEST_F(CrossbindTest, TransformsOnlyDemandedAsnModules) {
+  const std::unordered_map<std::string, std::string> files{
+      {"Main.ttcn", "module Main { import from Used all; const UsedInteger canary := 1; }"},
+      {"Used.asn", "Used DEFINITIONS AUTOMATIC TAGS ::= BEGIN UsedInteger ::= INTEGER END"},
+      {"Unused.asn", "Unused DEFINITIONS AUTOMATIC TAGS ::= BEGIN UnusedInteger ::= INTEGER END"},
+  };
+  const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+    srcbuf = files.at(path);
+  };
+
+  core::Program program;
+  program.Update([&](auto& modify) {
+    for (const auto& filename : files | std::ranges::views::keys) {
+      modify.update(filename, read_source);
+    }
+  });
+  for (const auto& path : program.Files() | std::views::keys) {
+    program.SetAnalysisSkipped(path, true);  // as if nothing was opened
+  }
+
+  const std::array<core::Program*, 1> programs{&program};
+  core::Program::Analyze(programs);
+
+  EXPECT_TRUE(program.Files().at("Used.asn").module.has_value());
+  EXPECT_FALSE(program.Files().at("Unused.asn").module.has_value());
+  EXPECT_TRUE(program.Files().at("Main.ttcn").module->unresolved.empty());
+
+  // opening the file makes it demanded
+  program.SetAnalysisSkipped("Unused.asn", false);
+  program.Commit([](auto&) {});
+
+  ASSERT_TRUE(program.Files().at("Unused.asn").module.has_value());
+  EXPECT_EQ(program.Files().at("Unused.asn").module->name, "Unused");
+}
+
+TEST_F(CrossbindTest, DropsAsnModules) {
+  const std::unordered_map<std::string, std::string> files{
+      {"Main.ttcn", "module Main { import from Used all; const UsedInteger canary := 1; }"},
+      {"Used.asn", "Used DEFINITIONS AUTOMATIC TAGS ::= BEGIN UsedInteger ::= INTEGER END"},
+  };
+  const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+    srcbuf = files.at(path);
+  };
+  const auto read_renamed = [&](const std::string&, std::string& srcbuf) -> void {
+    srcbuf = files.at("Used.asn");
+  };
+
+  core::Program program;
+  program.Commit([&](auto& modify) {
+    for (const auto& filename : files | std::ranges::views::keys) {
+      modify.update(filename, read_source);
+    }
+  });
+  ASSERT_TRUE(program.Files().at("Main.ttcn").module->unresolved.empty());
+
+  // the module has to be found in the new file regardless of the order the changes are applied in
+  program.Commit([&](auto& modify) {
+    modify.drop("Used.asn");
+    modify.update("Renamed.asn", read_renamed);
+  });
+
+  EXPECT_FALSE(program.Files().contains("Used.asn"));
+  ASSERT_NE(program.GetModule("Used"), nullptr);
+  EXPECT_EQ(program.GetModule("Used")->sf->path, "Renamed.asn");
+  EXPECT_TRUE(program.Files().at("Renamed.asn").ast.errors.empty());
+  EXPECT_TRUE(program.Files().at("Main.ttcn").module->unresolved.empty());
+
+  program.Commit([&](auto& modify) {
+    modify.drop("Renamed.asn");
+  });
+
+  EXPECT_EQ(program.Files().size(), 1);
+  EXPECT_EQ(program.GetModule("Used"), nullptr);
+  EXPECT_FALSE(program.Files().at("Main.ttcn").module->unresolved.empty());
+}
+
+TEST_F(CrossbindTest, CollectsMemoryStats) {
+  const std::unordered_map<std::string, std::string_view> files{
+      {kModuleA, "type record Provider { integer a, charstring b } const integer imported_name := 1;"},
+      {kModuleB, "import from ModuleA all; function target() { var Provider p; }"},
+  };
+  core::Program program;
+  ASSERT_TRUE(prepareWorkingSet(program, files));
+
+  const auto stats = program.CollectMemoryStats();
+  ASSERT_EQ(stats.files.size(), files.size());
+  for (const auto& fs : stats.files) {
+    EXPECT_TRUE(files.contains(std::string(fs.path)));
+    EXPECT_GT(fs.arena_used, 0) << fs.path;
+    EXPECT_GE(fs.arena_allocated, fs.arena_used) << fs.path;
+    EXPECT_GT(fs.symbol_tables, 0) << fs.path;
+    EXPECT_EQ(fs.diagnostics, 0) << fs.path;
+    if (fs.path == kModuleB) {
+      EXPECT_GT(fs.module, 0);  // the imports
+    }
+  }
+  EXPECT_EQ(stats.Total(), stats.FilesTotal() + stats.index + stats.asn_modules_arena + stats.asn_modules_heap);
+  EXPECT_EQ(stats.asn_modules_arena, 0);
+
+  program.Commit([&](auto& modify) {
+    modify.drop(kModuleB);
+  });
+  EXPECT_EQ(program.CollectMemoryStats().files.size(), 1);
+}
+
+TEST_F(CrossbindTest, AdvancesAnalysisRevisionUponChanges) {
+  const std::unordered_map<std::string, std::string_view> files{
+      {kModuleA, "const integer imported_name := 1;"},
+      {kModuleB, "import from ModuleA all; const integer canary := imported_name;"},
+  };
+  core::Program program;
+  ASSERT_TRUE(prepareWorkingSet(program, files));
+
+  // nothing has changed, the results derived from the analysis are still valid
+  const auto revision = core::Program::AnalysisRevision();
+  program.Commit([](auto&) {});
+  EXPECT_EQ(core::Program::AnalysisRevision(), revision);
+
+  // the update is applied asynchronously, the reader has to outlive the call
+  const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+    srcbuf = wrapModule(path, files.at(path));
+  };
+  program.Commit([&](auto& modify) {
+    modify.update(kModuleA, read_source);
+  });
+  EXPECT_GT(core::Program::AnalysisRevision(), revision);
+
+  const auto dropped_revision = core::Program::AnalysisRevision();
+  program.Commit([&](auto& modify) {
+    modify.drop(kModuleB);
+  });
+  EXPECT_GT(core::Program::AnalysisRevision(), dropped_revision);
+}
+
+TEST_F(CrossbindTest, KeepsNamesOfTypeErrorsFromOtherModules) {
+  const std::unordered_map<std::string, std::string_view> files{
+      {kModuleA, "type record Provider { integer a }"},
+      {kModuleB, "import from ModuleA all; const Provider canary := 1;"},
+  };
+  core::Program program;
+  ASSERT_TRUE(prepareWorkingSet(program, files));
+
+  const auto& errors = program.Files().at(kModuleB).type_errors;
+  ASSERT_EQ(errors.size(), 1);
+  EXPECT_EQ(std::format("{}", errors.front()), "expected value of type 'record Provider', got 'integer'");
+
+  // the message is rendered when it is needed, by then the module the type comes from may have changed
+  const std::string_view provider_src = program.Files().at(kModuleA).src;
+  for (const auto text : errors.front().texts) {
+    EXPECT_FALSE(text.data() >= provider_src.data() && text.data() < provider_src.data() + provider_src.size());
+  }
+}
+
+TEST_F(CrossbindTest, DefersOnlyTypecheck) {
+  const std::unordered_map<std::string, std::string_view> files{
+      {kModuleA, "type record Provider { integer a }"},
+      {kModuleB, "import from ModuleA all; const Provider canary := 1;"},
+  };
+  core::Program program;
+  ASSERT_TRUE(prepareWorkingSet(program, files));
+  ASSERT_EQ(program.Files().at(kModuleB).type_errors.size(), 1);
+
+  // the dependent is reanalyzed upon the edit, but only crossbound
+  program.SetTypecheckDeferred(kModuleB, true);
+  const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+    srcbuf = wrapModule(path, files.at(path));
+  };
+  program.Commit([&](auto& modify) {
+    modify.update(kModuleA, read_source);
+  });
+
+  const auto& dependent = program.Files().at(kModuleB);
+  EXPECT_EQ(dependent.analysis_state, AnalysisState::kBasicCrossbind | AnalysisState::kFullCrossbind);
+  EXPECT_TRUE(dependent.module->unresolved.empty());
+  EXPECT_TRUE(dependent.type_errors.empty());
+
+  const auto revision = core::Program::AnalysisRevision();
+  program.SetTypecheckDeferred(kModuleB, false);
+  program.Commit([](auto&) {});
+
+  EXPECT_EQ(dependent.analysis_state, AnalysisState::kComplete);
+  EXPECT_EQ(dependent.type_errors.size(), 1);
+  EXPECT_EQ(core::Program::AnalysisRevision(), revision);  // only the diagnostics have been added
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/ast/ASTTypes.h>
+
+namespace vanadium::format {
+
+struct Options {
+  std::uint32_t indent_width{2};
+  bool use_tabs{false};
+  std::uint32_t max_empty_lines{1};
+};
+
+// 0-based, both ends included
+struct LineRange {
+  ast::pos_t first;
+  ast::pos_t last;
+
+  [[nodiscard]] bool Contains(ast::pos_t line) const noexcept {
+    return first <= line && line <= last;
+  }
+};
+
+// Only the whitespace between the tokens is ever replaced, the tokens are kept as they are
+struct Replacement {
+  ast::Range range;
+  std::string text;
+};
+
+// The replacements in the order of the source. When the lines are given, the whitespace outside of them is kept,
+// while the whole source is still looked through for the nesting of the brackets
+[[nodiscard]] std::vector<Replacement> Format(const ast::AST& ast, const Options& options = {},
+                                              std::optional<LineRange> lines = std::nullopt);
+
+// Returns nullopt if the source is formatted already
+[[nodiscard]] std::optional<std::string> FormatSource(const ast::AST& ast, const Options& options = {});
+
+[[nodiscard]] std::string Apply(std::string_view src, std::span<const Replacement> replacements);
+
+// The lines to be formatted once the character has been typed next to the position, see
+// textDocument/onTypeFormatting: the block closed by '}' or the line ended by ';'
+[[nodiscard]] std::optional<LineRange> OnTypeLines(const ast::AST& ast, ast::pos_t pos, char ch);
+
+}  // namespace vanadium::format
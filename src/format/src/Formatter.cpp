@@ -0,0 +1,516 @@
+#include "vanadium/format/Formatter.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/ast/ASTNodes.h>
+#include <vanadium/ast/ASTTypes.h>
+#include <vanadium/ast/Scanner.h>
+
+namespace vanadium::format {
+
+namespace {
+
+using ast::TokenKind;
+
+// in the levels of indentation, relative to the first line of the statement
+constexpr std::uint32_t kContinuationLevels = 2;
+
+// All the tokens including the trivia, in the order of the source
+std::vector<ast::Token> CollectTokens(const ast::AST& ast) {
+  std::vector<ast::Token> tokens;
+  if (ast.tokens.empty() || !ast.errors.empty()) {
+    // the malformed tokens are not kept by the parser, while they have to stay as they are
+    ast::parser::Scanner scanner(ast.src);
+    for (auto tok = scanner.Scan(); tok.kind != TokenKind::kEOF; tok = scanner.Scan()) {
+      tokens.push_back(tok);
+    }
+    return tokens;
+  }
+  const auto code = ast.tokens.first(ast.tokens.size() - 1);  // without kEOF
+  tokens.reserve(code.size() + ast.trivia.size());
+  std::ranges::merge(code, ast.trivia, std::back_inserter(tokens), {}, [](const ast::Token& tok) {
+    return tok.range.begin;
+  }, [](const ast::Token& tok) {
+    return tok.range.begin;
+  });
+  return tokens;
+}
+
+[[nodiscard]] bool IsOpening(TokenKind kind) {
+  return kind == TokenKind::LPAREN || kind == TokenKind::LBRACK || kind == TokenKind::LBRACE;
+}
+
+[[nodiscard]] TokenKind OpeningOf(TokenKind kind) {
+  switch (kind) {
+    case TokenKind::RPAREN:
+      return TokenKind::LPAREN;
+    case TokenKind::RBRACK:
+      return TokenKind::LBRACK;
+    case TokenKind::RBRACE:
+      return TokenKind::LBRACE;
+    default:
+      return TokenKind::kSentinel;
+  }
+}
+
+[[nodiscard]] bool IsClosing(TokenKind kind) {
+  return OpeningOf(kind) != TokenKind::kSentinel;
+}
+
+// the whitespace around them is never touched within a line
+[[nodiscard]] bool IsVerbatim(TokenKind kind) {
+  switch (kind) {
+    case TokenKind::COMMENT:
+    case TokenKind::PREPROC:
+    case TokenKind::ILLEGAL:
+    case TokenKind::UNTERMINATED:
+    case TokenKind::MALFORMED:
+    case TokenKind::COLON:  // both 'x : T' and inline templates like 'T:?' are common
+      return true;
+    default:
+      return false;
+  }
+}
+
+// a line following them starts a new statement unless the AST says otherwise
+[[nodiscard]] bool EndsStatement(TokenKind kind) {
+  switch (kind) {
+    case TokenKind::kSentinel:
+    case TokenKind::SEMICOLON:
+    case TokenKind::COMMA:
+    case TokenKind::LBRACE:
+    case TokenKind::RBRACE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+[[nodiscard]] bool IsOperand(TokenKind kind) {
+  switch (kind) {
+    case TokenKind::IDENT:
+    case TokenKind::INT:
+    case TokenKind::FLOAT:
+    case TokenKind::STRING:
+    case TokenKind::BITSTRING:
+    case TokenKind::HEXSTRING:
+    case TokenKind::OCTETSTRING:
+    case TokenKind::RPAREN:
+    case TokenKind::RBRACK:
+    case TokenKind::TRUE:
+    case TokenKind::FALSE:
+    case TokenKind::kNULL:
+    case TokenKind::OMIT:
+    case TokenKind::kINFINITY:
+    case TokenKind::kNaN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+[[nodiscard]] bool IsBinaryOnly(TokenKind kind) {
+  switch (kind) {
+    case TokenKind::DIV:
+    case TokenKind::SHL:
+    case TokenKind::ROL:
+    case TokenKind::SHR:
+    case TokenKind::ROR:
+    case TokenKind::CONCAT:
+    case TokenKind::REDIR:
+    case TokenKind::DECODE:
+    case TokenKind::ASSIGN:
+    case TokenKind::EQ:
+    case TokenKind::NE:
+    case TokenKind::LT:
+    case TokenKind::LE:
+    case TokenKind::GT:
+    case TokenKind::GE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// '(' right after them is a call, e.g. 'f(x)' or 'length(1..2)', rather than 'if (x)'
+[[nodiscard]] bool IsCallee(TokenKind kind) {
+  switch (kind) {
+    case TokenKind::IDENT:
+    case TokenKind::RPAREN:
+    case TokenKind::RBRACK:
+    case TokenKind::MODIF:
+    case TokenKind::LENGTH:
+    case TokenKind::CREATE:
+    case TokenKind::REGEXP:
+    case TokenKind::TEMPLATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+[[nodiscard]] bool IsIndexed(TokenKind kind) {
+  return kind == TokenKind::IDENT || kind == TokenKind::RPAREN || kind == TokenKind::RBRACK;
+}
+
+// The positions the tokens alone cannot tell about
+struct AstHints {
+  std::vector<ast::pos_t> binary_ops;
+  std::vector<ast::pos_t> unary_ops;
+  std::vector<ast::pos_t> statements;
+
+  explicit AstHints(const ast::AST& ast) {
+    if (!ast.root) {
+      return;
+    }
+    ast.root->Accept([&](const ast::Node* n) {
+      switch (n->nkind) {
+        case ast::NodeKind::BinaryExpr:
+          binary_ops.push_back(n->As<ast::nodes::BinaryExpr>()->op.range.begin);
+          break;
+        case ast::NodeKind::UnaryExpr:
+          unary_ops.push_back(n->As<ast::nodes::UnaryExpr>()->op.range.begin);
+          break;
+        case ast::NodeKind::Definition:
+        case ast::NodeKind::CaseClause:
+        case ast::NodeKind::CommClause:
+        case ast::NodeKind::WithStmt:
+          statements.push_back(n->nrange.begin);
+          break;
+        default:
+          if (n->parent && n->parent->nkind == ast::NodeKind::BlockStmt) {
+            statements.push_back(n->nrange.begin);
+          }
+          break;
+      }
+      return true;
+    });
+    std::ranges::sort(binary_ops);
+    std::ranges::sort(unary_ops);
+    std::ranges::sort(statements);
+  }
+};
+
+// Whether the tokens written next to each other are scanned as they were
+[[nodiscard]] bool Adjoins(std::string_view a, std::string_view b) {
+  std::string joined;
+  joined.reserve(a.size() + b.size());
+  joined += a;
+  joined += b;
+  ast::parser::Scanner scanner(joined);
+  return scanner.Scan().range.end == a.size() && scanner.Scan().range.end == joined.size();
+}
+
+class TokenFormatter {
+ public:
+  TokenFormatter(const ast::AST& ast, const Options& options, std::optional<LineRange> lines)
+      : ast_(ast), src_(ast.src), options_(options), lines_(lines), hints_(ast) {
+    const auto lf = src_.find('\n');
+    newline_ = (lf != std::string_view::npos && lf > 0 && src_[lf - 1] == '\r') ? "\r\n" : "\n";
+  }
+
+  std::vector<Replacement> Run() {
+    const auto tokens = CollectTokens(ast_);
+    if (tokens.empty()) {
+      return {};
+    }
+
+    const ast::Token* prev{nullptr};
+    bool prev_binary{false};
+    ast::pos_t line{0};
+
+    std::size_t next_code{0};
+    for (std::size_t i = 0; i < tokens.size(); ++i) {
+      const auto& tok = tokens[i];
+      const ast::Range gap{.begin = prev ? prev->range.end : 0, .end = tok.range.begin};
+      const auto original = gap.String(src_);
+      const auto breaks = static_cast<ast::pos_t>(std::ranges::count(original, '\n'));
+
+      const bool binary = IsBinary(tok);
+      if (!prev || breaks > 0) {
+        // a comment goes along with the code following it
+        next_code = std::max(next_code, i);
+        while (next_code < tokens.size() && tokens[next_code].kind == TokenKind::COMMENT) {
+          ++next_code;
+        }
+        const auto level = StartLine(tok, next_code < tokens.size() ? &tokens[next_code] : nullptr);
+        std::string text = prev ? LineBreaks(*prev, breaks) : std::string{};
+        if (tok.kind != TokenKind::PREPROC) {
+          text += Indent(level);
+        }
+        // the blank lines before the first token belong to its line
+        Emit(gap, original, std::move(text), prev ? line : breaks, line + breaks);
+      } else {
+        Emit(gap, original, Spacing(*prev, prev_binary, tok, binary, original), line, line);
+      }
+      Advance(tok, !prev || breaks > 0);
+
+      line += breaks + static_cast<ast::pos_t>(std::ranges::count(tok.On(src_), '\n'));
+      prev = &tok;
+      prev_binary = binary;
+    }
+
+    const ast::Range gap{.begin = prev->range.end, .end = static_cast<ast::pos_t>(src_.size())};
+    const auto original = gap.String(src_);
+    Emit(gap, original, LineBreaks(*prev, 1), line, line + static_cast<ast::pos_t>(std::ranges::count(original, '\n')));
+
+    return std::move(replacements_);
+  }
+
+ private:
+  struct Bracket {
+    TokenKind kind;
+    std::uint32_t level;  // of the lines within
+    std::uint32_t closing_level;
+  };
+
+  [[nodiscard]] static bool Contains(const std::vector<ast::pos_t>& positions, ast::pos_t pos) {
+    return std::ranges::binary_search(positions, pos);
+  }
+
+  [[nodiscard]] bool IsBinary(const ast::Token& tok) const {
+    if (Contains(hints_.binary_ops, tok.range.begin)) {
+      return true;
+    }
+    if (Contains(hints_.unary_ops, tok.range.begin)) {
+      return false;
+    }
+    if (IsBinaryOnly(tok.kind)) {
+      return true;
+    }
+    return (tok.kind == TokenKind::ADD || tok.kind == TokenKind::SUB) && IsOperand(last_code_);
+  }
+
+  [[nodiscard]] static bool IsUnary(TokenKind kind, bool binary) {
+    return !binary && (kind == TokenKind::ADD || kind == TokenKind::SUB || kind == TokenKind::EXCL);
+  }
+
+  // The indentation level of the line starting with the token, the code is the first token past the comments
+  std::uint32_t StartLine(const ast::Token& tok, const ast::Token* code) {
+    const bool in_block = brackets_.empty() || brackets_.back().kind == TokenKind::LBRACE;
+    const std::uint32_t base = brackets_.empty() ? 0 : brackets_.back().level;
+
+    continuation_ = false;
+    if (IsClosing(tok.kind)) {
+      const auto it = std::ranges::find(brackets_ | std::views::reverse, OpeningOf(tok.kind), &Bracket::kind);
+      line_level_ = it == brackets_.rend() ? base : it->closing_level;
+      stmt_level_ = line_level_;
+    } else if (in_block && code && !IsClosing(code->kind) && !EndsStatement(last_code_) &&
+               !(code->kind == TokenKind::LBRACE && !IsBinaryOnly(last_code_)) &&
+               !Contains(hints_.statements, code->range.begin)) {
+      continuation_ = true;
+      line_level_ = stmt_level_ + kContinuationLevels;
+    } else {
+      line_level_ = base;
+      stmt_level_ = line_level_;
+    }
+    return line_level_;
+  }
+
+  void Advance(const ast::Token& tok, bool starts_line) {
+    if (tok.kind == TokenKind::MODULE && brackets_.empty()) {
+      module_pending_ = true;
+    } else if (tok.kind == TokenKind::LBRACE) {
+      // the block opened at the end of a continuation line, e.g. after 'runs on C', belongs to the statement
+      const auto level = (continuation_ && !starts_line) ? stmt_level_ : line_level_;
+      // the definitions of a module are not indented, as there is hardly anything besides them in the file
+      const bool module_body = std::exchange(module_pending_, false) && brackets_.empty();
+      brackets_.push_back({.kind = tok.kind, .level = module_body ? level : level + 1, .closing_level = level});
+    } else if (IsOpening(tok.kind)) {
+      brackets_.push_back({.kind = tok.kind, .level = line_level_ + 1, .closing_level = line_level_});
+    } else if (IsClosing(tok.kind)) {
+      // unbalanced ones are left alone, as the rest of the file would be indented after them
+      const auto it = std::ranges::find(brackets_ | std::views::reverse, OpeningOf(tok.kind), &Bracket::kind);
+      if (it != brackets_.rend()) {
+        brackets_.erase(std::prev(it.base()), brackets_.end());
+      }
+    }
+
+    if (tok.kind == TokenKind::PREPROC) {
+      last_code_ = TokenKind::kSentinel;
+    } else if (tok.kind != TokenKind::COMMENT) {
+      last_code_ = tok.kind;
+    }
+  }
+
+  [[nodiscard]] std::string Indent(std::uint32_t level) const {
+    return options_.use_tabs ? std::string(level, '\t') : std::string(level * options_.indent_width, ' ');
+  }
+
+  [[nodiscard]] std::string LineBreaks(const ast::Token& prev, ast::pos_t breaks) const {
+    breaks = std::min(breaks, options_.max_empty_lines + 1);
+    std::string text;
+    for (ast::pos_t i = 0; i < breaks; ++i) {
+      // line comments and directives take the '\r' of their line
+      text += (i == 0 && newline_.size() > 1 && prev.On(src_).ends_with('\r')) ? "\n" : newline_;
+    }
+    return text;
+  }
+
+  [[nodiscard]] std::string Spacing(const ast::Token& prev, bool prev_binary, const ast::Token& next,
+                                    bool next_binary, std::string_view original) const {
+    if (IsVerbatim(prev.kind) || IsVerbatim(next.kind)) {
+      return std::string(original);
+    }
+    if (!Spaced(prev.kind, prev_binary, next.kind, next_binary) &&
+        (original.empty() || Adjoins(prev.On(src_), next.On(src_)))) {
+      return {};
+    }
+    return " ";
+  }
+
+  [[nodiscard]] static bool Spaced(TokenKind p, bool p_binary, TokenKind n, bool n_binary) {
+    if (n == TokenKind::COMMA || n == TokenKind::SEMICOLON) {
+      return false;
+    }
+    if (p == TokenKind::COMMA || p == TokenKind::SEMICOLON) {
+      return true;
+    }
+    if (p == TokenKind::LBRACE) {
+      return n != TokenKind::RBRACE;
+    }
+    if (n == TokenKind::RBRACE) {
+      return true;
+    }
+    if (p == TokenKind::LPAREN || p == TokenKind::LBRACK || n == TokenKind::RPAREN || n == TokenKind::RBRACK) {
+      return false;
+    }
+    const auto is_tight = [](TokenKind kind) {
+      return kind == TokenKind::DOT || kind == TokenKind::RANGE || kind == TokenKind::ELLIPSIS ||
+             kind == TokenKind::COLONCOLON;
+    };
+    if (is_tight(p) || is_tight(n)) {
+      return false;
+    }
+    if (p_binary || n_binary) {
+      return true;
+    }
+    if (IsUnary(p, p_binary)) {
+      return false;
+    }
+    if (n == TokenKind::LPAREN) {
+      return !IsCallee(p);
+    }
+    if (n == TokenKind::LBRACK) {
+      return !IsIndexed(p);
+    }
+    return true;
+  }
+
+  void Emit(ast::Range gap, std::string_view original, std::string text, ast::pos_t first_line,
+            ast::pos_t last_line) {
+    if (text == original) {
+      return;
+    }
+    if (lines_) {
+      const bool first_in = lines_->Contains(first_line);
+      const bool last_in = lines_->Contains(last_line);
+      if (!first_in && !last_in) {
+        return;
+      }
+      if (!first_in || !last_in) {
+        // the line outside keeps its trailing whitespace or indentation
+        if (first_in) {
+          const auto lf = original.rfind('\n');
+          gap.end = gap.begin + static_cast<ast::pos_t>(lf) + 1;
+          text.resize(text.rfind('\n') + 1);
+        } else {
+          auto lf = original.find('\n');
+          if (lf > 0 && original[lf - 1] == '\r') {
+            --lf;
+          }
+          gap.begin += static_cast<ast::pos_t>(lf);
+        }
+        original = gap.String(src_);
+        if (text == original) {
+          return;
+        }
+      }
+    }
+    replacements_.push_back(Replacement{.range = gap, .text = std::move(text)});
+  }
+
+  const ast::AST& ast_;
+  std::string_view src_;
+  const Options& options_;
+  std::optional<LineRange> lines_;
+  AstHints hints_;
+  std::string_view newline_;
+
+  std::vector<Bracket> brackets_;
+  TokenKind last_code_{TokenKind::kSentinel};  // the last token other than a comment
+  std::uint32_t line_level_{0};
+  std::uint32_t stmt_level_{0};  // of the first line of the current statement
+  bool continuation_{false};
+  bool module_pending_{false};  // the next top-level '{' opens the module body
+
+  std::vector<Replacement> replacements_;
+};
+
+}  // namespace
+
+std::vector<Replacement> Format(const ast::AST& ast, const Options& options, std::optional<LineRange> lines) {
+  return TokenFormatter(ast, options, lines).Run();
+}
+
+std::optional<std::string> FormatSource(const ast::AST& ast, const Options& options) {
+  const auto replacements = Format(ast, options);
+  if (replacements.empty()) {
+    return std::nullopt;
+  }
+  return Apply(ast.src, replacements);
+}
+
+std::string Apply(std::string_view src, std::span<const Replacement> replacements) {
+  std::string result;
+  result.reserve(src.size());
+  ast::pos_t last{0};
+  for (const auto& [range, text] : replacements) {
+    result += src.substr(last, range.begin - last);
+    result += text;
+    last = range.end;
+  }
+  result += src.substr(last);
+  return result;
+}
+
+std::optional<LineRange> OnTypeLines(const ast::AST& ast, ast::pos_t pos, char ch) {
+  const auto kind = ch == '}' ? TokenKind::RBRACE : ch == ';' ? TokenKind::SEMICOLON : TokenKind::kSentinel;
+  if (kind == TokenKind::kSentinel) {
+    return std::nullopt;
+  }
+
+  std::vector<ast::pos_t> blocks;
+  for (const auto& tok : ast.tokens) {
+    if (tok.kind == TokenKind::kEOF || tok.range.begin > pos) {
+      break;
+    }
+    // the editors report the position either before or after the character
+    if (tok.kind == kind && (tok.range.begin == pos || tok.range.end == pos)) {
+      const auto line = ast.lines.LineOf(tok.range.begin);
+      if (kind == TokenKind::RBRACE && !blocks.empty()) {
+        return LineRange{.first = ast.lines.LineOf(blocks.back()), .last = line};
+      }
+      return LineRange{.first = line, .last = line};
+    }
+    if (tok.kind == TokenKind::LBRACE) {
+      blocks.push_back(tok.range.begin);
+    } else if (tok.kind == TokenKind::RBRACE && !blocks.empty()) {
+      blocks.pop_back();
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace vanadium::format
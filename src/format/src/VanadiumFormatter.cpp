@@ -1,5 +0,0 @@
-#include <iostream>
-
-int main() {
-  std::cout << "Test" << std::endl;
-}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/ast/Parser.h>
+#include <vanadium/lib/Arena.h>
+
+#include "vanadium/format/Formatter.h"
+
+using namespace vanadium;
+
+namespace {
+std::string FormatLines(std::string_view src, std::optional<format::LineRange> lines = std::nullopt,
+                        const format::Options& options = {}) {
+  lib::Arena arena;
+  const auto ast = ast::Parse(arena, src);
+  return format::Apply(src, format::Format(ast, options, lines));
+}
+
+std::optional<format::LineRange> OnType(std::string_view src, ast::pos_t pos, char ch) {
+  lib::Arena arena;
+  const auto ast = ast::Parse(arena, src);
+  return format::OnTypeLines(ast, pos, ch);
+}
+}  // namespace
+
+TEST(FormatterTest, IndentsBlocksAndSpacesTokens) {
+  constexpr std::string_view kSource = R"(module M{
+function f(integer x,integer y)return integer{
+var integer z:=x+y*2;
+if(z>0){
+    return -z ;
+  }
+return f( z-1 , -1 );
+}
+}
+)";
+  EXPECT_EQ(FormatLines(kSource), R"(module M {
+function f(integer x, integer y) return integer {
+  var integer z := x + y * 2;
+  if (z > 0) {
+    return -z;
+  }
+  return f(z - 1, -1);
+}
+}
+)");
+}
+
+TEST(FormatterTest, KeepsCommentsAndDirectives) {
+  constexpr std::string_view kSource = "module M {\n"
+                                       "#define X\n"
+                                       "      // leading\n"
+                                       "const integer c := 1;    // trailing\n"
+                                       "\n"
+                                       "\n"
+                                       "\n"
+                                       "  /* block\n"
+                                       "     comment */\n"
+                                       "   const charstring s := \"a  b\";\n"
+                                       "}";
+  EXPECT_EQ(FormatLines(kSource), "module M {\n"
+                                  "#define X\n"
+                                  "// leading\n"
+                                  "const integer c := 1;    // trailing\n"
+                                  "\n"
+                                  "/* block\n"
+                                  "     comment */\n"
+                                  "const charstring s := \"a  b\";\n"
+                                  "}\n");
+}
+
+TEST(FormatterTest, IndentsContinuationLines) {
+  constexpr std::string_view kSource = R"(module M {
+const integer c :=
+1 +
+2
+const integer d := f(1,
+2)
+function g()
+runs on C
+{
+g();
+}
+}
+)";
+  EXPECT_EQ(FormatLines(kSource), R"(module M {
+const integer c :=
+    1 +
+    2
+const integer d := f(1,
+  2)
+function g()
+    runs on C
+{
+  g();
+}
+}
+)");
+}
+
+TEST(FormatterTest, IsIdempotent) {
+  constexpr std::string_view kSource = R"(module M {
+template R t := { a := ?, b := * };
+testcase tc() runs on C system S {
+  alt {
+    [] p.receive(R:{ a := -1 }) -> value v {
+      log(v.a[0], 1..2);
+    }
+    [else] {
+      setverdict(fail);
+    }
+  }
+}
+}
+)";
+  EXPECT_EQ(FormatLines(kSource), kSource);
+}
+
+TEST(FormatterTest, FormatsOnlyTheGivenLines) {
+  constexpr std::string_view kSource = "module M {\n"
+                                       "const integer a:=1;\n"
+                                       "  const integer b:=2;   \n"
+                                       "const integer c:=3;\n"
+                                       "}\n";
+  EXPECT_EQ(FormatLines(kSource, format::LineRange{.first = 2, .last = 2}), "module M {\n"
+                                                                             "const integer a:=1;\n"
+                                                                             "const integer b := 2;\n"
+                                                                             "const integer c:=3;\n"
+                                                                             "}\n");
+}
+
+TEST(FormatterTest, KeepsLineEndings) {
+  constexpr std::string_view kSource = "module M {\r\n// c\r\nfunction f() {\r\nf();\r\n}\r\n}\r\n";
+  EXPECT_EQ(FormatLines(kSource, std::nullopt, format::Options{.use_tabs = true}),
+            "module M {\r\n// c\r\nfunction f() {\r\n\tf();\r\n}\r\n}\r\n");
+}
+
+TEST(FormatterTest, FindsLinesAffectedByTyping) {
+  constexpr std::string_view kSource = "module M {\n"
+                                       "function f() {\n"
+                                       "var integer x := 1;\n"
+                                       "}\n"
+                                       "}\n";
+  // the position is the one right after the typed character
+  const auto after = [&](std::string_view s) {
+    return static_cast<ast::pos_t>(kSource.find(s) + 1);
+  };
+
+  const auto block = OnType(kSource, after("}"), '}');
+  ASSERT_TRUE(block.has_value());
+  EXPECT_EQ(block->first, 1);
+  EXPECT_EQ(block->last, 3);
+
+  const auto statement = OnType(kSource, after(";"), ';');
+  ASSERT_TRUE(statement.has_value());
+  EXPECT_EQ(statement->first, 2);
+  EXPECT_EQ(statement->last, 2);
+
+  EXPECT_FALSE(OnType(kSource, after("x"), 'x').has_value());
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vanadium/lib/jsonrpc/Common.h>
+#include <vanadium/lib/lserver/OrderingGate.h>
 
 namespace vanadium::lserver {  // todo: change namespace
 
@@ -9,9 +10,11 @@ namespace rpc {
 template <typename T>
 using ExpectedResult = std::expected<T, lib::jsonrpc::Error>;
 
-template <glz::string_literal Name, typename Params, typename Result>
+// Methods mutating the session data should be exclusive, so they are not interleaved with the readers
+template <glz::string_literal Name, typename Params, typename Result, MessageOrdering Ordering>
 struct Method {
   static constexpr auto kMethodName = Name;
+  static constexpr auto kOrdering = Ordering;
   using TParams = Params;
   using TResult = Result;
 };
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include <LSProtocol.h>
 #include <LSProtocolEx.h>
 
@@ -8,7 +10,10 @@
 namespace vanadium::ls {
 namespace clientMessaging {
 
-lsp::ShowMessageRequestResult ShowMessage(LsContext&, lsp::ShowMessageRequestParams&&);
+using ShowMessageChoiceFn = std::function<void(lsp::ShowMessageRequestResult&&)>;
+
+// Does not wait for the user, the choice (if any actions are offered) is reported to on_choice later on
+void ShowMessage(LsContext&, lsp::ShowMessageRequestParams&&, ShowMessageChoiceFn on_choice = nullptr);
 
 }  // namespace clientMessaging
 }  // namespace vanadium::ls
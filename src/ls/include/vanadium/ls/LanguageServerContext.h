@@ -8,13 +8,20 @@
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/task_arena.h>
 
+#include <LSProtocolMemory.h>
+
 #include <vanadium/core/Program.h>
 #include <vanadium/lib/Arena.h>
+#include <vanadium/lib/ArenaResource.h>
 #include <vanadium/lib/Metaprogramming.h>
+#include <vanadium/lib/ScopedValue.h>
 #include <vanadium/lib/lserver/Connection.h>
 #include <vanadium/lint/Linter.h>
 #include <vanadium/tooling/Solution.h>
 
+#include "LanguageServerDependentDiagnostics.h"
+#include "LanguageServerFileEvents.h"
+#include "LanguageServerInlayHintCache.h"
 #include "LanguageServerSession.h"
 #include "LanguageServerSolution.h"
 
@@ -34,6 +41,9 @@ struct LsContext {
 
   std::optional<tooling::Solution> solution;
   std::unordered_map<std::string, std::int32_t> file_versions;
+  std::optional<FileEventsDebouncer> file_events;
+  std::optional<DependentDiagnostics> dependent_diagnostics;
+  InlayHintCache inlay_hints;
 
   lint::Linter linter;
 
@@ -44,7 +54,23 @@ struct LsContext {
   //
 
   lib::Arena& TemporaryArena() {
-    return temporary_arena_.local();
+    return bound_temporary_arena_ ? *bound_temporary_arena_ : temporary_arena_.local();
+  }
+
+  // Runs the handler inside the shared task_arena with the temporary arena bound to the thread for its duration.
+  // The protocol containers built meanwhile take their memory from the arena as well (see LSProtocolMemory.h),
+  // so the whole response goes away at once when the arena is reset.
+  // The binding is thread-local, hence the isolation: while waiting for its parallel work the thread
+  // could otherwise pick up a task of another request, which would allocate from this arena and lose it on reset.
+  template <typename F>
+    requires(std::is_invocable_v<F>)
+  void ExecuteWithTemporaryArena(lib::Arena& arena, F&& f) {
+    task_arena.execute([&] {
+      tbb::this_task_arena::isolate([&] {
+        const TemporaryArenaBinding binding{arena};
+        std::forward<F>(f)();
+      });
+    });
   }
 
   template <typename T, typename... Args>
@@ -55,11 +81,12 @@ struct LsContext {
   template <typename F>
     requires(std::is_invocable_v<F, LsSessionRef &&>)
   auto LockData(F f) {
-    // TODO: lock data, RWmutex with writer preference
+    // no locking is needed here: methods modifying the data are exclusive (see rpc::Method::kOrdering),
+    // and the connection never runs them alongside the other ones
     return f({
         .solution = *solution,
         .linter = linter,
-        .arena = temporary_arena_.local(),
+        .arena = TemporaryArena(),
     });
   }
 
@@ -98,7 +125,19 @@ struct LsContext {
   }
 
  private:
+  class TemporaryArenaBinding {
+   public:
+    explicit TemporaryArenaBinding(lib::Arena& arena)
+        : resource_(arena), bound_arena_(bound_temporary_arena_, &arena), bound_resource_(&resource_) {}
+
+   private:
+    lib::ArenaResource resource_;
+    lib::ScopedValue<lib::Arena*> bound_arena_;
+    lsp::ScopedMemoryResource bound_resource_;
+  };
+
   tbb::enumerable_thread_specific<lib::Arena> temporary_arena_;
+  inline static thread_local lib::Arena* bound_temporary_arena_{nullptr};
 };
 
 }  // namespace vanadium::ls
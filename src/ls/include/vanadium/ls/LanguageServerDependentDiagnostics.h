@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <vanadium/core/Program.h>
+
+namespace vanadium::ls {
+
+struct LsContext;
+
+// An edit of a module makes its dependents dirty, and the open ones are to get their diagnostics refreshed too.
+// Typechecking them right away would hold up the edited document, e.g. upon typing in a module of the shared types,
+// so their typecheck is deferred (they are still crossbound fully, which is what the requests look at),
+// and then they are typechecked and published in the background, a batch per tick
+class DependentDiagnostics {
+ public:
+  struct Entry {
+    core::Program* program;
+    std::string path;
+  };
+  using ScheduleFn = std::function<void()>;
+
+  DependentDiagnostics(std::chrono::milliseconds interval, ScheduleFn schedule_tick);
+
+  DependentDiagnostics(const DependentDiagnostics&) = delete;
+  DependentDiagnostics& operator=(const DependentDiagnostics&) = delete;
+
+  // The entries go in front of the queued ones, in the given order, as the latest edit matters the most
+  void Enqueue(std::span<const Entry> entries);
+  // Returns whether the file was queued, i.e. its typecheck is still deferred
+  bool Cancel(std::string_view path);
+
+  [[nodiscard]] std::vector<Entry> TakeBatch(std::size_t n);
+  void TickDone();
+
+ private:
+  void Run(const std::stop_token& stop);
+
+  std::chrono::milliseconds interval_;
+  ScheduleFn schedule_tick_;
+
+  std::mutex mutex_;
+  std::condition_variable_any cv_;
+  std::deque<Entry> queue_;
+  bool tick_pending_{false};
+
+  std::jthread timer_;  // the last one, so that it is stopped before the rest is gone
+};
+
+// The open documents depending on the edited file, most bound to it first, with their typecheck deferred until
+// the background tick. To be called before the edited file is updated, as the update unbinds the dependents
+[[nodiscard]] std::vector<DependentDiagnostics::Entry> DeferOpenDependents(const core::SourceFile& file);
+
+// Analyzes the next batch of the queued documents and publishes their diagnostics
+void PublishDependentDiagnostics(LsContext&);
+
+}  // namespace vanadium::ls
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <LSProtocol.h>
+
+namespace vanadium::ls {
+
+struct LsContext;
+
+// The events of the watched files come in bursts, e.g. thousands of them upon git checkout, so they are collected
+// until none have been received for the window, and then the flush is scheduled to ingest them at once
+class FileEventsDebouncer {
+ public:
+  using Events = std::unordered_map<std::string, lsp::FileChangeType>;  // by the URI, the latest one wins
+  using ScheduleFn = std::function<void()>;
+
+  FileEventsDebouncer(std::chrono::milliseconds window, ScheduleFn schedule_flush);
+
+  FileEventsDebouncer(const FileEventsDebouncer&) = delete;
+  FileEventsDebouncer& operator=(const FileEventsDebouncer&) = delete;
+
+  void Add(std::span<const lsp::FileEvent> events);
+  [[nodiscard]] Events Take();
+
+ private:
+  void Run(const std::stop_token& stop);
+
+  std::chrono::milliseconds window_;
+  ScheduleFn schedule_flush_;
+
+  std::mutex mutex_;
+  std::condition_variable_any cv_;
+  Events events_;
+  std::optional<std::chrono::steady_clock::time_point> deadline_;
+
+  std::jthread timer_;  // the last one, so that it is stopped before the rest is gone
+};
+
+// Each of the affected programs is updated with all of its files at once, the files are read and parsed in parallel,
+// then the whole solution is analyzed in a single pass
+void IngestFileEvents(LsContext&, const FileEventsDebouncer::Events&);
+
+}  // namespace vanadium::ls
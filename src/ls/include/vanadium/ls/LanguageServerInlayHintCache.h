@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/core/TypeChecker.h>
+
+namespace vanadium::ls {
+
+// The inlay hint targets of the files, kept for as long as the analysis revision stays the same
+// (see core::Program::AnalysisRevision), so that scrolling through a file does not deduce the types of its
+// composite literals over and over, and a hint gets resolved right from the entry its payload refers to
+class InlayHintCache {
+ public:
+  struct Entry {
+    const ast::Node* node;                    // CallExpr or CompositeLiteral
+    const ast::Node* target;                  // FormalPars or the structural type declaration, nullptr if none
+    core::checker::InstantiatedType cl_type;  // the deduced type of the CompositeLiteral
+  };
+  using EntryId = std::uint32_t;
+
+  class FileEntries {
+   public:
+    [[nodiscard]] std::uint64_t Revision() const noexcept {
+      return revision_;
+    }
+
+    [[nodiscard]] std::optional<EntryId> Find(const ast::Node* n) const {
+      const auto it = index_.find(n);
+      return it == index_.end() ? std::nullopt : std::optional{it->second};
+    }
+    [[nodiscard]] const Entry* Get(EntryId id) const {
+      return id < entries_.size() ? &entries_[id] : nullptr;
+    }
+
+    EntryId Add(const Entry& entry) {
+      const auto id = static_cast<EntryId>(entries_.size());
+      entries_.push_back(entry);
+      index_.emplace(entry.node, id);
+      return id;
+    }
+
+   private:
+    friend class InlayHintCache;
+
+    std::uint64_t revision_{0};
+    std::vector<Entry> entries_;
+    std::unordered_map<const ast::Node*, EntryId> index_;
+  };
+
+  // The entries of the file are locked for the duration of the call,
+  // and the ones left from another revision are dropped beforehand
+  template <typename F>
+  auto With(const std::string& path, std::uint64_t revision, F f) {
+    const auto slot = Acquire(path);
+    std::lock_guard l(slot->mutex);
+    if (slot->entries.revision_ != revision) {
+      slot->entries = FileEntries{};
+      slot->entries.revision_ = revision;
+    }
+    return f(slot->entries);
+  }
+
+  void Drop(const std::string& path);
+
+ private:
+  struct Slot {
+    std::mutex mutex;
+    FileEntries entries;
+  };
+
+  [[nodiscard]] std::shared_ptr<Slot> Acquire(const std::string& path);
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Slot>> files_;
+};
+
+}  // namespace vanadium::ls
@@ -15,43 +15,53 @@ namespace vanadium::ls {
 namespace rpc = lserver::rpc;
 
 // subclass over using-alias to avoid too much noise from templates in stacktraces
-#define DECL_METHOD(NAME, HANDLE, PARAMS, RESULT, RETVAL) \
-  struct NAME : rpc::Method<HANDLE, PARAMS, RESULT> {     \
-    static RETVAL invoke(LsContext&, const PARAMS&);      \
+#define DECL_METHOD(NAME, HANDLE, PARAMS, RESULT, RETVAL, ORDERING)      \
+  struct NAME : rpc::Method<HANDLE, PARAMS, RESULT, lserver::ORDERING> { \
+    static RETVAL invoke(LsContext&, const PARAMS&);                     \
   };
 
-#define DECL_REQUEST_0(NAME, PARAMS, RESULT) DECL_METHOD(NAME, #NAME, PARAMS, RESULT, rpc::ExpectedResult<RESULT>)
-#define DECL_REQUEST_1(W0, NAME, PARAMS, RESULT)                                \
-  namespace W0 {                                                                \
-  DECL_METHOD(NAME, #W0 "/" #NAME, PARAMS, RESULT, rpc::ExpectedResult<RESULT>) \
+// requests only read the session data, while notifications (didOpen, didChange, ...) modify it
+#define DECL_REQUEST(NAME, HANDLE, PARAMS, RESULT) \
+  DECL_METHOD(NAME, HANDLE, PARAMS, RESULT, rpc::ExpectedResult<RESULT>, MessageOrdering::kConcurrent)
+#define DECL_NOTIFIC(NAME, HANDLE, PARAMS) \
+  DECL_METHOD(NAME, HANDLE, PARAMS, lib::jsonrpc::Empty, void, MessageOrdering::kExclusive)
+
+#define DECL_REQUEST_0(NAME, PARAMS, RESULT) DECL_REQUEST(NAME, #NAME, PARAMS, RESULT)
+#define DECL_REQUEST_1(W0, NAME, PARAMS, RESULT)    \
+  namespace W0 {                                    \
+  DECL_REQUEST(NAME, #W0 "/" #NAME, PARAMS, RESULT) \
   }
-#define DECL_REQUEST_2(W0, W1, NAME, PARAMS, RESULT)                                    \
-  namespace W0::W1 {                                                                    \
-  DECL_METHOD(NAME, #W0 "/" #W1 "/" #NAME, PARAMS, RESULT, rpc::ExpectedResult<RESULT>) \
+#define DECL_REQUEST_2(W0, W1, NAME, PARAMS, RESULT)        \
+  namespace W0::W1 {                                        \
+  DECL_REQUEST(NAME, #W0 "/" #W1 "/" #NAME, PARAMS, RESULT) \
   }
 
-#define DECL_NOTIFIC_0(NAME, PARAMS) DECL_METHOD(NAME, #NAME, PARAMS, lib::jsonrpc::Empty, void)
-#define DECL_NOTIFIC_1(W0, NAME, PARAMS)                              \
-  namespace W0 {                                                      \
-  DECL_METHOD(NAME, #W0 "/" #NAME, PARAMS, lib::jsonrpc::Empty, void) \
+#define DECL_NOTIFIC_0(NAME, PARAMS) DECL_NOTIFIC(NAME, #NAME, PARAMS)
+#define DECL_NOTIFIC_1(W0, NAME, PARAMS)    \
+  namespace W0 {                            \
+  DECL_NOTIFIC(NAME, #W0 "/" #NAME, PARAMS) \
   }
-#define DECL_NOTIFIC_2(W0, W1, NAME, PARAMS)                                  \
-  namespace W0::W1 {                                                          \
-  DECL_METHOD(NAME, #W0 "/" #W1 "/" #NAME, PARAMS, lib::jsonrpc::Empty, void) \
+#define DECL_NOTIFIC_2(W0, W1, NAME, PARAMS)        \
+  namespace W0::W1 {                                \
+  DECL_NOTIFIC(NAME, #W0 "/" #W1 "/" #NAME, PARAMS) \
   }
 
 // NOLINTBEGIN(readability-identifier-naming)
 
 namespace methods {
 
-DECL_REQUEST_0(initialize, lsp::InitializeParams, lsp::InitializeResult);
+DECL_METHOD(initialize, "initialize", lsp::InitializeParams, lsp::InitializeResult,
+            rpc::ExpectedResult<lsp::InitializeResult>, MessageOrdering::kExclusive)
 DECL_NOTIFIC_0(initialized, lib::jsonrpc::Empty);
-DECL_REQUEST_0(shutdown, lib::jsonrpc::Empty, std::nullptr_t);
+DECL_METHOD(shutdown, "shutdown", lib::jsonrpc::Empty, std::nullptr_t, rpc::ExpectedResult<std::nullptr_t>,
+            MessageOrdering::kExclusive)
 DECL_NOTIFIC_0(exit, lib::jsonrpc::Empty);
 
 namespace dollar {
-DECL_METHOD(cancelRequest, "$/cancelRequest", lsp::CancelParams, lib::jsonrpc::Empty, void)
-DECL_METHOD(setTrace, "$/setTrace", lsp::SetTraceParams, lib::jsonrpc::Empty, void)
+DECL_METHOD(cancelRequest, "$/cancelRequest", lsp::CancelParams, lib::jsonrpc::Empty, void,
+            MessageOrdering::kConcurrent)
+DECL_METHOD(setTrace, "$/setTrace", lsp::SetTraceParams, lib::jsonrpc::Empty, void, MessageOrdering::kConcurrent)
+DECL_REQUEST(memoryStats, "$/vanadium/memoryStats", lib::jsonrpc::Empty, lsp::MemoryStatsResult)
 }  // namespace dollar
 
 // textDocument
@@ -72,6 +82,8 @@ DECL_REQUEST_1(textDocument, inlayHint, lsp::InlayHintParams, lsp::InlayHintResu
 DECL_REQUEST_1(textDocument, documentSymbol, lsp::DocumentSymbolParams, lsp::DocumentSybmolResult);
 DECL_REQUEST_1(textDocument, signatureHelp, lsp::SignatureHelpParams, lsp::SignatureHelpResult);
 DECL_REQUEST_2(textDocument, semanticTokens, range, lsp::SemanticTokensRangeParams, lsp::SemanticTokensRangeResult);
+DECL_REQUEST_1(textDocument, rangeFormatting, lsp::DocumentRangeFormattingParams, lsp::FormattingResult);
+DECL_REQUEST_1(textDocument, onTypeFormatting, lsp::DocumentOnTypeFormattingParams, lsp::FormattingResult);
 
 // workspace
 DECL_NOTIFIC_1(workspace, didChangeWatchedFiles, lsp::DidChangeWatchedFilesParams);
@@ -90,6 +102,8 @@ DECL_REQUEST_1(inlayHint, resolve, lsp::InlayHint, lsp::InlayHint);
 #undef DECL_REQUEST_2
 #undef DECL_REQUEST_1
 #undef DECL_REQUEST_0
+#undef DECL_NOTIFIC
+#undef DECL_REQUEST
 #undef DECL_METHOD
 
 // NOLINTEND(readability-identifier-naming)
@@ -11,7 +11,7 @@
 namespace vanadium::ls {
 namespace detail {
 
-std::vector<lsp::Diagnostic> CollectDiagnostics(const core::SourceFile& file, LsSessionRef d);
+lsp::vector<lsp::Diagnostic> CollectDiagnostics(const core::SourceFile& file, LsSessionRef d);
 
 }  // namespace detail
 }  // namespace vanadium::ls
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <optional>
+
+#include <LSProtocol.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/format/Formatter.h>
+#include <vanadium/lib/Arena.h>
+
+namespace vanadium::ls {
+namespace detail {
+
+// The texts of the edits are allocated in the arena
+[[nodiscard]] lsp::vector<lsp::TextEdit> FormatLines(const core::SourceFile& file, const lsp::FormattingOptions& options,
+                                                     std::optional<format::LineRange> lines, lib::Arena& arena);
+
+}  // namespace detail
+}  // namespace vanadium::ls
@@ -4,15 +4,17 @@
 
 #include <vanadium/core/Program.h>
 
+#include "vanadium/ls/LanguageServerInlayHintCache.h"
 #include "vanadium/ls/LanguageServerSession.h"
 
 namespace vanadium::ls {
 namespace detail {
 
-[[nodiscard]] std::vector<lsp::InlayHint> CollectInlayHints(const lsp::InlayHintParams&, const core::SourceFile&,
-                                                            LsSessionRef);
+[[nodiscard]] lsp::vector<lsp::InlayHint> CollectInlayHints(const lsp::InlayHintParams&, const core::SourceFile&,
+                                                            LsSessionRef, InlayHintCache&);
 
-[[nodiscard]] std::optional<lsp::InlayHint> ResolveInlayHint(const lsp::InlayHint& original_hint, LsSessionRef);
+[[nodiscard]] std::optional<lsp::InlayHint> ResolveInlayHint(const lsp::InlayHint& original_hint, LsSessionRef,
+                                                             InlayHintCache&);
 
 }  // namespace detail
 }  // namespace vanadium::ls
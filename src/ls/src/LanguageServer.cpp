@@ -1,7 +1,10 @@
 #include "vanadium/ls/LanguageServer.h"
 
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <string_view>
+#include <unordered_map>
 
 #include <glaze/json.hpp>
 
@@ -20,6 +23,16 @@
 namespace vanadium::ls {
 
 constexpr std::size_t kServerBacklog = 6;
+constexpr std::chrono::milliseconds kFileEventsWindow{50};
+constexpr std::chrono::milliseconds kDependentDiagnosticsInterval{100};
+
+namespace {
+struct MethodInfo {
+  lserver::MessageOrdering ordering;
+  // responses of the same method tend to be of the same size, it helps to pick a suitable buffer upfront
+  std::atomic<std::size_t> last_response_size{0};
+};
+}  // namespace
 
 using ServerMethods = mp::Typelist<methods::initialize,   //
                                    methods::initialized,  //
@@ -28,6 +41,7 @@ using ServerMethods = mp::Typelist<methods::initialize,   //
                                    //
                                    methods::dollar::cancelRequest,  //
                                    methods::dollar::setTrace,       //
+                                   methods::dollar::memoryStats,    //
                                    //
                                    methods::textDocument::didOpen,                //
                                    methods::textDocument::didChange,              //
@@ -46,6 +60,8 @@ using ServerMethods = mp::Typelist<methods::initialize,   //
                                    methods::textDocument::documentSymbol,         //
                                    methods::textDocument::signatureHelp,          //
                                    methods::textDocument::semanticTokens::range,  //
+                                   methods::textDocument::rangeFormatting,        //
+                                   methods::textDocument::onTypeFormatting,       //
                                    //
                                    methods::workspace::didChangeWatchedFiles,  //
                                    //
@@ -56,9 +72,11 @@ using ServerMethods = mp::Typelist<methods::initialize,   //
 
 void Serve(lserver::Transport& transport, std::size_t concurrency, std::size_t jobs) {
   lib::jsonrpc::Server<LsContext> rpc_server;
+  std::unordered_map<std::string_view, MethodInfo> methods_info;
   std::optional<LsContext> ctx;
 
-  const auto handle_message = [&rpc_server, &ctx](lserver::Connection& conn, lserver::PooledMessageToken&& token) {
+  const auto handle_message = [&rpc_server, &methods_info, &ctx](lserver::Connection& conn,
+                                                                 lserver::PooledMessageToken&& token) {
     if (const auto result_field = glz::get_as_json<glz::raw_json_view, "/result">(token->buf); result_field)
         [[unlikely]] {
       const auto id = glz::get_as_json<lserver::Connection::rpc_id_t, "/id">(token->buf);
@@ -85,38 +103,79 @@ void Serve(lserver::Transport& transport, std::size_t concurrency, std::size_t j
     VLS_INFO("  |---> {}", *method);
     const auto begin_ts = std::chrono::steady_clock::now();
 
-    auto res_token = conn.AcquireToken();
-    ctx->task_arena.execute([&] {
-      rpc_server.Call(*ctx, res_token->buf, token->buf);
+    auto& method_info = methods_info.at(*method);
+
+    auto res_token = conn.AcquireToken(method_info.last_response_size.load(std::memory_order_relaxed));
+    res_token->body_offset = lserver::MessageToken::kHeaderReserve;
+
+    std::optional<std::string_view> response;
+    auto& arena = ctx->TemporaryArena();
+    ctx->ExecuteWithTemporaryArena(arena, [&] {
+      response = rpc_server.Call(*ctx, res_token->buf, token->buf, res_token->body_offset);
     });
 
-    if (!res_token->buf.empty()) {
+    if (response) {
+      method_info.last_response_size.store(response->size(), std::memory_order_relaxed);
       conn.Send(std::move(res_token));
     }
 
-    ctx->TemporaryArena().Reset();
+    arena.Reset();
 
     const auto end_ts = std::chrono::steady_clock::now();
     VLS_INFO("   <--- ({} ms)", std::chrono::duration_cast<std::chrono::milliseconds>(end_ts - begin_ts).count());
   };
 
-  lserver::Connection connection(handle_message, transport, concurrency, kServerBacklog);
-  ctx.emplace(connection);
-
   {
     ServerMethods::Apply([&]<typename P>() {
       rpc_server.Bind<P::invoke>(P::kMethodName);
+      methods_info[P::kMethodName].ordering = P::kOrdering;
     });
   }
 
+  const auto classify_message = [&methods_info](std::string_view message) {
+    const auto method = glz::get_as_json<std::string_view, "/method">(message);
+    if (!method) {
+      // responses to our requests are only logged, they do not touch the data
+      return lserver::MessageOrdering::kConcurrent;
+    }
+    if (const auto it = methods_info.find(*method); it != methods_info.end()) [[likely]] {
+      return it->second.ordering;
+    }
+    return lserver::MessageOrdering::kConcurrent;
+  };
+
+  lserver::Connection connection(handle_message, transport, concurrency, kServerBacklog, classify_message);
+  ctx.emplace(connection);
+
   ctx->task_arena.initialize(jobs);
 
+  // the flush modifies the data, so it is run exclusively just like the notifications
+  ctx->file_events.emplace(kFileEventsWindow, [&connection, &ctx] {
+    connection.Post([&ctx] {
+      ctx->task_arena.execute([&] {
+        IngestFileEvents(*ctx, ctx->file_events->Take());
+      });
+    });
+  });
+  ctx->dependent_diagnostics.emplace(kDependentDiagnosticsInterval, [&connection, &ctx] {
+    connection.Post([&ctx] {
+      auto& arena = ctx->TemporaryArena();
+      ctx->ExecuteWithTemporaryArena(arena, [&] {
+        PublishDependentDiagnostics(*ctx);
+      });
+      arena.Reset();
+    });
+  });
+
   ctx->linter.RegisterRule<lint::rules::NoEmpty>();
   ctx->linter.RegisterRule<lint::rules::NoUnusedVars>();
   ctx->linter.RegisterRule<lint::rules::NoUnusedImports>();
   ctx->linter.RegisterRule<lint::rules::NoUnnecessaryValueof>();
 
   connection.Listen();
+
+  ctx->file_events.reset();  // nothing is to be posted to the connection anymore
+  ctx->dependent_diagnostics.reset();
 }
 
 }  // namespace vanadium::ls
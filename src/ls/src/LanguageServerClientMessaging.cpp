@@ -4,28 +4,35 @@
 
 namespace vanadium::ls::clientMessaging {
 
-lsp::ShowMessageRequestResult ShowMessage(LsContext& ctx, lsp::ShowMessageRequestParams&& params) {
-  if (params.actions->empty()) {
-    // TODO: remove this special case, the problem is that we cannot receive the response before
-    // initialization request is completed, causing a deadlock
-    // (on the other hand, if there's no params.actions, we don't response at all, why wait?)
+void ShowMessage(LsContext& ctx, lsp::ShowMessageRequestParams&& params, ShowMessageChoiceFn on_choice) {
+  if (!params.actions || params.actions->empty()) {
+    // there is nothing to choose from, so the client is not going to reply with anything meaningful
     ctx.connection->Notify<"window/showMessage">(std::move(params));
-    return nullptr;
+    if (on_choice) {
+      on_choice(nullptr);
+    }
+    return;
   }
 
-  auto res = ctx.connection->Request<"window/showMessage", lsp::ShowMessageRequestResult>(std::move(params));
-  if (res.error()) [[unlikely]] {
-    // points for consideration:
-    // - those errors can be only json (de)serialization errors
-    // - generally, we don't need to distinguish between actual error and nully result here
-    // - on the other hand, returning nullptr may not work out for other server->client requests,
-    //   as their results not necessary actually nullable
-    // - exposing such low-level encoding error to high-level logic is evil
-    // - wrapping it as std::optional<lsp::ShowMessageRequestResult>,
-    //   i.e. std::optional<std::variant<ActualResult, std::nullptr_t>> is terrible
-    return nullptr;
-  }
-  return *res;
+  ctx.connection->Request<"window/showMessageRequest", lsp::ShowMessageRequestResult>(
+      std::move(params), [on_choice = std::move(on_choice)](auto&& res) {
+        if (!on_choice) {
+          return;
+        }
+        if (!res.has_value()) [[unlikely]] {
+          // points for consideration:
+          // - those errors can be only json (de)serialization errors
+          // - generally, we don't need to distinguish between actual error and nully result here
+          // - on the other hand, returning nullptr may not work out for other server->client requests,
+          //   as their results not necessary actually nullable
+          // - exposing such low-level encoding error to high-level logic is evil
+          // - wrapping it as std::optional<lsp::ShowMessageRequestResult>,
+          //   i.e. std::optional<std::variant<ActualResult, std::nullptr_t>> is terrible
+          on_choice(nullptr);
+          return;
+        }
+        on_choice(std::move(*res));
+      });
 }
 
 }  // namespace vanadium::ls::clientMessaging
@@ -0,0 +1,151 @@
+#include "vanadium/ls/LanguageServerDependentDiagnostics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <LSProtocol.h>
+
+#include <vanadium/core/Program.h>
+
+#include "vanadium/ls/LanguageServerContext.h"
+#include "vanadium/ls/LanguageServerLogger.h"
+#include "vanadium/ls/detail/Diagnostic.h"
+
+namespace vanadium::ls {
+
+namespace {
+constexpr std::size_t kBatchSize = 8;
+}
+
+DependentDiagnostics::DependentDiagnostics(std::chrono::milliseconds interval, ScheduleFn schedule_tick)
+    : interval_(interval), schedule_tick_(std::move(schedule_tick)), timer_([this](const std::stop_token& stop) {
+        Run(stop);
+      }) {}
+
+void DependentDiagnostics::Enqueue(std::span<const Entry> entries) {
+  if (entries.empty()) {
+    return;
+  }
+  {
+    std::lock_guard l(mutex_);
+    std::erase_if(queue_, [&](const Entry& queued) {
+      return std::ranges::find(entries, queued.path, &Entry::path) != entries.end();
+    });
+    queue_.insert(queue_.begin(), entries.begin(), entries.end());
+  }
+  cv_.notify_one();
+}
+
+bool DependentDiagnostics::Cancel(std::string_view path) {
+  std::lock_guard l(mutex_);
+  return std::erase_if(queue_, [&](const Entry& queued) {
+           return queued.path == path;
+         }) > 0;
+}
+
+std::vector<DependentDiagnostics::Entry> DependentDiagnostics::TakeBatch(std::size_t n) {
+  std::lock_guard l(mutex_);
+  const auto end = queue_.begin() + static_cast<std::ptrdiff_t>(std::min(n, queue_.size()));
+  std::vector<Entry> batch(std::make_move_iterator(queue_.begin()), std::make_move_iterator(end));
+  queue_.erase(queue_.begin(), end);
+  return batch;
+}
+
+void DependentDiagnostics::TickDone() {
+  {
+    std::lock_guard l(mutex_);
+    tick_pending_ = false;
+  }
+  cv_.notify_one();
+}
+
+void DependentDiagnostics::Run(const std::stop_token& stop) {
+  std::unique_lock l(mutex_);
+  while (!stop.stop_requested()) {
+    if (!cv_.wait(l, stop, [&] {
+          return !queue_.empty() && !tick_pending_;
+        })) {
+      break;
+    }
+    tick_pending_ = true;
+
+    l.unlock();
+    schedule_tick_();
+    l.lock();
+
+    // the messages received meanwhile are served between the ticks
+    cv_.wait_for(l, stop, interval_, [] {
+      return false;
+    });
+  }
+}
+
+std::vector<DependentDiagnostics::Entry> DeferOpenDependents(const core::SourceFile& file) {
+  if (!file.module) {
+    return {};
+  }
+  const auto& module = *file.module;
+
+  std::vector<std::pair<std::size_t, DependentDiagnostics::Entry>> dependents;
+  for (const auto* dependent : module.dependents) {
+    auto& sf = *dependent->sf;
+    if (&sf == &file || sf.skip_analysis) {
+      continue;
+    }
+    const auto it = dependent->dependencies.find(const_cast<core::ModuleDescriptor*>(&module));
+    const auto bindings = it == dependent->dependencies.end() ? 0 : it->second.size();
+    dependents.emplace_back(bindings, DependentDiagnostics::Entry{.program = sf.program, .path = sf.path});
+  }
+  std::ranges::stable_sort(dependents, std::ranges::greater{}, [](const auto& dependent) {
+    return dependent.first;
+  });
+
+  std::vector<DependentDiagnostics::Entry> entries;
+  entries.reserve(dependents.size());
+  for (auto& [_, entry] : dependents) {
+    entry.program->SetTypecheckDeferred(entry.path, true);
+    entries.emplace_back(std::move(entry));
+  }
+  return entries;
+}
+
+void PublishDependentDiagnostics(LsContext& ctx) {
+  const auto batch = ctx.dependent_diagnostics->TakeBatch(kBatchSize);
+  if (batch.empty() || !ctx.solution) {
+    ctx.dependent_diagnostics->TickDone();
+    return;
+  }
+  VLS_DEBUG("Publishing diagnostics of {} dependent files", batch.size());
+
+  for (const auto& [program, path] : batch) {
+    program->SetTypecheckDeferred(path, false);
+  }
+  ctx.solution->Analyze();
+
+  ctx.LockData([&](LsSessionRef d) {
+    for (const auto& [program, path] : batch) {
+      const auto* file = program->GetFile(path);
+      if (!file) {
+        continue;
+      }
+      const auto version = ctx.file_versions.find(path);
+      ctx.connection->Notify<"textDocument/publishDiagnostics">(lsp::PublishDiagnosticsParams{
+          .uri = ctx.PathToFileUri(path),
+          .version = version == ctx.file_versions.end() ? std::nullopt : std::optional{version->second},
+          .diagnostics = detail::CollectDiagnostics(*file, d),
+      });
+    }
+  });
+
+  ctx.dependent_diagnostics->TickDone();
+}
+
+}  // namespace vanadium::ls
@@ -0,0 +1,138 @@
+#include "vanadium/ls/LanguageServerFileEvents.h"
+
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <magic_enum/magic_enum.hpp>
+
+#include <LSProtocol.h>
+
+#include <vanadium/core/Program.h>
+
+#include "vanadium/ls/LanguageServerContext.h"
+#include "vanadium/ls/LanguageServerLogger.h"
+
+namespace vanadium::ls {
+
+FileEventsDebouncer::FileEventsDebouncer(std::chrono::milliseconds window, ScheduleFn schedule_flush)
+    : window_(window), schedule_flush_(std::move(schedule_flush)), timer_([this](const std::stop_token& stop) {
+        Run(stop);
+      }) {}
+
+void FileEventsDebouncer::Add(std::span<const lsp::FileEvent> events) {
+  {
+    std::lock_guard l(mutex_);
+    for (const auto& event : events) {
+      events_.insert_or_assign(std::string(event.uri), event.type);
+    }
+    deadline_ = std::chrono::steady_clock::now() + window_;
+  }
+  cv_.notify_one();
+}
+
+FileEventsDebouncer::Events FileEventsDebouncer::Take() {
+  std::lock_guard l(mutex_);
+  return std::exchange(events_, {});
+}
+
+void FileEventsDebouncer::Run(const std::stop_token& stop) {
+  std::unique_lock l(mutex_);
+  while (!stop.stop_requested()) {
+    if (!cv_.wait(l, stop, [&] {
+          return deadline_.has_value();
+        })) {
+      break;
+    }
+    // every event received meanwhile postpones the flush
+    const auto deadline = *deadline_;
+    if (cv_.wait_until(l, stop, deadline, [&] {
+          return *deadline_ != deadline;
+        })) {
+      continue;
+    }
+    if (stop.stop_requested()) {
+      break;
+    }
+    deadline_ = std::nullopt;
+
+    l.unlock();
+    schedule_flush_();
+    l.lock();
+  }
+}
+
+void IngestFileEvents(LsContext& ctx, const FileEventsDebouncer::Events& events) {
+  if (events.empty() || !ctx.solution) {
+    return;
+  }
+  VLS_INFO("Ingesting {} file events", events.size());
+
+  struct ProgramChanges {
+    std::vector<std::string> updated;
+    std::vector<std::string> dropped;
+  };
+  std::unordered_map<core::Program*, ProgramChanges> changes;
+
+  for (const auto& [uri, type] : events) {
+    VLS_DEBUG("{}: '{}'", magic_enum::enum_name(type), uri);
+
+    auto resolution = ctx.ResolveFileUri(uri);
+    if (!resolution) {
+      continue;
+    }
+    auto& [project, path] = *resolution;
+    auto& program = project.program;
+
+    switch (type) {
+      case lsp::FileChangeType::kCreated:
+      case lsp::FileChangeType::kChanged:
+        changes[&program].updated.emplace_back(std::move(path));
+        break;
+      case lsp::FileChangeType::kDeleted:
+        if (!program.GetFile(path)) {
+          VLS_WARN("Received lsp::FileEvent with type kDeleted for unknown file: '{}'", path);
+          break;
+        }
+        changes[&program].dropped.emplace_back(std::move(path));
+        break;
+      default:
+        VLS_ERROR("Bad lsp::FileEvent type: {}", std::to_underlying(type));
+        break;
+    }
+  }
+
+  const auto read_file = [&](const std::string& path, std::string& srcbuf) -> void {
+    const auto res = ctx.solution->Directory().ReadFile(path, [&](std::size_t size) {
+      srcbuf.resize(size);
+      return srcbuf.data();
+    });
+    if (!res) [[unlikely]] {
+      VLS_ERROR("Failed to read file '{}': '{}'", path, res.error().String());
+    }
+  };
+
+  // The programs are updated one after another, as the dropped modules invalidate their importers
+  // in the dependent programs as well
+  for (auto& [program, program_changes] : changes) {
+    program->Update([&](const core::Program::ProgramModifier& modify) {
+      for (const auto& path : program_changes.updated) {
+        modify.update(path, read_file);
+      }
+      for (const auto& path : program_changes.dropped) {
+        modify.drop(path);
+      }
+    });
+  }
+
+  if (!changes.empty()) {
+    ctx.solution->Analyze();
+  }
+}
+
+}  // namespace vanadium::ls
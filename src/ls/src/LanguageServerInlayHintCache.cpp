@@ -0,0 +1,23 @@
+#include "vanadium/ls/LanguageServerInlayHintCache.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace vanadium::ls {
+
+std::shared_ptr<InlayHintCache::Slot> InlayHintCache::Acquire(const std::string& path) {
+  std::lock_guard l(mutex_);
+  auto& slot = files_[path];
+  if (!slot) {
+    slot = std::make_shared<Slot>();
+  }
+  return slot;
+}
+
+void InlayHintCache::Drop(const std::string& path) {
+  std::lock_guard l(mutex_);
+  files_.erase(path);
+}
+
+}  // namespace vanadium::ls
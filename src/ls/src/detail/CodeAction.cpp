@@ -18,7 +18,7 @@ namespace vanadium::ls::detail {
 
 lsp::CodeActionResult ProvideCodeActions(const lsp::CodeActionParams& params, const core::SourceFile& file,
                                          LsSessionRef d) {
-  std::vector<lsp::CodeAction> actions;
+  lsp::vector<lsp::CodeAction> actions;
 
   for (const auto& diag : params.context.diagnostics) {
     if (!diag.data) {
@@ -39,7 +39,7 @@ lsp::CodeActionResult ProvideCodeActions(const lsp::CodeActionParams& params, co
           return true;
         }
 
-        const auto& replacement = *d.arena.Alloc<std::string>(std::format("\nimport from {} all;", module.name));
+        const auto replacement = d.arena.Format("\nimport from {} all;", module.name);
 
         const ast::pos_t last_import_pos = detail::FindPositionAfterLastImport(file.ast);
         if (last_import_pos == ast::pos_t(-1)) {
@@ -48,7 +48,7 @@ lsp::CodeActionResult ProvideCodeActions(const lsp::CodeActionParams& params, co
         const auto loc = file.ast.lines.Translate(last_import_pos);
 
         actions.emplace_back(lsp::CodeAction{
-            .title = *d.arena.Alloc<std::string>(std::format("import module '{}' for symbol '{}'", module.name, text)),
+            .title = d.arena.Format("import module '{}' for symbol '{}'", module.name, text),
             .kind = lsp::CodeActionKind::kQuickfix,
             .isPreferred = true,
             .edit =
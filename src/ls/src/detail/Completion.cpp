@@ -63,7 +63,7 @@ namespace {
 namespace {
 struct CompletionContext {
   const core::semantic::Scope* scope;
-  std::vector<lsp::CompletionItem>& items;
+  lsp::vector<lsp::CompletionItem>& items;
   lib::Arena& arena;
 };
 
@@ -212,7 +212,7 @@ lsp::CompletionList CollectCompletions(const lsp::CompletionParams& params, cons
       //     .textEdit =
       //         lsp::TextEdit{
       //             .range = conv::ToLSPRange(n->nrange, file.ast),
-      //             .newText = *d.arena.Alloc<std::string>(std::format("lengthof({})", file.Text(n))),
+      //             .newText = d.arena.Format("lengthof({})", file.Text(n)),
       //         },
       // });
     } else if (sym->Flags() & core::semantic::SymbolFlags::kImportedModule) {
@@ -248,7 +248,7 @@ lsp::CompletionList CollectCompletions(const lsp::CompletionParams& params, cons
             .label = name,
             .kind = lsp::CompletionItemKind::kProperty,
             .sortText = "0",
-            .insertText = *d.arena.Alloc<std::string>(std::format("{} := ", name)),
+            .insertText = d.arena.Format("{} := ", name),
         });
       }
     } else if (sym->Flags() & core::semantic::SymbolFlags::kList) {
@@ -293,7 +293,7 @@ lsp::CompletionList CollectCompletions(const lsp::CompletionParams& params, cons
               .label = name,
               .kind = lsp::CompletionItemKind::kProperty,
               .sortText = "1",
-              .insertText = *d.arena.Alloc<std::string>(std::format("{} := ", name)),
+              .insertText = d.arena.Format("{} := ", name),
           });
         }
       }
@@ -413,7 +413,7 @@ std::optional<lsp::CompletionItem> ResolveCompletionItem(const lsp::CompletionIt
                             .start = conv::ToLSPPosition(loc),
                             .end = conv::ToLSPPosition(loc),
                         },
-                    .newText = *d.arena.Alloc<std::string>(std::format("\nimport from {} all;\n", def.module)),
+                    .newText = d.arena.Format("\nimport from {} all;\n", def.module),
                 },
             }};
           },
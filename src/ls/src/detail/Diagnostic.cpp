@@ -1,6 +1,5 @@
 #include "vanadium/ls/detail/Diagnostic.h"
 
-#include <format>
 #include <vector>
 
 #include <magic_enum/magic_enum.hpp>
@@ -18,7 +17,8 @@
 namespace vanadium::ls::detail {
 
 namespace {
-void CollectModuleDiagnostics(const core::SourceFile& file, std::vector<lsp::Diagnostic>& diags, LsSessionRef& d) {
+void CollectModuleDiagnostics(const core::SourceFile& file, const lint::ProblemSet& problems,
+                              lsp::vector<lsp::Diagnostic>& diags, LsSessionRef& d) {
   assert(file.module.has_value());
 
   const auto& program = *file.program;
@@ -32,7 +32,7 @@ void CollectModuleDiagnostics(const core::SourceFile& file, std::vector<lsp::Dia
         .range = conv::ToLSPRange(import.declaration->parent->nrange, file.ast),
         .severity = lsp::DiagnosticSeverity::kError,
         .source = "vanadium",
-        .message = *d.arena.Alloc<std::string>(std::format("module '{}' not found", import_name)),
+        .message = d.arena.Format("module '{}' not found", import_name),
     });
   }
 
@@ -42,7 +42,7 @@ void CollectModuleDiagnostics(const core::SourceFile& file, std::vector<lsp::Dia
         .range = conv::ToLSPRange(ident->nrange, file.ast),
         .severity = lsp::DiagnosticSeverity::kError,
         .source = "vanadium",
-        .message = *d.arena.Alloc<std::string>(std::format("use of unknown symbol '{}'", ident->On(file.ast.src))),
+        .message = d.arena.Format("use of unknown symbol '{}'", ident->On(file.ast.src)),
         .data = {{
             {codeAction::kPayloadKeyUnresolved, 1},  // TODO: replace with bitmask when there will be more options
         }},
@@ -50,7 +50,6 @@ void CollectModuleDiagnostics(const core::SourceFile& file, std::vector<lsp::Dia
     // item.data. // TODO
   }
 
-  const auto& problems = *d.arena.Alloc<lint::ProblemSet>(d.linter.Lint(file));
   for (const auto& problem : problems) {
     diags.emplace_back(lsp::Diagnostic{
         .range = conv::ToLSPRange(problem.range, file.ast),
@@ -58,7 +57,7 @@ void CollectModuleDiagnostics(const core::SourceFile& file, std::vector<lsp::Dia
         .code = problem.reporter,
         .source = "vanadium-tidy",
         .message = problem.description,
-        .tags = std::vector<lsp::DiagnosticTag>{lsp::DiagnosticTag::kUnnecessary},  // TODO
+        .tags = lsp::vector<lsp::DiagnosticTag>{lsp::DiagnosticTag::kUnnecessary},  // TODO
     });
     if (problem.autofix) {
       diags.back().data = glz::generic{
@@ -76,9 +75,13 @@ void CollectModuleDiagnostics(const core::SourceFile& file, std::vector<lsp::Dia
 }
 }  // namespace
 
-std::vector<lsp::Diagnostic> CollectDiagnostics(const core::SourceFile& file, LsSessionRef d) {
-  std::vector<lsp::Diagnostic> diags;  // TODO: preallocate memory
-  diags.reserve(256);                  // this is not real
+lsp::vector<lsp::Diagnostic> CollectDiagnostics(const core::SourceFile& file, LsSessionRef d) {
+  const auto* problems = file.module ? d.arena.Alloc<lint::ProblemSet>(d.linter.Lint(file)) : nullptr;
+
+  // sized upfront, as the temporary arena would keep every buffer the vector outgrows
+  lsp::vector<lsp::Diagnostic> diags;
+  diags.reserve(file.ast.errors.size() + file.semantic_errors.size() + file.type_errors.size() +
+                (problems ? file.module->imports.size() + file.module->unresolved.size() + problems->size() : 0));
 
   for (const auto& err : file.ast.errors) {
     diags.emplace_back(lsp::Diagnostic{
@@ -106,12 +109,12 @@ std::vector<lsp::Diagnostic> CollectDiagnostics(const core::SourceFile& file, Ls
         .severity = lsp::DiagnosticSeverity::kError,
         .code = "typechecker",
         .source = "vanadium",
-        .message = err.message,  // TODO
+        .message = d.arena.Format("{}", err),
     });
   }
 
   if (file.module.has_value()) {
-    CollectModuleDiagnostics(file, diags, d);
+    CollectModuleDiagnostics(file, *problems, diags, d);
   }
 
   return diags;
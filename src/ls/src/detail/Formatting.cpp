@@ -0,0 +1,35 @@
+#include "vanadium/ls/detail/Formatting.h"
+
+#include <optional>
+
+#include <LSProtocol.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/format/Formatter.h>
+#include <vanadium/lib/Arena.h>
+
+#include "vanadium/ls/LanguageServerConv.h"
+
+namespace vanadium::ls::detail {
+
+lsp::vector<lsp::TextEdit> FormatLines(const core::SourceFile& file, const lsp::FormattingOptions& options,
+                                       std::optional<format::LineRange> lines, lib::Arena& arena) {
+  const auto replacements = format::Format(file.ast,
+                                           format::Options{
+                                               .indent_width = options.tabSize,
+                                               .use_tabs = !options.insertSpaces,
+                                           },
+                                           lines);
+
+  lsp::vector<lsp::TextEdit> edits;
+  edits.reserve(replacements.size());
+  for (const auto& [range, text] : replacements) {
+    edits.emplace_back(lsp::TextEdit{
+        .range = conv::ToLSPRange(range, file.ast),
+        .newText = arena.Format("{}", text),
+    });
+  }
+  return edits;
+}
+
+}  // namespace vanadium::ls::detail
@@ -1,9 +1,9 @@
 #include "vanadium/ls/detail/InlayHint.h"
 
 #include <algorithm>
-#include <stack>
+#include <cstdint>
+#include <optional>
 #include <string_view>
-#include <type_traits>
 #include <utility>
 #include <variant>
 
@@ -22,15 +22,17 @@
 #include <vanadium/tooling/Solution.h>
 
 #include "vanadium/ls/LanguageServerConv.h"
+#include "vanadium/ls/LanguageServerInlayHintCache.h"
 #include "vanadium/ls/LanguageServerLogger.h"
 #include "vanadium/ls/LanguageServerSolution.h"
 #include "vanadium/ls/detail/Definition.h"
 
-// TODO: maybe track file version
 struct InlayHintPayload {
   std::string path;
   vanadium::ast::pos_t anchor_pos;
   vanadium::ast::NodeKind node_kind;
+  std::uint64_t revision;
+  vanadium::ls::InlayHintCache::EntryId entry_id;
 
   static glz::generic AsJson(InlayHintPayload&& payload) {
     // TODO: find a way to have strongly-typed 'data' on both ends (maybe modify lspgen to produce templates,
@@ -40,6 +42,8 @@ struct InlayHintPayload {
         {"path", std::move(payload.path)},
         {"apos", payload.anchor_pos},
         {"nk", std::to_underlying(payload.node_kind)},
+        {"rev", payload.revision},
+        {"eid", payload.entry_id},
     };
   }
 };
@@ -48,6 +52,8 @@ struct glz::meta<InlayHintPayload> {
   static constexpr std::string_view rename_key(std::string_view key) {
     if (key == "anchor_pos") return "apos";
     if (key == "node_kind") return "nk";
+    if (key == "revision") return "rev";
+    if (key == "entry_id") return "eid";
     return key;
   }
 };
@@ -55,23 +61,10 @@ struct glz::meta<InlayHintPayload> {
 namespace vanadium::ls::detail {
 
 namespace {
-template <typename DeduceCompositeLiteralTypeFn = decltype(&core::checker::ext::DeduceCompositeLiteralType)>
-  requires std::is_invocable_r_v<core::checker::InstantiatedType, DeduceCompositeLiteralTypeFn, const core::SourceFile*,
-                                 const core::semantic::Scope*, const ast::nodes::CompositeLiteral*>
-struct InlayHintTargetLocatorOptions {
-  DeduceCompositeLiteralTypeFn deduceCompositeLiteralType;
-};
-constexpr auto kNonCachingInlayHintTargetLocatorOptions = InlayHintTargetLocatorOptions{
-    .deduceCompositeLiteralType =
-        [](const core::SourceFile* _file, const core::semantic::Scope* _scope,
-           const ast::nodes::CompositeLiteral* _cl) {
-          return core::checker::ext::DeduceCompositeLiteralType(_file, _scope, _cl);
-        },
-};
-
-template <typename Options>
-[[nodiscard]] const ast::Node* LocateInlayHintTarget(const core::SourceFile& file, const core::semantic::Scope* scope,
-                                                     const ast::Node* n, Options options) {
+// The type of the enclosing literal is what the type of a nested one is deduced from
+[[nodiscard]] InlayHintCache::Entry LocateInlayHintTarget(
+    const core::SourceFile& file, const core::semantic::Scope* scope, const ast::Node* n,
+    const core::checker::InstantiatedType& parent_cl_type = core::checker::InstantiatedType::None()) {
   switch (n->nkind) {
     case ast::NodeKind::CallExpr: {
       const auto* m = n->As<ast::nodes::CallExpr>();
@@ -82,33 +75,62 @@ template <typename Options>
       const auto fun_sym = core::checker::ResolveExprType(&file, scope, m->fun);
       if (!fun_sym || (fun_sym->Flags() & core::semantic::SymbolFlags::kBuiltin) ||
           !(fun_sym->Flags() & (core::semantic::SymbolFlags::kFunction | core::semantic::SymbolFlags::kTemplate))) {
-        return nullptr;
+        return {.node = n, .target = nullptr};
       }
 
-      return ast::utils::GetCallableDeclParams(fun_sym->Declaration()->As<ast::nodes::Decl>());  // -> FormalPars
+      return {
+          .node = n,
+          .target = ast::utils::GetCallableDeclParams(fun_sym->Declaration()->As<ast::nodes::Decl>()),  // FormalPars
+      };
     }
     case ast::NodeKind::CompositeLiteral: {
       const auto* m = n->As<ast::nodes::CompositeLiteral>();
-      const auto sym = options.deduceCompositeLiteralType(&file, scope, m);
+      const auto sym = core::checker::ext::DeduceCompositeLiteralType(&file, scope, m, parent_cl_type);
       if (!sym || (sym->Flags() & core::semantic::SymbolFlags::kBuiltin)) {
-        return nullptr;
+        return {.node = n, .target = nullptr, .cl_type = sym};
       }
 
       if ((sym.depth != 0) || !(sym->Flags() & core::semantic::SymbolFlags::kStructural)) {
-        return nullptr;
+        return {.node = n, .target = nullptr, .cl_type = sym};
       }
-      return sym->Declaration();
+      return {.node = n, .target = sym->Declaration(), .cl_type = sym};
     }
     default:
-      return nullptr;
+      return {.node = n, .target = nullptr};
+  }
+}
+
+[[nodiscard]] const ast::Node* EnclosingCompositeLiteral(const ast::Node* n) {
+  const auto* p = n->parent;
+  if (p && p->nkind == ast::NodeKind::AssignmentExpr) {
+    p = p->parent;
+  }
+  return (p && p->nkind == ast::NodeKind::CompositeLiteral) ? p : nullptr;
+}
+
+// The enclosing nodes are visited first, so a nested literal finds the type of its parent in the cache already
+InlayHintCache::EntryId LocateCachedInlayHintTarget(const core::SourceFile& file, const core::semantic::Scope* scope,
+                                                    const ast::Node* n, InlayHintCache::FileEntries& entries) {
+  if (const auto id = entries.Find(n)) {
+    return *id;
+  }
+
+  auto parent_cl_type = core::checker::InstantiatedType::None();
+  if (n->nkind == ast::NodeKind::CompositeLiteral) {
+    if (const auto* parent_cl = EnclosingCompositeLiteral(n)) {
+      if (const auto parent_id = entries.Find(parent_cl)) {
+        parent_cl_type = entries.Get(*parent_id)->cl_type;
+      }
+    }
   }
+
+  return entries.Add(LocateInlayHintTarget(file, scope, n, parent_cl_type));
 }
 
-template <typename InlayHintTargetLocatorOptions>
-void ComputeInlayHint(const core::SourceFile& file, const core::semantic::Scope* scope, const ast::Node* n,
-                      lib::Arena& arena, std::vector<lsp::InlayHint>& out,
-                      InlayHintTargetLocatorOptions inlayHintTargetLocatorOptions) {
-  const ast::Node* tgt = LocateInlayHintTarget(file, scope, n, inlayHintTargetLocatorOptions);
+void ComputeInlayHint(const core::SourceFile& file, const InlayHintCache::FileEntries& entries,
+                      InlayHintCache::EntryId entry_id, lib::Arena& arena, lsp::vector<lsp::InlayHint>& out) {
+  const auto* n = entries.Get(entry_id)->node;
+  const auto* tgt = entries.Get(entry_id)->target;
   if (!tgt) {
     return;
   }
@@ -116,12 +138,14 @@ void ComputeInlayHint(const core::SourceFile& file, const core::semantic::Scope*
   const auto add_parameter_inlay_hint = [&](const ast::pos_t pos, std::string_view name) {
     out.emplace_back(lsp::InlayHint{
         .position = conv::ToLSPPosition(file.ast.lines.Translate(pos)),
-        .label = *arena.Alloc<std::string>(std::format("{} := ", name)),
+        .label = arena.Format("{} := ", name),
         .kind = lsp::InlayHintKind::kParameter,
         .data = InlayHintPayload::AsJson({
             .path = file.path,
             .anchor_pos = n->nrange.begin,
             .node_kind = n->nkind,
+            .revision = entries.Revision(),
+            .entry_id = entry_id,
         }),
     });
   };
@@ -205,67 +229,49 @@ void ComputeInlayHint(const core::SourceFile& file, const core::semantic::Scope*
 }
 }  // namespace
 
-std::vector<lsp::InlayHint> CollectInlayHints(const lsp::InlayHintParams& params, const core::SourceFile& file,
-                                              LsSessionRef d) {
+lsp::vector<lsp::InlayHint> CollectInlayHints(const lsp::InlayHintParams& params, const core::SourceFile& file,
+                                              LsSessionRef d, InlayHintCache& cache) {
   if (!file.module) {
     return {};
   }
 
   const auto requested_range = conv::FromLSPRange(params.range, file.ast);
-  std::vector<lsp::InlayHint> hints;
-
-  const core::semantic::Scope* scope{nullptr};
-
-  std::stack<core::checker::InstantiatedType> cl_type_cache;
-  cl_type_cache.emplace(nullptr);
-  //
-  const auto memoizing_visitor = [&](this auto&& self, const ast::Node* n) {
-    ComputeInlayHint(file, scope, n, d.arena, hints,
-                     InlayHintTargetLocatorOptions{
-                         .deduceCompositeLiteralType =
-                             [&](const core::SourceFile* _file, const core::semantic::Scope* _scope,
-                                 const ast::nodes::CompositeLiteral* _cl) {
-                               const auto res = core::checker::ext::DeduceCompositeLiteralType(_file, _scope, _cl,
-                                                                                               cl_type_cache.top());
-                               cl_type_cache.emplace(res);
-                               return res;
-                             },
-                     });
-    n->Accept(self);
-    if (n->nkind == ast::NodeKind::CompositeLiteral) {
-      cl_type_cache.pop();
-    }
-    return false;
-  };
-
   const auto overlaps = [](const ast::Range& a, const ast::Range& b) {
     return std::max(a.begin, b.begin) <= std::min(a.end, b.end);
   };
-  core::semantic::InspectScope(
-      file.module->scope,
-      [&](const core::semantic::Scope* scope_under_inspection) {
-        scope = scope_under_inspection;
-      },
-      [&](const ast::Node* n) -> bool {
-        if (overlaps(requested_range, n->nrange)) {
-          if (n->nkind == ast::NodeKind::CompositeLiteral) {
-            memoizing_visitor(n);
-            return false;
+
+  return cache.With(file.path, core::Program::AnalysisRevision(), [&](InlayHintCache::FileEntries& entries) {
+    lsp::vector<lsp::InlayHint> hints;
+
+    const core::semantic::Scope* scope{nullptr};
+    core::semantic::InspectScope(
+        file.module->scope,
+        [&](const core::semantic::Scope* scope_under_inspection) {
+          scope = scope_under_inspection;
+        },
+        [&](const ast::Node* n) -> bool {
+          if (overlaps(requested_range, n->nrange)) {
+            if (n->nkind == ast::NodeKind::CallExpr || n->nkind == ast::NodeKind::CompositeLiteral) {
+              ComputeInlayHint(file, entries, LocateCachedInlayHintTarget(file, scope, n, entries), d.arena, hints);
+            }
+            return true;
           }
-          ComputeInlayHint(file, scope, n, d.arena, hints, kNonCachingInlayHintTargetLocatorOptions);
-          return true;
-        }
-        return n->nrange.Contains(requested_range);
-      });
+          return n->nrange.Contains(requested_range);
+        });
 
-  return hints;
+    return hints;
+  });
 }
 
-std::optional<lsp::InlayHint> ResolveInlayHint(const lsp::InlayHint& original_hint, LsSessionRef d) {
+std::optional<lsp::InlayHint> ResolveInlayHint(const lsp::InlayHint& original_hint, LsSessionRef d,
+                                               InlayHintCache& cache) {
   if (!original_hint.data) {
     return std::nullopt;
   }
   const auto payload = glz::read_json<InlayHintPayload>(*original_hint.data);
+  if (!payload) [[unlikely]] {
+    return std::nullopt;
+  }
 
   const auto* project = d.solution.ProjectOf(d.solution.Directory().Join(payload->path));
   if (!project) [[unlikely]] {
@@ -281,16 +287,31 @@ std::optional<lsp::InlayHint> ResolveInlayHint(const lsp::InlayHint& original_hi
     return std::nullopt;
   }
 
-  const ast::Node* container_node = ast::utils::GetNodeAt(file->ast, payload->anchor_pos);
-  while (container_node->nkind != static_cast<ast::NodeKind>(payload->node_kind)) {
-    container_node = container_node->parent;
-    if (!container_node) [[unlikely]] {
-      return std::nullopt;
+  // the hints of the current revision point right at their entries, the older ones are looked up again
+  const auto revision = core::Program::AnalysisRevision();
+  auto entry = payload->revision != revision
+                   ? std::nullopt
+                   : cache.With(file->path, revision,
+                                [&](const InlayHintCache::FileEntries& entries) -> std::optional<InlayHintCache::Entry> {
+                                  if (const auto* cached = entries.Get(payload->entry_id)) {
+                                    return *cached;
+                                  }
+                                  return std::nullopt;
+                                });
+  if (!entry) {
+    const ast::Node* container_node = ast::utils::GetNodeAt(file->ast, payload->anchor_pos);
+    while (container_node->nkind != static_cast<ast::NodeKind>(payload->node_kind)) {
+      container_node = container_node->parent;
+      if (!container_node) [[unlikely]] {
+        return std::nullopt;
+      }
     }
+    entry = LocateInlayHintTarget(*file, core::semantic::utils::FindScope(file->module->scope, container_node),
+                                  container_node);
   }
 
-  const auto* tgt = LocateInlayHintTarget(*file, core::semantic::utils::FindScope(file->module->scope, container_node),
-                                          container_node, kNonCachingInlayHintTargetLocatorOptions);
+  const auto* container_node = entry->node;
+  const auto* tgt = entry->target;
   if (!tgt) {
     return std::nullopt;
   }
@@ -309,7 +330,7 @@ std::optional<lsp::InlayHint> ResolveInlayHint(const lsp::InlayHint& original_hi
       }}};
     }
 
-    rendition.label = std::vector<lsp::InlayHintLabelPart>{{{
+    rendition.label = lsp::vector<lsp::InlayHintLabelPart>{{{
         .value = std::get<std::string_view>(rendition.label),
         .location =
             lsp::Location{
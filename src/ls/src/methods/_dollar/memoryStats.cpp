@@ -0,0 +1,45 @@
+#include <LSProtocol.h>
+#include <LSProtocolEx.h>
+
+#include <vanadium/core/MemoryStats.h>
+#include <vanadium/tooling/Solution.h>
+
+#include "vanadium/ls/LanguageServerContext.h"
+#include "vanadium/ls/LanguageServerMethods.h"
+#include "vanadium/ls/LanguageServerSession.h"
+
+namespace vanadium::ls {
+rpc::ExpectedResult<lsp::MemoryStatsResult> methods::dollar::memoryStats::invoke(LsContext& ctx,
+                                                                                 const lib::jsonrpc::Empty&) {
+  return ctx.LockData([](LsSessionRef&& d) -> lsp::MemoryStatsResult {
+    lsp::MemoryStatsResult result{.total = 0};
+    for (const auto& project : d.solution.Projects()) {
+      const auto stats = project.program.CollectMemoryStats();
+
+      auto& project_result = result.projects.emplace_back(lsp::ProjectMemoryStats{
+          .name = project.Name(),
+          .index = stats.index,
+          .asnModulesArena = stats.asn_modules_arena,
+          .asnModulesHeap = stats.asn_modules_heap,
+          .total = stats.Total(),
+      });
+      project_result.files.reserve(stats.files.size());
+      for (const auto& fs : stats.files) {
+        project_result.files.emplace_back(lsp::FileMemoryStats{
+            .path = fs.path,
+            .arenaAllocated = fs.arena_allocated,
+            .arenaUsed = fs.arena_used,
+            .source = fs.source,
+            .symbolTables = fs.symbol_tables,
+            .module = fs.module,
+            .diagnostics = fs.diagnostics,
+            .total = fs.Total(),
+        });
+      }
+
+      result.total += stats.Total();
+    }
+    return result;
+  });
+}
+}  // namespace vanadium::ls
@@ -38,8 +38,8 @@ rpc::ExpectedResult<lsp::InitializeResult> methods::initialize::invoke(LsContext
           return;
         }
         for (auto& proj : solution.Projects()) {
-          for (const auto& file : proj.program.Files() | std::views::values) {
-            const_cast<core::SourceFile&>(file).skip_analysis = true;
+          for (const auto& path : proj.program.Files() | std::views::keys) {
+            proj.program.SetAnalysisSkipped(path, true);
           }
         }
       };
@@ -53,7 +53,7 @@ rpc::ExpectedResult<lsp::InitializeResult> methods::initialize::invoke(LsContext
         clientMessaging::ShowMessage(
             ctx, lsp::ShowMessageRequestParams{
                      .type = lsp::MessageType::kError,
-                     .message = ctx.Temp<std::string>(std::format("Solution initialization failed:\n{}", err_message)),
+                     .message = ctx.TemporaryArena().Format("Solution initialization failed:\n{}", err_message),
                  });
       }
     } else {
@@ -93,6 +93,12 @@ rpc::ExpectedResult<lsp::InitializeResult> methods::initialize::invoke(LsContext
               .documentHighlightProvider = true,
               .documentSymbolProvider = true,
               .codeActionProvider = true,
+              .documentRangeFormattingProvider = true,
+              .documentOnTypeFormattingProvider =
+                  lsp::DocumentOnTypeFormattingOptions{
+                      .firstTriggerCharacter = "}",
+                      .moreTriggerCharacter = {{";"}},
+                  },
               .renameProvider = true,
               .semanticTokensProvider =
                   lsp::SemanticTokensOptions{
@@ -25,7 +25,7 @@ template <typename T>
 
 namespace vanadium::ls {
 void methods::initialized::invoke(LsContext& ctx, const lib::jsonrpc::Empty&) {
-  ctx.connection->Request<"client/registerCapability", lserver::NoAwaitResponse /*<std::nullptr_t>*/>(
+  ctx.connection->Request<"client/registerCapability", std::nullptr_t>(
       lsp::RegistrationParams{
           .registrations =
               {
@@ -33,14 +33,14 @@ void methods::initialized::invoke(LsContext& ctx, const lib::jsonrpc::Empty&) {
                       .id = kRegistrationId,
                       .method = "workspace/didChangeWatchedFiles",
                       .registerOptions = generify(lsp::DidChangeWatchedFilesRegistrationOptions{
-                          .watchers = [&] -> std::vector<lsp::FileSystemWatcher> {
-                            std::vector<lsp::FileSystemWatcher> watchers = {
+                          .watchers = [&] -> lsp::vector<lsp::FileSystemWatcher> {
+                            lsp::vector<lsp::FileSystemWatcher> watchers = {
                                 lsp::FileSystemWatcher{.globPattern = "**/*.ttcn"},
                             };
                             for (const auto& sproj : ctx.solution->Projects()) {
                               for (const auto& search_path : sproj.project.SearchPaths()) {
                                 watchers.emplace_back(
-                                    ctx.Temp<std::string>(std::format("{}/**/*.ttcn", search_path.base_path)));
+                                    ctx.TemporaryArena().Format("{}/**/*.ttcn", search_path.base_path));
                               }
                             }
                             return watchers;
@@ -8,7 +8,7 @@
 namespace vanadium::ls {
 rpc::ExpectedResult<lsp::InlayHint> methods::inlayHint::resolve::invoke(LsContext& ctx, const lsp::InlayHint& hint) {
   return ctx.LockData([&](LsSessionRef d) {
-    return detail::ResolveInlayHint(hint, std::move(d)).value_or(hint);
+    return detail::ResolveInlayHint(hint, std::move(d), ctx.inlay_hints).value_or(hint);
   });
 }
 }  // namespace vanadium::ls
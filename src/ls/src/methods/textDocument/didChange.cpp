@@ -7,6 +7,7 @@
 
 #include "vanadium/ls/LanguageServerContext.h"
 #include "vanadium/ls/LanguageServerConv.h"
+#include "vanadium/ls/LanguageServerDependentDiagnostics.h"
 #include "vanadium/ls/LanguageServerMethods.h"
 #include "vanadium/ls/LanguageServerSession.h"
 #include "vanadium/ls/detail/Diagnostic.h"
@@ -33,8 +34,14 @@ void methods::textDocument::didChange::invoke(LsContext& ctx, const lsp::DidChan
         srcbuf.replace(range.begin, range.Length(), change.text);
       }
     };
+    // an edit of a queued document is to be analyzed along with it
+    if (ctx.dependent_diagnostics->Cancel(file.path)) {
+      file.program->SetTypecheckDeferred(file.path, false);
+    }
+    const auto dependents = DeferOpenDependents(file);
+
     file.program->Commit([&](auto& modify) {
-      modify.update(file.path, read_file);
+      modify.update_buffer(file.path, read_file);
     });
 
     ctx.connection->Notify<"textDocument/publishDiagnostics">(lsp::PublishDiagnosticsParams{
@@ -42,6 +49,8 @@ void methods::textDocument::didChange::invoke(LsContext& ctx, const lsp::DidChan
         .version = params.textDocument.version,
         .diagnostics = detail::CollectDiagnostics(file, d),
     });
+
+    ctx.dependent_diagnostics->Enqueue(dependents);
   });
 }
 }  // namespace vanadium::ls
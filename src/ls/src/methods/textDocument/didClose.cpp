@@ -9,7 +9,11 @@
 namespace vanadium::ls {
 void methods::textDocument::didClose::invoke(LsContext& ctx, const lsp::DidCloseTextDocumentParams& params) {
   ctx.WithFile(params, [&](const lsp::DidCloseTextDocumentParams&, const core::SourceFile& file, LsSessionRef) {
-    const_cast<core::SourceFile&>(file).skip_analysis = true;
+    if (ctx.dependent_diagnostics->Cancel(file.path)) {
+      file.program->SetTypecheckDeferred(file.path, false);
+    }
+    file.program->SetAnalysisSkipped(file.path, true);
+    ctx.inlay_hints.Drop(file.path);
   });
 }
 }  // namespace vanadium::ls
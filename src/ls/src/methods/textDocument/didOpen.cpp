@@ -35,11 +35,14 @@ void methods::textDocument::didOpen::invoke(LsContext& ctx, const lsp::DidOpenTe
         srcbuf = std::move(params.textDocument.text);
       };
       project.program.Update([&](auto& modify) {
-        modify.update(path, read_file);
+        modify.update_buffer(path, read_file);
       });
     }
 
-    const_cast<core::SourceFile*>(project.program.GetFile(path))->skip_analysis = false;
+    if (ctx.dependent_diagnostics->Cancel(path)) {
+      project.program.SetTypecheckDeferred(path, false);
+    }
+    project.program.SetAnalysisSkipped(path, false);
     project.program.Commit([](auto&) {});
 
     ctx.connection->Notify<"textDocument/publishDiagnostics">(lsp::PublishDiagnosticsParams{
@@ -15,7 +15,7 @@ namespace vanadium::ls {
 namespace {
 lsp::DocumentHighlightResults ProvideHighlight(const lsp::DocumentHighlightParams& params, const core::SourceFile& file,
                                                LsSessionRef) {
-  std::vector<lsp::DocumentHighlight> hls;
+  lsp::vector<lsp::DocumentHighlight> hls;
 
   detail::VisitLocalReferences(&file, params.position, true, [&](const ast::nodes::Ident* ident) {
     const bool is_write = ident->parent->nkind == ast::NodeKind::AssignmentExpr &&
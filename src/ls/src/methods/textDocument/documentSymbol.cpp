@@ -63,9 +63,9 @@ lsp::DocumentSybmolResult GatherResult(const lsp::DocumentSymbolParams&, const c
     return file.Text(n);
   };
 
-  std::vector<lsp::DocumentSymbol> result;
+  lsp::vector<lsp::DocumentSymbol> result;
 
-  std::stack<std::vector<lsp::DocumentSymbol>*> hierarchy;
+  std::stack<lsp::vector<lsp::DocumentSymbol>*> hierarchy;
   hierarchy.emplace(&result);
 
   const auto push = [&](lsp::DocumentSymbol&& symbol) -> lsp::DocumentSymbol& {
@@ -1,15 +1,26 @@
 #include "vanadium/ls/detail/InlayHint.h"
 
+#include <utility>
+
 #include <LSProtocol.h>
 #include <LSProtocolEx.h>
 
+#include <vanadium/core/Program.h>
+
 #include "vanadium/ls/LanguageServerContext.h"
 #include "vanadium/ls/LanguageServerMethods.h"
+#include "vanadium/ls/LanguageServerSession.h"
 
 namespace vanadium::ls {
 
 rpc::ExpectedResult<lsp::InlayHintResult> methods::textDocument::inlayHint::invoke(LsContext& ctx,
                                                                                    const lsp::InlayHintParams& params) {
-  return ctx.WithFile<lsp::InlayHintResult>(params, detail::CollectInlayHints).value_or(nullptr);
+  return ctx
+      .WithFile<lsp::InlayHintResult>(params,
+                                      [&](const lsp::InlayHintParams& params, const core::SourceFile& file,
+                                          LsSessionRef d) -> lsp::InlayHintResult {
+                                        return detail::CollectInlayHints(params, file, std::move(d), ctx.inlay_hints);
+                                      })
+      .value_or(nullptr);
 }
 }  // namespace vanadium::ls
@@ -0,0 +1,36 @@
+#include <LSProtocol.h>
+#include <LSProtocolEx.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/format/Formatter.h>
+
+#include "vanadium/ls/LanguageServerContext.h"
+#include "vanadium/ls/LanguageServerConv.h"
+#include "vanadium/ls/LanguageServerMethods.h"
+#include "vanadium/ls/LanguageServerSession.h"
+#include "vanadium/ls/detail/Formatting.h"
+
+namespace vanadium::ls {
+
+rpc::ExpectedResult<lsp::FormattingResult> methods::textDocument::onTypeFormatting::invoke(
+    LsContext& ctx, const lsp::DocumentOnTypeFormattingParams& params) {
+  return ctx
+      .WithFile<lsp::FormattingResult>(
+          params,
+          [&](const lsp::DocumentOnTypeFormattingParams& params, const core::SourceFile& file,
+              LsSessionRef) -> lsp::FormattingResult {
+            if (file.path.ends_with(".asn") || params.ch.empty()) {
+              return nullptr;
+            }
+            // only the block or the line completed by the character, the rest may be in the middle of editing
+            const auto pos = file.ast.lines.GetPosition(conv::FromLSPPosition(params.position));
+            const auto lines = format::OnTypeLines(file.ast, pos, params.ch.front());
+            if (!lines) {
+              return nullptr;
+            }
+            return detail::FormatLines(file, params.options, *lines, ctx.TemporaryArena());
+          })
+      .value_or(nullptr);
+}
+
+}  // namespace vanadium::ls
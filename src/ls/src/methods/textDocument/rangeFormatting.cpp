@@ -0,0 +1,37 @@
+#include <LSProtocol.h>
+#include <LSProtocolEx.h>
+
+#include <vanadium/core/Program.h>
+#include <vanadium/format/Formatter.h>
+
+#include "vanadium/ls/LanguageServerContext.h"
+#include "vanadium/ls/LanguageServerMethods.h"
+#include "vanadium/ls/LanguageServerSession.h"
+#include "vanadium/ls/detail/Formatting.h"
+
+namespace vanadium::ls {
+
+rpc::ExpectedResult<lsp::FormattingResult> methods::textDocument::rangeFormatting::invoke(
+    LsContext& ctx, const lsp::DocumentRangeFormattingParams& params) {
+  return ctx
+      .WithFile<lsp::FormattingResult>(
+          params,
+          [&](const lsp::DocumentRangeFormattingParams& params, const core::SourceFile& file,
+              LsSessionRef) -> lsp::FormattingResult {
+            if (file.path.ends_with(".asn")) {
+              return nullptr;
+            }
+            const auto& [start, end] = params.range;
+            // the selection of whole lines ends at the beginning of the next one
+            const bool ends_at_line_start = end.character == 0 && end.line > start.line;
+            return detail::FormatLines(file, params.options,
+                                       format::LineRange{
+                                           .first = start.line,
+                                           .last = ends_at_line_start ? end.line - 1 : end.line,
+                                       },
+                                       ctx.TemporaryArena());
+          })
+      .value_or(nullptr);
+}
+
+}  // namespace vanadium::ls
@@ -21,7 +21,7 @@ rpc::ExpectedResult<lsp::ReferencesResult> methods::textDocument::references::in
     LsContext& ctx, const lsp::ReferenceParams& params) {
   auto res = ctx.WithFile<lsp::ReferencesResult>(
       params, [&](const auto&, const core::SourceFile& file, LsSessionRef) -> lsp::ReferencesResult {
-        std::vector<lsp::Location> refs;
+        lsp::vector<lsp::Location> refs;
         detail::VisitLocalReferences(&file, params.position, params.context.includeDeclaration,
                                      [&](const ast::nodes::Ident* ident) {
                                        refs.emplace_back(lsp::Location{
@@ -137,8 +137,6 @@ lsp::SemanticTokens CollectSemanticTokens(const lsp::SemanticTokensRangeParams&
   const auto write_token = [&](SemanticTokenW&& tok) {
     const auto pos = conv::ToLSPPosition(file.ast.lines.Translate(tok.ident->nrange.begin));
 
-    result.data.reserve(result.data.size() + 5);
-
     const auto relline = pos.line - lastpos.line;
     if (relline != 0) {
       lastpos.character = 0;
@@ -41,7 +41,7 @@ class SignatureInformationBuilder {
     });
   }
 
-  [[nodiscard]] std::vector<lsp::ParameterInformation> Build() {
+  [[nodiscard]] lsp::vector<lsp::ParameterInformation> Build() {
     if (!params_.empty()) {
       buf_.erase(buf_.size() - 2);
     }
@@ -52,7 +52,7 @@ class SignatureInformationBuilder {
   static constexpr std::string_view kSeparator = ", ";
 
   std::string& buf_;
-  std::vector<lsp::ParameterInformation> params_;
+  lsp::vector<lsp::ParameterInformation> params_;
 };
 
 template <typename ContainerNode>
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <vanadium/core/Program.h>
+
+#include "vanadium/ls/LanguageServerDependentDiagnostics.h"
+
+using namespace vanadium;
+using namespace vanadium::ls;
+using namespace std::chrono_literals;
+
+namespace {
+class TickCounter {
+ public:
+  void operator()() {
+    {
+      std::lock_guard l(mutex_);
+      ++ticks_;
+    }
+    cv_.notify_all();
+  }
+
+  bool WaitFor(std::size_t ticks) {
+    std::unique_lock l(mutex_);
+    return cv_.wait_for(l, 5s, [&] {
+      return ticks_ >= ticks;
+    });
+  }
+
+  std::size_t Ticks() {
+    std::lock_guard l(mutex_);
+    return ticks_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t ticks_{0};
+};
+
+std::vector<std::string> Paths(const std::vector<DependentDiagnostics::Entry>& entries) {
+  std::vector<std::string> paths;
+  for (const auto& entry : entries) {
+    paths.push_back(entry.path);
+  }
+  return paths;
+}
+}  // namespace
+
+TEST(DependentDiagnostics, QueuesLatestEditFirst) {
+  TickCounter ticks;
+  DependentDiagnostics queue(1h, [&] {
+    ticks();
+  });
+
+  const std::vector<DependentDiagnostics::Entry> first{{.program = nullptr, .path = "A"},
+                                                       {.program = nullptr, .path = "B"}};
+  const std::vector<DependentDiagnostics::Entry> second{{.program = nullptr, .path = "C"},
+                                                        {.program = nullptr, .path = "A"}};
+  queue.Enqueue(first);
+  queue.Enqueue(second);
+
+  EXPECT_TRUE(queue.Cancel("B"));
+  EXPECT_FALSE(queue.Cancel("B"));
+
+  EXPECT_EQ(Paths(queue.TakeBatch(1)), std::vector<std::string>{"C"});
+  EXPECT_EQ(Paths(queue.TakeBatch(8)), std::vector<std::string>{"A"});
+  EXPECT_TRUE(queue.TakeBatch(8).empty());
+}
+
+TEST(DependentDiagnostics, SchedulesNextTickOnceDone) {
+  TickCounter ticks;
+  DependentDiagnostics queue(1ms, [&] {
+    ticks();
+  });
+
+  const std::vector<DependentDiagnostics::Entry> entries{{.program = nullptr, .path = "A"},
+                                                         {.program = nullptr, .path = "B"}};
+  queue.Enqueue(entries);
+  ASSERT_TRUE(ticks.WaitFor(1));
+
+  // the tick is still being served
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(ticks.Ticks(), 1);
+
+  EXPECT_EQ(queue.TakeBatch(1).size(), 1);
+  queue.TickDone();
+  ASSERT_TRUE(ticks.WaitFor(2));
+
+  EXPECT_EQ(queue.TakeBatch(1).size(), 1);
+  queue.TickDone();
+
+  // nothing is left
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(ticks.Ticks(), 2);
+}
+
+TEST(DependentDiagnostics, DefersTypecheckOfOpenDependents) {
+  const std::unordered_map<std::string, std::string> files{
+      {"Shared.ttcn", "module Shared { type integer Id; const integer base := 1; }"},
+      {"Open.ttcn", "module Open { import from Shared all; const Id a := base; }"},
+      {"Other.ttcn", "module Other { import from Shared all; const Id c := 3; }"},
+      {"Closed.ttcn", "module Closed { import from Shared all; const Id d := 4; }"},
+  };
+  const auto read_source = [&](const std::string& path, std::string& srcbuf) -> void {
+    srcbuf = files.at(path);
+  };
+
+  core::Program program;
+  program.Update([&](auto& modify) {
+    for (const auto& path : files | std::views::keys) {
+      modify.update(path, read_source);
+    }
+  });
+  program.SetAnalysisSkipped("Closed.ttcn", true);
+  program.Commit([](auto&) {});
+
+  const auto entries = DeferOpenDependents(program.Files().at("Shared.ttcn"));
+  // the one binding more names of the edited module comes first
+  EXPECT_EQ(Paths(entries), (std::vector<std::string>{"Open.ttcn", "Other.ttcn"}));
+  EXPECT_TRUE(program.Files().at("Open.ttcn").typecheck_deferred);
+  EXPECT_FALSE(program.Files().at("Closed.ttcn").typecheck_deferred);
+
+  // what the requests look at is still complete
+  program.Commit([&](auto& modify) {
+    modify.update("Shared.ttcn", read_source);
+  });
+  const auto& open = program.Files().at("Open.ttcn");
+  EXPECT_TRUE(open.analysis_state & core::AnalysisState::kFullCrossbind);
+  EXPECT_FALSE(open.analysis_state & core::AnalysisState::kTypecheck);
+  EXPECT_TRUE(open.module->unresolved.empty());
+}
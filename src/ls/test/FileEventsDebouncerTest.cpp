@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <LSProtocol.h>
+
+#include "vanadium/ls/LanguageServerFileEvents.h"
+
+using namespace vanadium::ls;
+using namespace std::chrono_literals;
+
+namespace {
+class FlushCounter {
+ public:
+  void operator()() {
+    {
+      std::lock_guard l(mutex_);
+      ++flushes_;
+    }
+    cv_.notify_all();
+  }
+
+  bool WaitFor(std::size_t flushes) {
+    std::unique_lock l(mutex_);
+    return cv_.wait_for(l, 5s, [&] {
+      return flushes_ >= flushes;
+    });
+  }
+
+  std::size_t Flushes() {
+    std::lock_guard l(mutex_);
+    return flushes_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::size_t flushes_{0};
+};
+}  // namespace
+
+TEST(FileEventsDebouncer, KeepsLatestEventPerFile) {
+  FlushCounter flushes;
+  FileEventsDebouncer debouncer(10ms, [&] {
+    flushes();
+  });
+
+  const std::vector<lsp::FileEvent> events{
+      {.uri = "file:///ws/A.ttcn", .type = lsp::FileChangeType::kCreated},
+      {.uri = "file:///ws/B.ttcn", .type = lsp::FileChangeType::kDeleted},
+      {.uri = "file:///ws/A.ttcn", .type = lsp::FileChangeType::kChanged},
+  };
+  debouncer.Add(events);
+  ASSERT_TRUE(flushes.WaitFor(1));
+
+  const auto taken = debouncer.Take();
+  EXPECT_EQ(taken.size(), 2);
+  EXPECT_EQ(taken.at("file:///ws/A.ttcn"), lsp::FileChangeType::kChanged);
+  EXPECT_EQ(taken.at("file:///ws/B.ttcn"), lsp::FileChangeType::kDeleted);
+  EXPECT_TRUE(debouncer.Take().empty());
+}
+
+TEST(FileEventsDebouncer, PostponesFlushWhileEventsKeepComing) {
+  constexpr auto kWindow = 200ms;
+  constexpr std::size_t kEvents = 10;
+
+  FlushCounter flushes;
+  FileEventsDebouncer debouncer(kWindow, [&] {
+    flushes();
+  });
+
+  // a burst longer than the window, but with no gap as long as it
+  for (std::size_t i = 0; i < kEvents; ++i) {
+    const std::vector<lsp::FileEvent> events{{.uri = "file:///ws/A.ttcn", .type = lsp::FileChangeType::kChanged}};
+    debouncer.Add(events);
+    std::this_thread::sleep_for(kWindow / 5);
+  }
+  EXPECT_EQ(flushes.Flushes(), 0);
+
+  ASSERT_TRUE(flushes.WaitFor(1));
+  EXPECT_EQ(debouncer.Take().size(), 1);
+
+  std::this_thread::sleep_for(2 * kWindow);
+  EXPECT_EQ(flushes.Flushes(), 1);
+}
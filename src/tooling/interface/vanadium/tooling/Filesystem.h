@@ -1,10 +1,13 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <expected>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <vanadium/lib/Error.h>
 #include <vanadium/lib/FunctionRef.h>
@@ -14,6 +17,25 @@ namespace fs {
 
 using FileContentsAllocator = lib::FunctionRef<char*(std::size_t)>;
 
+enum class FileChangeKind : std::uint8_t {
+  kChanged,  // the created ones as well
+  kDeleted,
+};
+
+struct FileChange {
+  std::string path;  // relative to the watched directory
+  FileChangeKind kind;
+};
+
+class Watcher {
+ public:
+  virtual ~Watcher() = default;
+
+  // Blocks until some of the files under the watched directory change or the timeout expires,
+  // the changes coming in a burst are returned at once, the latest one per file
+  [[nodiscard]] virtual std::vector<FileChange> Wait(std::optional<std::chrono::milliseconds> timeout) = 0;
+};
+
 class Filesystem {
  public:
   virtual ~Filesystem() = default;
@@ -30,6 +52,9 @@ class Filesystem {
   [[nodiscard]] virtual std::optional<Error> WriteFile(const std::string& path, std::string_view contents) const = 0;
 
   virtual void VisitFiles(const std::string& path, lib::Consumer<std::string> accept) const = 0;
+
+  // Watches the directory recursively
+  [[nodiscard]] virtual std::unique_ptr<Watcher> Watch(const std::string& path) const = 0;
 };
 
 struct Path {
@@ -77,6 +102,10 @@ struct Path {
   void VisitFiles(lib::Consumer<std::string> accept) const {
     fs->VisitFiles(base_path, accept);
   }
+
+  [[nodiscard]] std::unique_ptr<Watcher> Watch() const {
+    return fs->Watch(base_path);
+  }
 };
 
 template <std::derived_from<Filesystem> ConcreteFS>
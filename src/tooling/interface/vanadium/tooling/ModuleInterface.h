@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string>
+
+#include <vanadium/ast/AST.h>
+
+namespace vanadium::tooling {
+
+// The interface of a TTCN-3 module is its source with the bodies of the functions, altsteps, testcases,
+// constructors and of the control part emptied. All the declarations are kept as written, the private ones too,
+// as the public ones may refer to them, so the interface is analyzed like any other module at a fraction of the cost.
+// External projects are loaded from their interfaces when the solution is told where to find them,
+// see ExternalProjectDescriptor::interface
+[[nodiscard]] std::string EmitModuleInterface(const ast::AST& ast);
+
+}  // namespace vanadium::tooling
@@ -19,6 +19,9 @@ namespace tooling {
 struct ExternalProjectDescriptor {
   std::string path;
   std::optional<std::vector<std::string>> references;
+  // Directory of the module interfaces emitted by `vanadium-tidy --emit-interface`,
+  // loaded instead of the sources when present, see ModuleInterface.h
+  std::optional<std::string> interface;
 };
 
 struct ProjectManifest {
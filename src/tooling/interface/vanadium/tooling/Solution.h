@@ -2,6 +2,8 @@
 
 #include <expected>
 #include <ranges>
+#include <string>
+#include <vector>
 
 #include <vanadium/core/Program.h>
 #include <vanadium/lib/Error.h>
@@ -48,8 +50,18 @@ class Solution {
     return projects_ | std::views::values;
   }
 
+  // Analyzes what has changed in all the projects at once, see core::Program::Analyze
+  void Analyze();
+
+  // Whether the file is picked up by the projects
+  [[nodiscard]] static bool IsSourceFile(std::string_view path);
+
   static std::expected<Solution, Error> Load(const fs::Path&, lib::Consumer<Solution&> precommit = [](auto&) {});
 
+  // The source files of the projects the solution manages (the external ones are not), relative to its directory,
+  // found the way Load() does but without reading them
+  static std::expected<std::vector<std::string>, Error> ListSourceFiles(const fs::Path&);
+
  private:
   Solution(Project&& root_project);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -27,6 +28,9 @@ class SystemFS final : public Filesystem {
   [[nodiscard]] std::optional<Error> WriteFile(const std::string& path, std::string_view contents) const final;
 
   void VisitFiles(const std::string& path, lib::Consumer<std::string> accept) const final;
+
+  // inotify on Linux, polling the modification times elsewhere or if it is unavailable
+  [[nodiscard]] std::unique_ptr<Watcher> Watch(const std::string& path) const final;
 };
 
 }  // namespace vanadium::tooling::fs
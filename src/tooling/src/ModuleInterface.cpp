@@ -0,0 +1,57 @@
+#include "vanadium/tooling/ModuleInterface.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <vanadium/ast/AST.h>
+#include <vanadium/ast/ASTNodes.h>
+#include <vanadium/ast/ASTTypes.h>
+
+namespace vanadium::tooling {
+
+namespace {
+const ast::nodes::BlockStmt* BodyOf(const ast::Node* n) {
+  switch (n->nkind) {
+    case ast::NodeKind::FuncDecl:
+      return n->As<ast::nodes::FuncDecl>()->body;
+    case ast::NodeKind::ConstructorDecl:
+      return n->As<ast::nodes::ConstructorDecl>()->body;
+    case ast::NodeKind::ControlPart:
+      return n->As<ast::nodes::ControlPart>()->body;
+    default:
+      return nullptr;
+  }
+}
+}  // namespace
+
+std::string EmitModuleInterface(const ast::AST& ast) {
+  std::vector<ast::Range> bodies;
+  ast::Inspect(ast.root, [&](const ast::Node* n) {
+    if (const auto* body = BodyOf(n); body != nullptr) {
+      bodies.push_back(body->nrange);
+      return false;
+    }
+    // the methods are nested into the classes, the definitions into the groups
+    return n->nkind != ast::NodeKind::BlockStmt;
+  });
+  std::ranges::sort(bodies, {}, &ast::Range::begin);
+
+  std::string interface;
+  interface.reserve(ast.src.size());
+
+  ast::pos_t pos{0};
+  for (const auto& body : bodies) {
+    if (body.begin < pos) [[unlikely]] {
+      continue;  // overlapping ranges of the erroneous code
+    }
+    interface += ast.src.substr(pos, body.begin - pos);
+    interface += "{}";
+    pos = body.end;
+  }
+  interface += ast.src.substr(pos);
+
+  return interface;
+}
+
+}  // namespace vanadium::tooling
@@ -1,7 +1,10 @@
 #include "vanadium/tooling/Solution.h"
 
+#include <algorithm>
 #include <expected>
 #include <print>
+#include <string>
+#include <vector>
 
 #include <vanadium/core/Program.h>
 #include <vanadium/lib/Error.h>
@@ -11,23 +14,41 @@
 #include "vanadium/tooling/Project.h"
 #include "vanadium/tooling/ProjectSorter.h"
 
-namespace vanadium::core {
-extern thread_local bool do_reanalyse_program_deps;
-}
-
 namespace vanadium::tooling {
 
 Solution::Solution(Project&& root_project) : root_project_(std::move(root_project)) {}
 
 namespace {
-void InitSubproject(const Solution& solution, SolutionProject& subproject) {
-  const auto& project_dir = subproject.project.Directory();
+// Visits the source files of the project and of its search paths, relative to the solution directory
+void VisitProjectSources(const fs::Path& solution_dir, Project& project, lib::Consumer<std::string> visit) {
+  const auto& project_dir = project.Directory();
   if (!project_dir.Exists()) {
     // TODO
     std::println(stderr, "Project directory does not exist: '{}'", project_dir.base_path);
     return;
   }
 
+  const auto scan_dir = [&](const fs::Path& dir) {
+    dir.VisitFiles([&](const std::string& filepath) {
+      if (!Solution::IsSourceFile(filepath)) {
+        return;
+      }
+      visit(dir.fs->Relative(dir.Join(filepath), solution_dir.base_path));
+    });
+  };
+  scan_dir(project_dir);
+  if (const auto& search_paths = project.Manifest().project.search_paths; search_paths) {
+    for (const auto& search_path : *search_paths) {
+      const auto additional_dir = project_dir.Resolve(search_path).Normalize();
+      if (additional_dir.Exists()) {
+        project.AddSearchPath(additional_dir);
+        scan_dir(additional_dir);
+      }
+    }
+  }
+}
+
+void InitSubproject(const Solution& solution, SolutionProject& subproject) {
   const auto read_file = [&](const std::string& path, std::string& srcbuf) -> void {
     const auto res = solution.Directory().ReadFile(path, [&](std::size_t size) {
       srcbuf.resize(size);
@@ -43,28 +64,9 @@ void InitSubproject(const Solution& solution, SolutionProject& subproject) {
   };
 
   subproject.program.Update([&](const core::Program::ProgramModifier& modify) {
-    const auto scan_dir = [&](const fs::Path& dir) {
-      dir.VisitFiles([&](const std::string& filepath) {
-        if (!filepath.ends_with(".ttcn") && !filepath.ends_with(".asn")) {
-          return;
-        }
-        if (filepath.contains("stubs")) {
-          // TODO: home hack
-          return;
-        }
-        modify.update(dir.fs->Relative(dir.Join(filepath), solution.Directory().base_path), read_file);
-      });
-    };
-    scan_dir(project_dir);
-    if (const auto& search_paths = subproject.project.Manifest().project.search_paths; search_paths) {
-      for (const auto& search_path : *search_paths) {
-        const auto additional_dir = project_dir.Resolve(search_path).Normalize();
-        if (additional_dir.Exists()) {
-          subproject.project.AddSearchPath(additional_dir);
-          scan_dir(additional_dir);
-        }
-      }
-    }
+    VisitProjectSources(solution.Directory(), subproject.project, [&](std::string path) {
+      modify.update(path, read_file);
+    });
   });
 }
 }  // namespace
@@ -99,8 +101,19 @@ std::expected<Solution, Error> Solution::Load(const fs::Path& path, lib::Consume
 
   if (root_desc.external) {
     for (const auto& [ext_name, ext_desc] : *root_desc.external) {
+      // only the declarations of the external projects matter, their interfaces are much cheaper than the sources
+      auto project_path = path.Resolve(ext_desc.path);
+      if (ext_desc.interface) {
+        if (auto interface_path = path.Resolve(*ext_desc.interface); interface_path.Exists()) {
+          project_path = std::move(interface_path);
+        } else {
+          std::println(stderr, "Interfaces of project '{}' are not found at '{}', loading its sources", ext_name,
+                       interface_path.base_path);
+        }
+      }
+
       auto [it, inserted] =
-          solution.projects_.try_emplace(ext_name, Project(path.Resolve(ext_desc.path), "",
+          solution.projects_.try_emplace(ext_name, Project(std::move(project_path), "",
                                                            ProjectManifest{
                                                                .project =
                                                                    {
@@ -171,14 +184,62 @@ std::expected<Solution, Error> Solution::Load(const fs::Path& path, lib::Consume
   }
 
   precommit(solution);
+  solution.Analyze();
+
+  return solution;
+}
 
-  core::do_reanalyse_program_deps = false;
-  for (const auto* proj : *sorted_projs) {
-    const_cast<SolutionProject*>(proj)->program.Commit([](auto&) {});
+std::expected<std::vector<std::string>, Error> Solution::ListSourceFiles(const fs::Path& path) {
+  auto root_load_result = tooling::Project::Load(path);
+  if (!root_load_result.has_value()) {
+    return std::unexpected{Error{"Failed to load root project", std::move(root_load_result.error())}};
   }
-  core::do_reanalyse_program_deps = true;
 
-  return solution;
+  std::vector<std::string> files;
+  const auto collect = [&](std::string file) {
+    files.emplace_back(std::move(file));
+  };
+
+  if (const auto& subprojects = root_load_result->Manifest().project.subprojects; subprojects) {
+    for (const auto& subpath : *subprojects) {
+      auto result = tooling::Project::Load(path.Resolve(subpath));
+      if (!result) {
+        return std::unexpected{
+            Error{std::format("Failed to load project at '{}'", subpath), std::move(result.error())}};
+      }
+      VisitProjectSources(path, *result, collect);
+    }
+  } else {
+    VisitProjectSources(path, *root_load_result, collect);
+  }
+
+  // the search paths of the projects may overlap
+  std::ranges::sort(files);
+  const auto [first, last] = std::ranges::unique(files);
+  files.erase(first, last);
+
+  return files;
+}
+
+bool Solution::IsSourceFile(std::string_view path) {
+  if (!path.ends_with(".ttcn") && !path.ends_with(".asn")) {
+    return false;
+  }
+  if (path.contains("stubs")) {
+    // TODO: home hack
+    return false;
+  }
+  return true;
+}
+
+void Solution::Analyze() {
+  // the ordering of the work across the projects is up to the task graph
+  std::vector<core::Program*> programs;
+  programs.reserve(projects_.size());
+  for (auto& project : projects_ | std::views::values) {
+    programs.push_back(&project.program);
+  }
+  core::Program::Analyze(programs);
 }
 
 const SolutionProject* Solution::ProjectOf(std::string_view path) const {
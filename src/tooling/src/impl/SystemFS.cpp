@@ -1,15 +1,30 @@
 #include "vanadium/tooling/impl/SystemFS.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <expected>
 #include <filesystem>
 #include <fstream>
 #include <iosfwd>
 #include <iostream>
+#include <memory>
 #include <optional>
+#include <ranges>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 #include <vanadium/lib/Error.h>
 
@@ -96,4 +111,236 @@ void SystemFS::VisitFiles(const std::string &path, lib::Consumer<std::string> ac
   VisitDirectory(base_path, accept_fwd);
 }
 
+namespace {
+using Changes = std::unordered_map<std::string, FileChangeKind>;
+
+std::vector<FileChange> ToFileChanges(Changes&& changes) {
+  std::vector<FileChange> result;
+  result.reserve(changes.size());
+  for (auto& [path, kind] : changes) {
+    result.emplace_back(std::move(path), kind);
+  }
+  return result;
+}
+
+class PollingWatcher final : public Watcher {
+ public:
+  explicit PollingWatcher(std::filesystem::path base_path) : base_path_(std::move(base_path)), stamps_(Scan()) {}
+
+  std::vector<FileChange> Wait(std::optional<std::chrono::milliseconds> timeout) final {
+    constexpr std::chrono::milliseconds kPollInterval{500};
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = timeout ? std::optional{Clock::now() + *timeout} : std::nullopt;
+    while (true) {
+      Clock::duration interval = kPollInterval;
+      if (deadline) {
+        interval = std::clamp<Clock::duration>(*deadline - Clock::now(), Clock::duration::zero(), interval);
+      }
+      std::this_thread::sleep_for(interval);
+
+      auto stamps = Scan();
+      Changes changes;
+      for (const auto& [path, stamp] : stamps) {
+        if (const auto it = stamps_.find(path); it == stamps_.end() || it->second != stamp) {
+          changes.emplace(path, FileChangeKind::kChanged);
+        }
+      }
+      for (const auto& path : stamps_ | std::views::keys) {
+        if (!stamps.contains(path)) {
+          changes.emplace(path, FileChangeKind::kDeleted);
+        }
+      }
+      stamps_ = std::move(stamps);
+
+      if (!changes.empty() || (deadline && Clock::now() >= *deadline)) {
+        return ToFileChanges(std::move(changes));
+      }
+    }
+  }
+
+ private:
+  struct Stamp {
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size;
+
+    bool operator==(const Stamp&) const = default;
+  };
+
+  [[nodiscard]] std::unordered_map<std::string, Stamp> Scan() const {
+    std::unordered_map<std::string, Stamp> stamps;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(
+             base_path_, std::filesystem::directory_options::skip_permission_denied, ec)) {
+      if (!entry.is_regular_file(ec)) {
+        continue;
+      }
+      stamps.try_emplace(entry.path().lexically_relative(base_path_).string(),
+                         Stamp{.mtime = entry.last_write_time(ec), .size = entry.file_size(ec)});
+    }
+    return stamps;
+  }
+
+  std::filesystem::path base_path_;
+  std::unordered_map<std::string, Stamp> stamps_;
+};
+
+#ifdef __linux__
+class InotifyWatcher final : public Watcher {
+ public:
+  static std::unique_ptr<InotifyWatcher> Create(std::filesystem::path base_path) {
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd == -1) {
+      return nullptr;
+    }
+    auto watcher = std::unique_ptr<InotifyWatcher>(new InotifyWatcher(fd, std::move(base_path)));
+    if (!watcher->AddDirectory(watcher->base_path_, nullptr) || watcher->directories_.empty()) {
+      return nullptr;
+    }
+    return watcher;
+  }
+
+  InotifyWatcher(const InotifyWatcher&) = delete;
+  InotifyWatcher& operator=(const InotifyWatcher&) = delete;
+
+  ~InotifyWatcher() final {
+    close(fd_);
+  }
+
+  std::vector<FileChange> Wait(std::optional<std::chrono::milliseconds> timeout) final {
+    if (fallback_ != nullptr) {
+      return fallback_->Wait(timeout);
+    }
+
+    // e.g. editors save into a temporary file and rename it, so the burst is awaited to settle
+    constexpr std::chrono::milliseconds kSettleWindow{50};
+
+    Changes changes;
+    while (true) {
+      pollfd pfd{.fd = fd_, .events = POLLIN, .revents = 0};
+      const auto wait_for = !changes.empty() ? kSettleWindow : timeout.value_or(std::chrono::milliseconds{-1});
+      const int ready = poll(&pfd, 1, static_cast<int>(wait_for.count()));
+      if (ready == -1) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      if (ready == 0) {
+        break;
+      }
+      Drain(changes);
+      if (fallback_ != nullptr) {
+        break;
+      }
+    }
+    return ToFileChanges(std::move(changes));
+  }
+
+ private:
+  static constexpr std::uint32_t kMask =
+      IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+
+  InotifyWatcher(int fd, std::filesystem::path base_path) : fd_(fd), base_path_(std::move(base_path)) {}
+
+  // The files found inside are reported if the directory has just appeared, as they have no events of their own.
+  // Fails once the watches have run out (see max_user_watches), as the directory would go unnoticed then,
+  // while the ones that cannot be watched anyway, e.g. unreadable or already gone, are skipped
+  bool AddDirectory(const std::filesystem::path& dir, Changes* changes) {
+    const int wd = inotify_add_watch(fd_, dir.c_str(), kMask);
+    if (wd == -1) {
+      return errno != ENOSPC && errno != ENOMEM;
+    }
+    directories_.insert_or_assign(wd, dir);
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+      if (entry.is_directory(ec)) {
+        if (!AddDirectory(entry.path(), changes)) {
+          return false;
+        }
+      } else if (changes != nullptr) {
+        changes->insert_or_assign(Relative(entry.path()), FileChangeKind::kChanged);
+      }
+    }
+    return true;
+  }
+
+  void Drain(Changes& changes) {
+    alignas(inotify_event) char buf[16 * 1024];
+    while (true) {
+      const auto n = read(fd_, buf, sizeof(buf));
+      if (n <= 0) {
+        return;
+      }
+      for (const char* p = buf; p < buf + n;) {
+        const auto* event = reinterpret_cast<const inotify_event*>(p);
+        p += sizeof(inotify_event) + event->len;
+
+        if ((event->mask & IN_Q_OVERFLOW) != 0) {
+          // the events are lost, so everything is considered changed
+          ReportFiles(base_path_, changes);
+          continue;
+        }
+        if ((event->mask & IN_IGNORED) != 0) {
+          directories_.erase(event->wd);
+          continue;
+        }
+
+        const auto it = directories_.find(event->wd);
+        if (it == directories_.end() || event->len == 0) {
+          continue;
+        }
+        const auto path = it->second / event->name;
+
+        if ((event->mask & IN_ISDIR) != 0) {
+          if ((event->mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+            if (fallback_ == nullptr && !AddDirectory(path, &changes)) {
+              // the rest is left to the polling, which starts off the current state, while the events read
+              // until then are still reported
+              fallback_ = std::make_unique<PollingWatcher>(base_path_);
+            }
+            if (fallback_ != nullptr) {
+              ReportFiles(path, changes);
+            }
+          }
+          continue;
+        }
+        changes.insert_or_assign(Relative(path), (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0
+                                                     ? FileChangeKind::kDeleted
+                                                     : FileChangeKind::kChanged);
+      }
+    }
+  }
+
+  void ReportFiles(const std::filesystem::path& dir, Changes& changes) const {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(
+             dir, std::filesystem::directory_options::skip_permission_denied, ec)) {
+      if (entry.is_regular_file(ec)) {
+        changes.insert_or_assign(Relative(entry.path()), FileChangeKind::kChanged);
+      }
+    }
+  }
+
+  [[nodiscard]] std::string Relative(const std::filesystem::path& path) const {
+    return path.lexically_relative(base_path_).string();
+  }
+
+  int fd_;
+  std::filesystem::path base_path_;
+  std::unordered_map<int, std::filesystem::path> directories_;
+  std::unique_ptr<PollingWatcher> fallback_;  // once a new directory cannot be watched
+};
+#endif
+}  // namespace
+
+std::unique_ptr<Watcher> SystemFS::Watch(const std::string &path) const {
+#ifdef __linux__
+  if (auto watcher = InotifyWatcher::Create(path)) {
+    return watcher;
+  }
+#endif
+  return std::make_unique<PollingWatcher>(path);
+}
+
 }  // namespace vanadium::tooling::fs
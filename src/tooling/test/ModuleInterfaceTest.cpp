@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <vanadium/ast/Parser.h>
+#include <vanadium/core/Program.h>
+#include <vanadium/lib/Arena.h>
+
+#include "vanadium/tooling/ModuleInterface.h"
+
+using namespace vanadium;
+
+namespace {
+constexpr std::string_view kLibrary = R"(module Lib {
+import from Other all;
+
+type record Msg { integer id, charstring payload optional }
+private const integer c_base := 40;
+const integer c_answer := c_base + 2;
+template Msg t_msg(integer p_id) := { id := p_id, payload := omit }
+
+// Makes a message
+function f_make(integer p_id) return Msg {
+  var Msg v_msg := { id := p_id, payload := "x" };
+  for (var integer i := 0; i < 3; i := i + 1) { v_msg.id := v_msg.id + i; }
+  return v_msg;
+}
+
+external function f_ext(integer p) return integer;
+
+group g {
+  altstep as_any() { [] any port.receive { log("got"); } }
+}
+
+type class C {
+  var integer m_x;
+  create(integer p_x) { m_x := p_x; }
+  function get() return integer { return m_x; }
+}
+
+control { log("control"); }
+}
+)";
+
+std::string ParseAndEmit(std::string_view src) {
+  lib::Arena arena;
+  const auto ast = ast::Parse(arena, src);
+  EXPECT_TRUE(ast.errors.empty());
+  return tooling::EmitModuleInterface(ast);
+}
+}  // namespace
+
+TEST(ModuleInterface, KeepsDeclarationsOnly) {
+  const auto interface = ParseAndEmit(kLibrary);
+
+  for (const auto kept : {
+           "import from Other all;",
+           "type record Msg { integer id, charstring payload optional }",
+           "private const integer c_base := 40;",
+           "template Msg t_msg(integer p_id) := { id := p_id, payload := omit }",
+           "// Makes a message\nfunction f_make(integer p_id) return Msg {}",
+           "external function f_ext(integer p) return integer;",
+           "altstep as_any() {}",
+           "var integer m_x;",
+           "create(integer p_x) {}",
+           "function get() return integer {}",
+           "control {}",
+       }) {
+    EXPECT_TRUE(interface.contains(kept)) << kept << "\n---\n" << interface;
+  }
+  for (const auto stripped : {"v_msg", "log(", "return m_x"}) {
+    EXPECT_FALSE(interface.contains(stripped)) << stripped << "\n---\n" << interface;
+  }
+
+  // the interface is a module on its own
+  lib::Arena arena;
+  EXPECT_TRUE(ast::Parse(arena, interface).errors.empty());
+  EXPECT_EQ(ParseAndEmit(interface), interface);
+}
+
+TEST(ModuleInterface, ImportersResolveAgainstInterface) {
+  const std::unordered_map<std::string, std::string> files{
+      {"Lib", ParseAndEmit(R"(module Lib {
+type record Msg { integer id }
+function f_make(integer p_id) return Msg { var Msg v := { id := p_id }; return v; }
+})")},
+      {"User", R"(module User {
+import from Lib all;
+function f_use() return integer { var Msg m := f_make(1); return m.id; }
+})"},
+  };
+
+  const auto read_source = [&](const std::string& path, std::string& buf) {
+    buf = files.at(path);
+  };
+  core::Program program;
+  program.Commit([&](const core::Program::ProgramModifier& modify) {
+    for (const auto& path : files | std::views::keys) {
+      modify.update(path, read_source);
+    }
+  });
+
+  const auto* user = program.GetFile("User");
+  ASSERT_NE(user, nullptr);
+  EXPECT_TRUE(user->ast.errors.empty());
+  EXPECT_TRUE(user->semantic_errors.empty());
+  EXPECT_TRUE(user->type_errors.empty());
+}
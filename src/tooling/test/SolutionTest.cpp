@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "vanadium/tooling/Filesystem.h"
+#include "vanadium/tooling/Solution.h"
+#include "vanadium/tooling/impl/SystemFS.h"
+
+using namespace vanadium::tooling;
+
+namespace {
+class SolutionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           ("vanadium-solution-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "-" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+  }
+  void TearDown() override {
+    std::filesystem::remove_all(dir_);
+  }
+
+  void Write(const std::string& path, std::string_view contents) {
+    std::filesystem::create_directories((dir_ / path).parent_path());
+    std::ofstream(dir_ / path) << contents;
+  }
+
+  std::filesystem::path dir_;
+};
+}  // namespace
+
+TEST_F(SolutionTest, ListsSourcesOfManagedProjects) {
+  Write(".vanadiumrc.toml", R"(
+root = true
+
+[project]
+name = "root"
+subprojects = ["a", "b"]
+
+[external]
+dep = { path = "deps/dep" }
+)");
+  Write("a/.vanadiumrc.toml", R"(
+root = false
+
+[project]
+name = "a"
+search_paths = ["../shared"]
+)");
+  Write("b/.vanadiumrc.toml", R"(
+root = false
+
+[project]
+name = "b"
+search_paths = ["../shared"]
+)");
+  Write("a/A.ttcn", "module A {}");
+  Write("a/notes.txt", "");
+  Write("b/B.asn", "B DEFINITIONS ::= BEGIN END");
+  Write("shared/S.ttcn", "module S {}");
+  Write("deps/dep/D.ttcn", "module D {}");
+
+  const auto files = Solution::ListSourceFiles(fs::Root<fs::SystemFS>(dir_.string()));
+  ASSERT_TRUE(files.has_value()) << files.error().String();
+
+  std::vector<std::string> generic;
+  for (const auto& file : *files) {
+    generic.push_back(std::filesystem::path(file).generic_string());
+  }
+  EXPECT_EQ(generic, (std::vector<std::string>{"a/A.ttcn", "b/B.asn", "shared/S.ttcn"}));
+}
+
+TEST_F(SolutionTest, FailsToListWithoutManifest) {
+  std::filesystem::create_directories(dir_);
+  EXPECT_FALSE(Solution::ListSourceFiles(fs::Root<fs::SystemFS>(dir_.string())).has_value());
+}
@@ -0,0 +1,99 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "vanadium/tooling/Filesystem.h"
+#include "vanadium/tooling/impl/SystemFS.h"
+
+using namespace vanadium::tooling;
+
+namespace {
+class WatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir_ = std::filesystem::temp_directory_path() /
+           ("vanadium-watcher-" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "-" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_ / "sub");
+    Write("sub/A.ttcn", "module A {}");
+    watcher_ = fs::Root<fs::SystemFS>(dir_.string()).Watch();
+  }
+  void TearDown() override {
+    watcher_.reset();
+    std::filesystem::remove_all(dir_);
+  }
+
+  void Write(const std::string& path, std::string_view contents) {
+    std::ofstream(dir_ / path) << contents;
+  }
+
+  std::vector<std::pair<std::string, fs::FileChangeKind>> Wait() {
+    std::vector<std::pair<std::string, fs::FileChangeKind>> changes;
+    for (auto& change : watcher_->Wait(std::nullopt)) {
+      changes.emplace_back(std::filesystem::path(change.path).generic_string(), change.kind);
+    }
+    std::ranges::sort(changes);
+    return changes;
+  }
+
+  std::filesystem::path dir_;
+  std::unique_ptr<fs::Watcher> watcher_;
+};
+}  // namespace
+
+TEST_F(WatcherTest, ReportsChangedAndDeletedFiles) {
+  Write("sub/A.ttcn", "module A { const integer c := 1; }");
+  Write("B.ttcn", "module B {}");
+  EXPECT_EQ(Wait(), (std::vector<std::pair<std::string, fs::FileChangeKind>>{
+                        {"B.ttcn", fs::FileChangeKind::kChanged},
+                        {"sub/A.ttcn", fs::FileChangeKind::kChanged},
+                    }));
+
+  std::filesystem::remove(dir_ / "sub/A.ttcn");
+  EXPECT_EQ(Wait(), (std::vector<std::pair<std::string, fs::FileChangeKind>>{
+                        {"sub/A.ttcn", fs::FileChangeKind::kDeleted},
+                    }));
+}
+
+TEST_F(WatcherTest, ReturnsNothingUponTimeout) {
+  EXPECT_TRUE(watcher_->Wait(std::chrono::milliseconds{0}).empty());
+
+  Write("sub/A.ttcn", "module A { const integer c := 1; }");
+  const auto changes = watcher_->Wait(std::chrono::milliseconds{0});
+  ASSERT_EQ(changes.size(), 1);
+  EXPECT_EQ(changes.front().kind, fs::FileChangeKind::kChanged);
+}
+
+TEST_F(WatcherTest, ReportsRenamesAndNewDirectories) {
+  // the way the editors save the files
+  Write("A.ttcn.tmp", "module A {}");
+  std::filesystem::rename(dir_ / "A.ttcn.tmp", dir_ / "sub/A.ttcn");
+
+  const auto staging = std::filesystem::temp_directory_path() / (dir_.filename().string() + "-staging");
+  std::filesystem::create_directories(staging / "nested");
+  std::ofstream(staging / "nested/C.ttcn") << "module C {}";
+  std::filesystem::rename(staging, dir_ / "new");
+
+  const auto changes = Wait();
+  EXPECT_THAT(changes, ::testing::Contains(std::pair<std::string, fs::FileChangeKind>{
+                           "sub/A.ttcn", fs::FileChangeKind::kChanged}));
+  EXPECT_THAT(changes, ::testing::Contains(std::pair<std::string, fs::FileChangeKind>{
+                           "new/nested/C.ttcn", fs::FileChangeKind::kChanged}));
+
+  // the files of the new directory are watched as well
+  Write("new/nested/C.ttcn", "module C { const integer c := 1; }");
+  EXPECT_EQ(Wait(), (std::vector<std::pair<std::string, fs::FileChangeKind>>{
+                        {"new/nested/C.ttcn", fs::FileChangeKind::kChanged},
+                    }));
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "vanadium/bench/Corpus.h"
+
+namespace vanadium::bench {
+
+// Runs the benchmark over each of the corpus shapes, the shape is its first argument
+void ApplyCorpusShapes(benchmark::internal::Benchmark*);
+
+// The shape the benchmark runs over, labeled with its name
+[[nodiscard]] CorpusShape UseCorpusShape(benchmark::State&);
+
+[[nodiscard]] inline bool IsAsnFile(std::string_view path) {
+  return path.ends_with(".asn");
+}
+
+[[nodiscard]] std::size_t TtcnBytes(std::span<const CorpusFile>);
+[[nodiscard]] std::size_t AsnBytes(std::span<const CorpusFile>);
+
+// Reports MB/s of the source text and nodes/s of the built trees per iteration
+void ReportThroughput(benchmark::State&, std::size_t bytes_per_iteration, std::size_t nodes_per_iteration);
+
+}  // namespace vanadium::bench
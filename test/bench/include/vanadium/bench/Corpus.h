@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vanadium::bench {
+
+// The shape of a synthetic solution: the generated sources are deterministic, so the runs are comparable
+struct CorpusOptions {
+  std::size_t modules{16};
+  std::size_t imports_per_module{4};  // of the preceding modules
+
+  std::size_t records_per_module{8};
+  std::size_t fields_per_record{8};  // each record refers to the previous one, if any
+
+  std::size_t functions_per_module{8};
+  std::size_t expression_depth{4};  // of the nested binary expressions in each function
+
+  std::size_t asn_modules{0};  // imported by the TTCN-3 modules round-robin
+  std::size_t asn_fields_per_sequence{8};
+};
+
+enum class CorpusShape : std::uint8_t {
+  kTypical,
+  kDeepExpressions,
+  kHugeRecords,
+  kManyImports,
+  kManyModules,
+  kWithAsn,
+};
+inline constexpr std::size_t kCorpusShapes = static_cast<std::size_t>(CorpusShape::kWithAsn) + 1;
+
+[[nodiscard]] CorpusOptions CorpusPreset(CorpusShape);
+[[nodiscard]] std::string_view CorpusShapeName(CorpusShape);
+
+struct CorpusFile {
+  std::string path;
+  std::string src;
+};
+
+[[nodiscard]] std::vector<CorpusFile> GenerateCorpus(const CorpusOptions&);
+
+[[nodiscard]] std::size_t CorpusBytes(std::span<const CorpusFile>);
+
+// Generated once per process
+[[nodiscard]] const std::vector<CorpusFile>& CachedCorpus(CorpusShape);
+
+}  // namespace vanadium::bench
@@ -0,0 +1,46 @@
+#include "vanadium/bench/BenchUtils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "vanadium/bench/Corpus.h"
+
+namespace vanadium::bench {
+
+void ApplyCorpusShapes(benchmark::internal::Benchmark* b) {
+  b->ArgName("shape");
+  for (std::size_t shape = 0; shape < kCorpusShapes; ++shape) {
+    b->Arg(static_cast<std::int64_t>(shape));
+  }
+  b->Unit(benchmark::kMillisecond);
+}
+
+CorpusShape UseCorpusShape(benchmark::State& state) {
+  const auto shape = static_cast<CorpusShape>(state.range(0));
+  state.SetLabel(std::string(CorpusShapeName(shape)));
+  return shape;
+}
+
+std::size_t TtcnBytes(std::span<const CorpusFile> files) {
+  std::size_t bytes{0};
+  for (const auto& file : files) {
+    bytes += IsAsnFile(file.path) ? 0 : file.src.size();
+  }
+  return bytes;
+}
+
+std::size_t AsnBytes(std::span<const CorpusFile> files) {
+  return CorpusBytes(files) - TtcnBytes(files);
+}
+
+void ReportThroughput(benchmark::State& state, std::size_t bytes_per_iteration, std::size_t nodes_per_iteration) {
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes_per_iteration));
+  state.counters["nodes"] = benchmark::Counter(static_cast<double>(state.iterations() * nodes_per_iteration),
+                                               benchmark::Counter::kIsRate);
+}
+
+}  // namespace vanadium::bench
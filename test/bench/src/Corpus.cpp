@@ -0,0 +1,195 @@
+#include "vanadium/bench/Corpus.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vanadium::bench {
+
+namespace {
+std::string TtcnModuleName(std::size_t i) {
+  return std::format("M{}", i);
+}
+std::string AsnModuleName(std::size_t i) {
+  return std::format("A{}", i);
+}
+
+std::string NestedExpression(std::string_view module, std::size_t depth) {
+  constexpr std::string_view kOperators[] = {"+", "-", "*"};
+
+  std::string expr = "p";
+  for (std::size_t d = 0; d < depth; ++d) {
+    const auto op = kOperators[d % std::size(kOperators)];
+    if (d % 2 == 0) {
+      expr = std::format("({}_c {} {})", module, op, expr);
+    } else {
+      expr = std::format("({} {} {})", expr, op, d + 1);
+    }
+  }
+  return expr;
+}
+
+std::string TtcnModule(const CorpusOptions& opts, std::size_t i) {
+  const auto name = TtcnModuleName(i);
+  std::string src = std::format("module {} {{\n", name);
+
+  std::string sum = "1";
+  for (std::size_t k = 1; k <= std::min(opts.imports_per_module, i); ++k) {
+    const auto imported = TtcnModuleName(i - k);
+    src += std::format("import from {} all;\n", imported);
+    sum += std::format(" + {}_c", imported);
+  }
+  std::string asn_type;
+  if (opts.asn_modules > 0) {
+    const auto imported = AsnModuleName(i % opts.asn_modules);
+    src += std::format("import from {} all;\n", imported);
+    asn_type = std::format("{}Seq", imported);
+  }
+  src += std::format("\nconst integer {}_c := {};\n\n", name, sum);
+
+  for (std::size_t r = 0; r < opts.records_per_module; ++r) {
+    src += std::format("type record {}_R{} {{\n", name, r);
+    for (std::size_t f = 0; f < opts.fields_per_record; ++f) {
+      switch (f % 4) {
+        case 0:
+          src += std::format("  integer f{}", f);
+          break;
+        case 1:
+          src += std::format("  charstring f{}", f);
+          break;
+        case 2:
+          src += std::format("  boolean f{} optional", f);
+          break;
+        default:
+          src += r > 0 ? std::format("  {}_R{} f{} optional", name, r - 1, f) : std::format("  integer f{}", f);
+          break;
+      }
+      src += (f + 1 < opts.fields_per_record || !asn_type.empty()) ? ",\n" : "\n";
+    }
+    if (!asn_type.empty()) {
+      src += std::format("  {} a optional\n", asn_type);
+    }
+    src += "}\n\n";
+  }
+
+  const auto expr = NestedExpression(name, opts.expression_depth);
+  for (std::size_t k = 0; k < opts.functions_per_module; ++k) {
+    src += std::format("function {}_f{}(integer p) return integer {{\n", name, k);
+    if (opts.records_per_module > 0 && opts.fields_per_record > 0) {
+      src += std::format("  var {}_R{} r := {{ f0 := p }};\n", name, k % opts.records_per_module);
+      src += std::format("  var integer x := {};\n", expr);
+      src += std::format("  if (x > {}_c) {{ x := x - r.f0; }}\n", name);
+    } else {
+      src += std::format("  var integer x := {};\n", expr);
+    }
+    src += "  return x;\n}\n\n";
+  }
+
+  src += "}\n";
+  return src;
+}
+
+std::string AsnModule(const CorpusOptions& opts, std::size_t i) {
+  const auto name = AsnModuleName(i);
+  std::string src = std::format("{} DEFINITIONS AUTOMATIC TAGS ::= BEGIN\n\n", name);
+  src += std::format("{}Kind ::= ENUMERATED {{ k0, k1, k2, k3 }}\n\n", name);
+
+  src += std::format("{}Seq ::= SEQUENCE {{\n", name);
+  for (std::size_t f = 0; f < opts.asn_fields_per_sequence; ++f) {
+    switch (f % 4) {
+      case 0:
+        src += std::format("  f{} INTEGER", f);
+        break;
+      case 1:
+        src += std::format("  f{} UTF8String", f);
+        break;
+      case 2:
+        src += std::format("  f{} BOOLEAN OPTIONAL", f);
+        break;
+      default:
+        src += std::format("  f{} {}Kind", f, name);
+        break;
+    }
+    src += (f + 1 < opts.asn_fields_per_sequence) ? ",\n" : "\n";
+  }
+  src += "}\n\n";
+
+  src += std::format("{0}List ::= SEQUENCE OF {0}Seq\n\nEND\n", name);
+  return src;
+}
+}  // namespace
+
+CorpusOptions CorpusPreset(CorpusShape shape) {
+  switch (shape) {
+    case CorpusShape::kTypical:
+      return {};
+    case CorpusShape::kDeepExpressions:
+      return {.modules = 4, .functions_per_module = 32, .expression_depth = 256};
+    case CorpusShape::kHugeRecords:
+      return {.modules = 4, .records_per_module = 32, .fields_per_record = 512, .functions_per_module = 4};
+    case CorpusShape::kManyImports:
+      return {.modules = 128, .imports_per_module = 64, .records_per_module = 2, .functions_per_module = 2};
+    case CorpusShape::kManyModules:
+      return {.modules = 1024, .records_per_module = 2, .functions_per_module = 2};
+    case CorpusShape::kWithAsn:
+      return {.modules = 16, .asn_modules = 16, .asn_fields_per_sequence = 32};
+  }
+  return {};
+}
+
+std::string_view CorpusShapeName(CorpusShape shape) {
+  switch (shape) {
+    case CorpusShape::kTypical:
+      return "typical";
+    case CorpusShape::kDeepExpressions:
+      return "deep_expressions";
+    case CorpusShape::kHugeRecords:
+      return "huge_records";
+    case CorpusShape::kManyImports:
+      return "many_imports";
+    case CorpusShape::kManyModules:
+      return "many_modules";
+    case CorpusShape::kWithAsn:
+      return "with_asn";
+  }
+  return "";
+}
+
+std::vector<CorpusFile> GenerateCorpus(const CorpusOptions& opts) {
+  std::vector<CorpusFile> files;
+  files.reserve(opts.modules + opts.asn_modules);
+  for (std::size_t i = 0; i < opts.asn_modules; ++i) {
+    files.push_back({.path = AsnModuleName(i) + ".asn", .src = AsnModule(opts, i)});
+  }
+  for (std::size_t i = 0; i < opts.modules; ++i) {
+    files.push_back({.path = TtcnModuleName(i) + ".ttcn", .src = TtcnModule(opts, i)});
+  }
+  return files;
+}
+
+std::size_t CorpusBytes(std::span<const CorpusFile> files) {
+  std::size_t bytes{0};
+  for (const auto& file : files) {
+    bytes += file.src.size();
+  }
+  return bytes;
+}
+
+const std::vector<CorpusFile>& CachedCorpus(CorpusShape shape) {
+  static std::array<std::once_flag, kCorpusShapes> once;
+  static std::array<std::vector<CorpusFile>, kCorpusShapes> corpora;
+
+  const auto i = static_cast<std::size_t>(shape);
+  std::call_once(once[i], [&] {
+    corpora[i] = GenerateCorpus(CorpusPreset(shape));
+  });
+  return corpora[i];
+}
+
+}  // namespace vanadium::bench
@@ -0,0 +1,36 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "vanadium/bench/Corpus.h"
+
+namespace {
+
+using namespace vanadium::bench;
+
+// Writes the corpora into a directory per shape, e.g. to profile vanadium-tidy or vanadiumd against them
+int DumpCorpora(const std::filesystem::path& dir) {
+  for (std::size_t i = 0; i < kCorpusShapes; ++i) {
+    const auto shape = static_cast<CorpusShape>(i);
+    const auto shape_dir = dir / CorpusShapeName(shape);
+    std::filesystem::create_directories(shape_dir);
+    for (const auto& file : GenerateCorpus(CorpusPreset(shape))) {
+      std::ofstream out(shape_dir / file.path, std::ios::binary);
+      out << file.src;
+      if (!out) {
+        std::fprintf(stderr, "failed to write %s\n", (shape_dir / file.path).c_str());
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::fprintf(stderr, "usage: %s <output directory>\n", argv[0]);
+    return 1;
+  }
+  return DumpCorpora(argv[1]);
+}
@@ -0,0 +1,124 @@
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <argparse/argparse.hpp>
+
+#include <vanadium/bin/Bootstrap.h>
+#include <vanadium/lib/lserver/ReplayTransport.h>
+#include <vanadium/lib/lserver/SessionTrace.h>
+#include <vanadium/ls/LanguageServer.h>
+#include <vanadium/ls/LanguageServerTestFlags.h>
+
+// Replays a session recorded with `vanadiumd --record` against the language server running in-process,
+// so that a slow editor session can be reproduced and the fix verified without an editor.
+// The session refers to the files of the workspace it was recorded in, they are expected to be in place.
+
+namespace {
+
+using namespace vanadium;
+
+std::size_t PeakRssKiB() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<std::size_t>(usage.ru_maxrss);
+}
+
+double ToMs(std::chrono::microseconds d) {
+  return static_cast<double>(d.count()) / 1000.0;
+}
+
+// Nearest-rank, the latencies are sorted
+std::chrono::microseconds Percentile(const std::vector<std::chrono::microseconds>& latencies, std::size_t p) {
+  const auto rank = (latencies.size() * p + 99) / 100;
+  return latencies[std::max<std::size_t>(rank, 1) - 1];
+}
+
+void PrintReport(const lserver::ReplayTransport& replay, std::size_t rss_before_kib) {
+  struct MethodStats {
+    std::vector<std::chrono::microseconds> latencies;
+    std::size_t failed{0};
+  };
+  std::map<std::string, MethodStats> methods;
+  for (const auto& sample : replay.Samples()) {
+    auto& stats = methods[sample.method];
+    stats.latencies.push_back(sample.latency);
+    stats.failed += sample.failed;
+  }
+
+  std::println("{:<40} {:>7} {:>9} {:>9} {:>9} {:>9} {:>7}", "method", "count", "p50 ms", "p95 ms", "p99 ms", "max ms",
+               "failed");
+  for (auto& [method, stats] : methods) {
+    std::ranges::sort(stats.latencies);
+    std::println("{:<40} {:>7} {:>9.2f} {:>9.2f} {:>9.2f} {:>9.2f} {:>7}", method, stats.latencies.size(),
+                 ToMs(Percentile(stats.latencies, 50)), ToMs(Percentile(stats.latencies, 95)),
+                 ToMs(Percentile(stats.latencies, 99)), ToMs(stats.latencies.back()), stats.failed);
+  }
+  std::println();
+
+  const auto& counters = replay.GetCounters();
+  const auto seconds = std::max(static_cast<double>(replay.Elapsed().count()) / 1e6, 1e-6);
+  std::println("elapsed:    {:.3f} s", seconds);
+  std::println("requests:   {} answered, {} unanswered, {:.1f}/s", replay.Samples().size(), replay.Unanswered(),
+               static_cast<double>(replay.Samples().size()) / seconds);
+  std::println("messages:   {} in ({} KiB), {} out ({} KiB)", counters.messages_in, counters.bytes_in / 1024,
+               counters.messages_out, counters.bytes_out / 1024);
+  std::println("peak RSS:   {} MiB ({} MiB before the session)", PeakRssKiB() / 1024, rss_before_kib / 1024);
+}
+
+int main(int argc, char* argv[]) {
+  argparse::ArgumentParser ap("vanadium_lsp_replay");
+  ap.add_description("Replays a recorded language server session and reports the latencies of the requests");
+  //
+  std::string trace_path;
+  ap.add_argument("trace").store_into(trace_path).help("session recorded with vanadiumd --record");
+  double speed{1.0};
+  ap.add_argument("--speed")
+      .store_into(speed)
+      .help("relative to the recorded pace, 0 to send the messages back to back");
+  std::uint32_t jobs{std::clamp(std::thread::hardware_concurrency(), 1U, 4U)};
+  ap.add_argument("-j", "--jobs").store_into(jobs).help("maximum number of worker threads");
+  std::uint32_t concurrency{std::clamp(std::thread::hardware_concurrency(), 1U, 4U)};
+  ap.add_argument("--concurrency").store_into(concurrency).help("number of concurrently served LS requests");
+  ap.add_argument("--full-analysis").flag();
+
+  //
+  PARSE_CLI_ARGS_OR_EXIT(ap, argc, argv, 1);
+  //
+
+  std::ifstream in(trace_path, std::ios::binary);
+  if (!in) {
+    std::println(stderr, "failed to open {}", trace_path);
+    return 1;
+  }
+  const auto trace = lserver::ReadSessionTrace(in);
+  if (!trace) {
+    std::println(stderr, "{}: {}", trace_path, trace.error());
+    return 1;
+  }
+
+  if (ap.get<bool>("--full-analysis")) {
+    ls::testflags::do_not_skip_full_analysis = true;
+  }
+
+  const auto rss_before_kib = PeakRssKiB();
+
+  lserver::ReplayTransport replay(*trace, {.speed = speed});
+  ls::Serve(replay, concurrency, jobs);
+
+  PrintReport(replay, rss_before_kib);
+  return 0;
+}
+}  // namespace
+
+DEFINE_VANADIUM_ENTRYPOINT(main);
@@ -133,7 +133,7 @@ Snapshot TakeSnapshot(const vanadium::core::Program& program) {
         write_err(psf, err.range, magic_enum::enum_name(err.type));
       }
       for (const auto& err : psf->type_errors) {
-        write_err(psf, err.range, err.message);
+        write_err(psf, err.range, std::format("{}", err));
       }
     });
     w.WriteLine("");